@@ -1,6 +1,7 @@
 // Copyright 2024 3DGS Research Team. All Rights Reserved.
 
 #include "DEM/DepthExtractor.h"
+#include "DEM/ExrWriter.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "ImageUtils.h"
 #include "Misc/FileHelper.h"
@@ -196,11 +197,32 @@ namespace UE5_3DGS
 		case EDepthFormat::RawFloat32:
 			return SaveDepthAsRawFloat(Result, FilePath);
 
+		case EDepthFormat::EXR16:
+			return SaveDepthAsEXR(Result, FilePath, true);
+
 		default:
 			return SaveDepthAsEXR(Result, FilePath);
 		}
 	}
 
+	const TCHAR* FDepthExtractor::GetFileExtension(EDepthFormat Format)
+	{
+		switch (Format)
+		{
+		case EDepthFormat::PNG16:
+			return TEXT(".png");
+
+		case EDepthFormat::NPY:
+			return TEXT(".npy");
+
+		case EDepthFormat::RawFloat32:
+			return TEXT(".raw");
+
+		default:
+			return TEXT(".exr");
+		}
+	}
+
 	bool FDepthExtractor::SaveDepthAsPNG16(
 		const FDepthExtractionResult& Result,
 		const FString& FilePath)
@@ -242,39 +264,19 @@ namespace UE5_3DGS
 
 	bool FDepthExtractor::SaveDepthAsEXR(
 		const FDepthExtractionResult& Result,
-		const FString& FilePath)
+		const FString& FilePath,
+		bool bHalf)
 	{
-		// Convert to FFloat16Color for EXR
-		TArray<FFloat16Color> Float16Data;
-		Float16Data.SetNum(Result.Width * Result.Height);
-
-		for (int32 i = 0; i < Result.DepthData.Num(); ++i)
+		if (!Result.IsValid())
 		{
-			// Store depth in R channel
-			Float16Data[i].R = Result.DepthData[i];
-			Float16Data[i].G = 0.0f;
-			Float16Data[i].B = 0.0f;
-			Float16Data[i].A = 1.0f;
+			UE_LOG(LogTemp, Error, TEXT("Invalid depth result, cannot save EXR"));
+			return false;
 		}
 
-		// EXR export requires ImageWriteQueue or custom encoder
-		// For now, save as raw binary with .exr extension note
-		TArray<uint8> RawData;
-		RawData.SetNumUninitialized(Result.DepthData.Num() * sizeof(float));
-		FMemory::Memcpy(RawData.GetData(), Result.DepthData.GetData(), RawData.Num());
-
-		FString ActualPath = FPaths::ChangeExtension(FilePath, TEXT(".depth.raw"));
-		bool bSuccess = FFileHelper::SaveArrayToFile(RawData, *ActualPath);
-
-		// Save metadata alongside
-		FString MetadataPath = FPaths::ChangeExtension(FilePath, TEXT(".depth.json"));
-		FString Metadata = FString::Printf(
-			TEXT("{\"width\":%d,\"height\":%d,\"min_depth\":%.6f,\"max_depth\":%.6f,\"format\":\"float32\",\"units\":\"meters\"}"),
-			Result.Width, Result.Height, Result.MinDepth, Result.MaxDepth
-		);
-		FFileHelper::SaveStringToFile(Metadata, *MetadataPath);
+		FExrWriteConfig ExrConfig;
+		ExrConfig.PixelType = bHalf ? EExrPixelType::Half : EExrPixelType::Float;
 
-		return bSuccess;
+		return FExrWriter::WriteSingleChannel(FilePath, Result.DepthData.GetData(), Result.Width, Result.Height, ExrConfig);
 	}
 
 	bool FDepthExtractor::SaveDepthAsNPY(
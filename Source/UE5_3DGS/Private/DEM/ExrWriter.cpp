@@ -0,0 +1,203 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "DEM/ExrWriter.h"
+#include "HAL/FileManager.h"
+#include "Async/ParallelFor.h"
+#include "Math/Float16.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace UE5_3DGS
+{
+	bool FExrWriter::WriteSingleChannel(
+		const FString& FilePath,
+		const float* Pixels,
+		int32 Width,
+		int32 Height,
+		const FExrWriteConfig& Config)
+	{
+		if (!Pixels || Width <= 0 || Height <= 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Invalid EXR image (%dx%d)"), Width, Height);
+			return false;
+		}
+
+		if (Config.ChannelName.IsEmpty())
+		{
+			UE_LOG(LogTemp, Error, TEXT("EXR channel name must not be empty"));
+			return false;
+		}
+
+		const bool bHalf = Config.PixelType == EExrPixelType::Half;
+		const int64 LineBytes = static_cast<int64>(Width) * (bHalf ? sizeof(uint16) : sizeof(float));
+		const int32 LinesPerBlock = Config.bCompress ? ZipLinesPerBlock : 1;
+		const int32 NumBlocks = FMath::DivideAndRoundUp(Height, LinesPerBlock);
+
+		if (LineBytes * LinesPerBlock > MAX_int32)
+		{
+			UE_LOG(LogTemp, Error, TEXT("EXR image too wide (%d pixels)"), Width);
+			return false;
+		}
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open EXR file for writing: %s"), *FilePath);
+			return false;
+		}
+
+		// Each block is stored as its first line, its byte count and its data
+		TArray<TArray<uint8>> Blocks;
+		Blocks.SetNum(NumBlocks);
+
+		ParallelFor(NumBlocks, [&](int32 BlockIndex)
+		{
+			const int32 FirstLine = BlockIndex * LinesPerBlock;
+			const int32 NumLines = FMath::Min(LinesPerBlock, Height - FirstLine);
+			const int32 RawBytes = static_cast<int32>(LineBytes * NumLines);
+			const int64 NumSamples = static_cast<int64>(Width) * NumLines;
+			const float* Source = Pixels + static_cast<int64>(FirstLine) * Width;
+
+			TArray<uint8> Raw;
+			Raw.SetNumUninitialized(RawBytes);
+			if (bHalf)
+			{
+				uint16* Dest = reinterpret_cast<uint16*>(Raw.GetData());
+				for (int64 i = 0; i < NumSamples; ++i)
+				{
+					Dest[i] = FFloat16(Source[i]).Encoded;
+				}
+			}
+			else
+			{
+				FMemory::Memcpy(Raw.GetData(), Source, RawBytes);
+			}
+
+			TArray<uint8>& Stored = Blocks[BlockIndex];
+			int32 StoredBytes = 0;
+
+			if (Config.bCompress)
+			{
+				TArray<uint8> Predicted;
+				Predicted.SetNumUninitialized(RawBytes);
+				PredictBytes(Raw.GetData(), RawBytes, Predicted.GetData());
+
+				uLongf CompressedBytes = compressBound(static_cast<uLong>(RawBytes));
+				Stored.SetNumUninitialized(2 * sizeof(int32) + CompressedBytes);
+				if (compress2(Stored.GetData() + 2 * sizeof(int32), &CompressedBytes, Predicted.GetData(), static_cast<uLong>(RawBytes), FMath::Clamp(Config.CompressionLevel, 1, 9)) == Z_OK &&
+					static_cast<int64>(CompressedBytes) < RawBytes)
+				{
+					StoredBytes = static_cast<int32>(CompressedBytes);
+				}
+			}
+
+			// Readers treat a block whose size equals the raw size as uncompressed
+			if (StoredBytes == 0)
+			{
+				Stored.SetNumUninitialized(2 * sizeof(int32) + RawBytes);
+				FMemory::Memcpy(Stored.GetData() + 2 * sizeof(int32), Raw.GetData(), RawBytes);
+				StoredBytes = RawBytes;
+			}
+
+			Stored.SetNum(2 * sizeof(int32) + StoredBytes);
+			FMemory::Memcpy(Stored.GetData(), &FirstLine, sizeof(int32));
+			FMemory::Memcpy(Stored.GetData() + sizeof(int32), &StoredBytes, sizeof(int32));
+		});
+
+		TArray<uint8> Header;
+		WriteHeader(Header, Width, Height, Config);
+
+		// Offset table: absolute file position of every block
+		TArray<uint64> Offsets;
+		Offsets.SetNumUninitialized(NumBlocks);
+		uint64 Offset = Header.Num() + static_cast<uint64>(NumBlocks) * sizeof(uint64);
+		for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+		{
+			Offsets[BlockIndex] = Offset;
+			Offset += Blocks[BlockIndex].Num();
+		}
+
+		Writer->Serialize(Header.GetData(), Header.Num());
+		Writer->Serialize(Offsets.GetData(), static_cast<int64>(NumBlocks) * sizeof(uint64));
+		for (TArray<uint8>& Block : Blocks)
+		{
+			Writer->Serialize(Block.GetData(), Block.Num());
+		}
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write EXR file: %s"), *FilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	void FExrWriter::WriteHeader(TArray<uint8>& Out, int32 Width, int32 Height, const FExrWriteConfig& Config)
+	{
+		// Magic number, then version 2 with no flags (single-part scanline)
+		const uint8 Preamble[8] = { 0x76, 0x2f, 0x31, 0x01, 0x02, 0x00, 0x00, 0x00 };
+		Out.Append(Preamble, sizeof(Preamble));
+
+		// chlist: name, pixel type, pLinear and 3 reserved bytes, x and y sampling, then a terminating null
+		FTCHARToUTF8 ChannelName(*Config.ChannelName);
+		TArray<uint8> Channels;
+		Channels.Append(reinterpret_cast<const uint8*>(ChannelName.Get()), ChannelName.Length());
+		Channels.Add(0);
+		const int32 ChannelFields[4] = { static_cast<int32>(Config.PixelType), 0, 1, 1 };
+		Channels.Append(reinterpret_cast<const uint8*>(ChannelFields), sizeof(ChannelFields));
+		Channels.Add(0);
+		WriteAttribute(Out, "channels", "chlist", Channels.GetData(), Channels.Num());
+
+		const uint8 Compression = Config.bCompress ? Compression_Zip : Compression_None;
+		WriteAttribute(Out, "compression", "compression", &Compression, sizeof(Compression));
+
+		const int32 Window[4] = { 0, 0, Width - 1, Height - 1 };
+		WriteAttribute(Out, "dataWindow", "box2i", Window, sizeof(Window));
+		WriteAttribute(Out, "displayWindow", "box2i", Window, sizeof(Window));
+
+		const uint8 LineOrder = 0;
+		WriteAttribute(Out, "lineOrder", "lineOrder", &LineOrder, sizeof(LineOrder));
+
+		const float PixelAspectRatio = 1.0f;
+		WriteAttribute(Out, "pixelAspectRatio", "float", &PixelAspectRatio, sizeof(PixelAspectRatio));
+
+		const float ScreenWindowCenter[2] = { 0.0f, 0.0f };
+		WriteAttribute(Out, "screenWindowCenter", "v2f", ScreenWindowCenter, sizeof(ScreenWindowCenter));
+
+		const float ScreenWindowWidth = 1.0f;
+		WriteAttribute(Out, "screenWindowWidth", "float", &ScreenWindowWidth, sizeof(ScreenWindowWidth));
+
+		// End of header
+		Out.Add(0);
+	}
+
+	void FExrWriter::WriteAttribute(TArray<uint8>& Out, const char* Name, const char* Type, const void* Value, int32 Size)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(Name), FCStringAnsi::Strlen(Name) + 1);
+		Out.Append(reinterpret_cast<const uint8*>(Type), FCStringAnsi::Strlen(Type) + 1);
+		Out.Append(reinterpret_cast<const uint8*>(&Size), sizeof(Size));
+		Out.Append(static_cast<const uint8*>(Value), Size);
+	}
+
+	void FExrWriter::PredictBytes(const uint8* Source, int32 NumBytes, uint8* Dest)
+	{
+		// Even bytes fill the first half, odd bytes the second
+		const int32 HalfBytes = (NumBytes + 1) / 2;
+		for (int32 i = 0; i < NumBytes; ++i)
+		{
+			Dest[(i & 1) ? HalfBytes + (i >> 1) : (i >> 1)] = Source[i];
+		}
+
+		// Each byte becomes its difference from the previous one, biased by 128
+		uint8 Previous = Dest[0];
+		for (int32 i = 1; i < NumBytes; ++i)
+		{
+			const uint8 Current = Dest[i];
+			Dest[i] = static_cast<uint8>(Current - Previous + 128);
+			Previous = Current;
+		}
+	}
+}
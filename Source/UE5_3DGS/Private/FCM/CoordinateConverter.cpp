@@ -1,6 +1,8 @@
 // Copyright 2024 3DGS Research Team. All Rights Reserved.
 
 #include "FCM/CoordinateConverter.h"
+#include "FCM/GaussianSplatBuffer.h"
+#include "Async/ParallelFor.h"
 
 namespace UE5_3DGS
 {
@@ -146,6 +148,225 @@ namespace UE5_3DGS
 		return RotTranspose.TransformVector(NegTranslation);
 	}
 
+	// FSplatTransform implementation
+
+	FSplatTransform FSplatTransform::FromTransform(const FTransform& Transform)
+	{
+		const FVector3d Scale3D = Transform.GetScale3D();
+		const double Magnitude = FMath::Abs(Scale3D.X);
+		if (!FMath::IsNearlyEqual(FMath::Abs(Scale3D.Y), Magnitude, 1e-6 * Magnitude) ||
+			!FMath::IsNearlyEqual(FMath::Abs(Scale3D.Z), Magnitude, 1e-6 * Magnitude))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Splat transforms need a uniform scale, using %f of %s"), Magnitude, *Scale3D.ToString());
+		}
+
+		// Negative scale components mirror their axis before the rotation
+		const FQuat4d Rotation = Transform.GetRotation().GetNormalized();
+
+		FSplatTransform Result;
+		Result.AxisX = Rotation.RotateVector(FVector3d(Scale3D.X < 0.0 ? -1.0 : 1.0, 0.0, 0.0));
+		Result.AxisY = Rotation.RotateVector(FVector3d(0.0, Scale3D.Y < 0.0 ? -1.0 : 1.0, 0.0));
+		Result.AxisZ = Rotation.RotateVector(FVector3d(0.0, 0.0, Scale3D.Z < 0.0 ? -1.0 : 1.0));
+		Result.Scale = Magnitude;
+		Result.Translation = Transform.GetTranslation();
+		return Result;
+	}
+
+	FSplatTransform FSplatTransform::ColmapToUE5()
+	{
+		// Same mapping as FCoordinateConverter::ConvertPositionFromColmap
+		FSplatTransform Result;
+		Result.AxisX = FVector3d(0.0, 1.0, 0.0);   // COLMAP X (right) -> UE5 Y
+		Result.AxisY = FVector3d(0.0, 0.0, -1.0);  // COLMAP Y (down) -> UE5 -Z
+		Result.AxisZ = FVector3d(1.0, 0.0, 0.0);   // COLMAP Z (forward) -> UE5 X
+		Result.Scale = FCoordinateConverter::MetersToCm;
+		return Result;
+	}
+
+	FSplatTransform FSplatTransform::UE5ToColmap()
+	{
+		return ColmapToUE5().Inverse();
+	}
+
+	FSplatTransform FSplatTransform::Compose(const FSplatTransform& First, const FSplatTransform& Second)
+	{
+		FSplatTransform Result;
+		Result.AxisX = Second.TransformVector(First.AxisX);
+		Result.AxisY = Second.TransformVector(First.AxisY);
+		Result.AxisZ = Second.TransformVector(First.AxisZ);
+		Result.Scale = First.Scale * Second.Scale;
+		Result.Translation = Second.TransformPosition(First.Translation);
+		return Result;
+	}
+
+	FSplatTransform FSplatTransform::Inverse() const
+	{
+		// Q is orthogonal, so its inverse is the transpose
+		FSplatTransform Result;
+		Result.AxisX = FVector3d(AxisX.X, AxisY.X, AxisZ.X);
+		Result.AxisY = FVector3d(AxisX.Y, AxisY.Y, AxisZ.Y);
+		Result.AxisZ = FVector3d(AxisX.Z, AxisY.Z, AxisZ.Z);
+		Result.Scale = 1.0 / Scale;
+		Result.Translation = -Result.Scale * Result.TransformVector(Translation);
+		return Result;
+	}
+
+	// FSHRotation implementation
+
+	FSHRotation::FSHRotation(const FSplatTransform& Transform)
+	{
+		// Fibonacci sphere directions: well spread, so the fit below is well conditioned
+		FVector3d Directions[NumFitDirections];
+		const double GoldenAngle = PI * (3.0 - FMath::Sqrt(5.0));
+		for (int32 s = 0; s < NumFitDirections; ++s)
+		{
+			const double Z = 1.0 - (s + 0.5) * 2.0 / NumFitDirections;
+			const double Radius = FMath::Sqrt(1.0 - Z * Z);
+			Directions[s] = FVector3d(Radius * FMath::Cos(GoldenAngle * s), Radius * FMath::Sin(GoldenAngle * s), Z);
+		}
+
+		double Basis[NumFitDirections][NumCoeffs];
+		double RotatedBasis[NumFitDirections][NumCoeffs];
+		for (int32 s = 0; s < NumFitDirections; ++s)
+		{
+			// Q^T d: dot products with the axis images
+			const FVector3d& D = Directions[s];
+			EvaluateBasis(D, Basis[s]);
+			EvaluateBasis(FVector3d(FVector3d::DotProduct(Transform.AxisX, D), FVector3d::DotProduct(Transform.AxisY, D), FVector3d::DotProduct(Transform.AxisZ, D)), RotatedBasis[s]);
+		}
+
+		float* Bands[3] = { Band1, Band2, Band3 };
+
+		for (int32 Degree = 1; Degree <= 3; ++Degree)
+		{
+			const int32 Size = 2 * Degree + 1;
+			const int32 First = Degree * Degree - 1;
+
+			// Y_old(Q^T d) = M Y(d) at every direction; least squares M = H G^-1 with
+			// G = sum Y(d) Y(d)^T and H = sum Y(Q^T d) Y(d)^T. New coefficients are M^T c,
+			// and G is symmetric, so M^T solves G X = H^T.
+			double Augmented[7][14] = {};
+			for (int32 s = 0; s < NumFitDirections; ++s)
+			{
+				for (int32 i = 0; i < Size; ++i)
+				{
+					for (int32 j = 0; j < Size; ++j)
+					{
+						Augmented[i][j] += Basis[s][First + i] * Basis[s][First + j];
+						Augmented[i][Size + j] += RotatedBasis[s][First + j] * Basis[s][First + i];
+					}
+				}
+			}
+
+			// Gauss-Jordan elimination with partial pivoting
+			for (int32 Column = 0; Column < Size; ++Column)
+			{
+				int32 Pivot = Column;
+				for (int32 Row = Column + 1; Row < Size; ++Row)
+				{
+					if (FMath::Abs(Augmented[Row][Column]) > FMath::Abs(Augmented[Pivot][Column]))
+					{
+						Pivot = Row;
+					}
+				}
+				for (int32 j = 0; j < 2 * Size; ++j)
+				{
+					Swap(Augmented[Column][j], Augmented[Pivot][j]);
+				}
+
+				const double InvPivot = 1.0 / Augmented[Column][Column];
+				for (int32 j = 0; j < 2 * Size; ++j)
+				{
+					Augmented[Column][j] *= InvPivot;
+				}
+
+				for (int32 Row = 0; Row < Size; ++Row)
+				{
+					if (Row != Column)
+					{
+						const double Factor = Augmented[Row][Column];
+						for (int32 j = 0; j < 2 * Size; ++j)
+						{
+							Augmented[Row][j] -= Factor * Augmented[Column][j];
+						}
+					}
+				}
+			}
+
+			float* Band = Bands[Degree - 1];
+			for (int32 i = 0; i < Size; ++i)
+			{
+				for (int32 j = 0; j < Size; ++j)
+				{
+					Band[i * Size + j] = static_cast<float>(Augmented[i][Size + j]);
+				}
+			}
+		}
+	}
+
+	void FSHRotation::Apply(float* Rest) const
+	{
+		const float* Bands[3] = { Band1, Band2, Band3 };
+
+		for (int32 Channel = 0; Channel < 3; ++Channel)
+		{
+			float* Coeffs = Rest + Channel * NumCoeffs;
+			float Rotated[NumCoeffs];
+
+			for (int32 Degree = 1; Degree <= 3; ++Degree)
+			{
+				const int32 Size = 2 * Degree + 1;
+				const int32 First = Degree * Degree - 1;
+				const float* Band = Bands[Degree - 1];
+
+				for (int32 i = 0; i < Size; ++i)
+				{
+					float Sum = 0.0f;
+					for (int32 j = 0; j < Size; ++j)
+					{
+						Sum += Band[i * Size + j] * Coeffs[First + j];
+					}
+					Rotated[First + i] = Sum;
+				}
+			}
+
+			FMemory::Memcpy(Coeffs, Rotated, sizeof(Rotated));
+		}
+	}
+
+	void FSHRotation::EvaluateBasis(const FVector3d& Direction, double* OutBasis)
+	{
+		// Real SH as evaluated by the 3DGS reference rasterizer, signs included
+		constexpr double C1 = 0.4886025119029199;
+		constexpr double C2[5] = { 1.0925484305920792, -1.0925484305920792, 0.31539156525252005, -1.0925484305920792, 0.5462742152960396 };
+		constexpr double C3[7] = { -0.5900435899266435, 2.890611442640554, -0.4570457994644658, 0.3731763325901154, -0.4570457994644658, 1.445305721320277, -0.5900435899266435 };
+
+		const double X = Direction.X;
+		const double Y = Direction.Y;
+		const double Z = Direction.Z;
+		const double XX = X * X;
+		const double YY = Y * Y;
+		const double ZZ = Z * Z;
+
+		OutBasis[0] = -C1 * Y;
+		OutBasis[1] = C1 * Z;
+		OutBasis[2] = -C1 * X;
+
+		OutBasis[3] = C2[0] * X * Y;
+		OutBasis[4] = C2[1] * Y * Z;
+		OutBasis[5] = C2[2] * (2.0 * ZZ - XX - YY);
+		OutBasis[6] = C2[3] * X * Z;
+		OutBasis[7] = C2[4] * (XX - YY);
+
+		OutBasis[8] = C3[0] * Y * (3.0 * XX - YY);
+		OutBasis[9] = C3[1] * X * Y * Z;
+		OutBasis[10] = C3[2] * Y * (4.0 * ZZ - XX - YY);
+		OutBasis[11] = C3[3] * Z * (2.0 * ZZ - 3.0 * XX - 3.0 * YY);
+		OutBasis[12] = C3[4] * X * (4.0 * ZZ - XX - YY);
+		OutBasis[13] = C3[5] * Z * (XX - YY);
+		OutBasis[14] = C3[6] * X * (XX - 3.0 * YY);
+	}
+
 	// FGaussianCoordinateConverter implementation
 
 	FVector FGaussianCoordinateConverter::ConvertPositionToPLY(const FVector& UE5Position)
@@ -183,4 +404,55 @@ namespace UE5_3DGS
 			UE5Scale.X * FCoordinateConverter::CmToMeters   // PLY Z scale = UE5 X scale
 		);
 	}
+
+	bool FGaussianCoordinateConverter::TransformSplats(FGaussianSplatBuffer& Splats, const FSplatTransform& Transform)
+	{
+		if (!(Transform.Scale > 0.0) || !FMath::IsFinite(Transform.Scale))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Splat transform scale must be positive (got %f)"), Transform.Scale);
+			return false;
+		}
+
+		// Splat rotations must stay proper: a mirrored Q is applied as the rotation -Q
+		// followed by a half turn about the splat's local Z, which leaves the covariance
+		// unchanged (it only negates two local axes)
+		const bool bMirrored = Transform.IsMirrored();
+		const double Sign = bMirrored ? -1.0 : 1.0;
+		const FQuat4d Rotation = FMatrix44d(
+			Sign * Transform.AxisX,
+			Sign * Transform.AxisY,
+			Sign * Transform.AxisZ,
+			FVector3d::ZeroVector).ToQuat().GetNormalized();
+		const FQuat4d LocalFlip(0.0, 0.0, 1.0, 0.0);
+
+		const float LogScaleOffset = static_cast<float>(FMath::Loge(Transform.Scale));
+		const FSHRotation SHRotation(Transform);
+
+		constexpr int32 SplatsPerBatch = 4096;
+		const int32 NumSplats = Splats.Num();
+
+		ParallelFor(FMath::DivideAndRoundUp(NumSplats, SplatsPerBatch), [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * SplatsPerBatch;
+			const int32 Last = FMath::Min(First + SplatsPerBatch, NumSplats);
+
+			for (int32 i = First; i < Last; ++i)
+			{
+				Splats.Positions[i] = FVector3f(Transform.TransformPosition(FVector3d(Splats.Positions[i])));
+				Splats.Normals[i] = FVector3f(Transform.TransformVector(FVector3d(Splats.Normals[i])));
+
+				FQuat4d SplatRotation = Rotation * FQuat4d(Splats.Rotations[i]);
+				if (bMirrored)
+				{
+					SplatRotation = SplatRotation * LocalFlip;
+				}
+				Splats.Rotations[i] = FQuat4f(SplatRotation.GetNormalized());
+
+				Splats.Scales[i] += FVector3f(LogScaleOffset);
+				SHRotation.Apply(Splats.GetSHRest(i));
+			}
+		});
+
+		return true;
+	}
 }
@@ -0,0 +1,416 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/ExternalSort.h"
+#include "FCM/PlyWriter.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Async/ParallelFor.h"
+
+namespace UE5_3DGS
+{
+	bool FExternalSort::SortPlyFile(
+		const FString& InputPath,
+		const FString& OutputPath,
+		const FExternalSortConfig& Config,
+		FExternalSortStats* OutStats)
+	{
+		FExternalSortStats Stats;
+		if (OutStats)
+		{
+			*OutStats = Stats;
+		}
+
+		if (FPaths::IsSamePath(InputPath, OutputPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("External sort cannot write over its input: %s"), *InputPath);
+			return false;
+		}
+
+		if (Config.MemoryBudgetBytes < MinMemoryBudgetBytes)
+		{
+			UE_LOG(LogTemp, Error, TEXT("External sort memory budget must be at least %lld bytes"), MinMemoryBudgetBytes);
+			return false;
+		}
+
+		FPlySchema Schema;
+		if (!FPlyWriter::ReadPlyHeader(InputPath, Schema))
+		{
+			return false;
+		}
+
+		if (Schema.Format != EPlyFormat::BinaryLittleEndian || Schema.Elements.Num() != 1 || !Schema.Elements[0].HasFixedStride())
+		{
+			UE_LOG(LogTemp, Error, TEXT("External sort needs a single fixed-size binary little-endian element: %s"), *InputPath);
+			return false;
+		}
+
+		const FPlyElement& Vertex = Schema.Elements[0];
+		const int32 XIndex = Vertex.FindProperty(TEXT("x"));
+		const int32 YIndex = Vertex.FindProperty(TEXT("y"));
+		const int32 ZIndex = Vertex.FindProperty(TEXT("z"));
+		if (XIndex == INDEX_NONE || YIndex == INDEX_NONE || ZIndex == INDEX_NONE ||
+			Vertex.Properties[XIndex].Type != EPlyPropertyType::Float32 ||
+			Vertex.Properties[YIndex].Offset != Vertex.Properties[XIndex].Offset + 4 ||
+			Vertex.Properties[ZIndex].Offset != Vertex.Properties[XIndex].Offset + 8 ||
+			Vertex.Properties[YIndex].Type != EPlyPropertyType::Float32 ||
+			Vertex.Properties[ZIndex].Type != EPlyPropertyType::Float32)
+		{
+			UE_LOG(LogTemp, Error, TEXT("External sort needs consecutive float x, y, z properties: %s"), *InputPath);
+			return false;
+		}
+
+		const int32 Stride = Vertex.Stride;
+		const int32 PositionOffset = Vertex.Properties[XIndex].Offset;
+		const int64 NumRows = Vertex.Count;
+		Stats.NumRows = NumRows;
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		TUniquePtr<IFileHandle> Input(PlatformFile.OpenRead(*InputPath));
+		if (!Input)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open PLY file: %s"), *InputPath);
+			return false;
+		}
+
+		if (Input->Size() < Schema.DataOffset + NumRows * Stride)
+		{
+			UE_LOG(LogTemp, Error, TEXT("PLY file is truncated: %s"), *InputPath);
+			return false;
+		}
+
+		TArray<uint8> Header;
+		Header.SetNumUninitialized(Schema.DataOffset);
+		if (!Input->Read(Header.GetData(), Header.Num()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to read PLY header: %s"), *InputPath);
+			return false;
+		}
+
+		const FString TempDirectory = Config.TempDirectory.IsEmpty() ? FPaths::GetPath(OutputPath) : Config.TempDirectory;
+		PlatformFile.CreateDirectoryTree(*TempDirectory);
+
+		const int64 Budget = Config.MemoryBudgetBytes;
+		const int32 KeyedStride = Stride + sizeof(uint64);
+
+		// Pass 1: the curve grid spans the whole file
+		FBox3f Bounds(ForceInit);
+		if (Config.Curve != ESpatialCurve::None)
+		{
+			const int32 BoundsBlockRows = static_cast<int32>(FMath::Clamp<int64>(Budget / (Stride + sizeof(FVector3f)), 1, MAX_int32 / Stride));
+			if (!ScanBounds(*Input, Schema.DataOffset, NumRows, Stride, PositionOffset, BoundsBlockRows, Bounds))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to read PLY data: %s"), *InputPath);
+				return false;
+			}
+		}
+
+		// Per row of a run: the record read, the keyed record gathered, its position, key and order, and the radix sort's copies of both
+		constexpr int64 RunOverheadBytes = sizeof(FVector3f) + 2 * (sizeof(uint64) + sizeof(int32));
+		const int32 RunRows = static_cast<int32>(FMath::Clamp<int64>(Budget / (Stride + KeyedStride + RunOverheadBytes), 1, MAX_int32 / KeyedStride));
+		const int32 NumRuns = static_cast<int32>(FMath::Max<int64>(1, (NumRows + RunRows - 1) / RunRows));
+		Stats.NumRuns = NumRuns;
+
+		// Run files that still exist, removed on every exit path
+		TArray<FRunFile> Runs;
+		auto DeleteRuns = [&PlatformFile](const TArray<FRunFile>& RunsToDelete)
+		{
+			for (const FRunFile& Run : RunsToDelete)
+			{
+				PlatformFile.DeleteFile(*Run.Path);
+			}
+		};
+
+		auto OpenOutput = [&]() -> IFileHandle*
+		{
+			IFileHandle* Output = PlatformFile.OpenWrite(*OutputPath);
+			if (!Output || !Output->Write(Header.GetData(), Header.Num()))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to create PLY file: %s"), *OutputPath);
+				delete Output;
+				return nullptr;
+			}
+			return Output;
+		};
+
+		// Pass 2: sort budget-sized runs; a single run goes straight to the output without keys
+		{
+			const bool bSingleRun = (NumRuns == 1);
+			const int32 RunStride = bSingleRun ? Stride : KeyedStride;
+
+			TArray<uint8> Records;
+			TArray<uint8> Sorted;
+			TArray<FVector3f> Positions;
+			TArray<uint64> Keys;
+			TArray<int32> Order;
+
+			if (!Input->Seek(Schema.DataOffset))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to read PLY data: %s"), *InputPath);
+				return false;
+			}
+
+			for (int32 RunIndex = 0; RunIndex < NumRuns; ++RunIndex)
+			{
+				const int32 BlockRows = static_cast<int32>(FMath::Min<int64>(RunRows, NumRows - static_cast<int64>(RunIndex) * RunRows));
+
+				Records.SetNumUninitialized(BlockRows * Stride);
+				if (!Input->Read(Records.GetData(), Records.Num()))
+				{
+					UE_LOG(LogTemp, Error, TEXT("Failed to read PLY data: %s"), *InputPath);
+					DeleteRuns(Runs);
+					return false;
+				}
+
+				ExtractPositions(Records.GetData(), BlockRows, Stride, PositionOffset, Positions);
+				FSpatialSort::ComputeKeys(Positions, Config.Curve, Bounds, Keys);
+				FSpatialSort::RadixSort(Keys, Order);
+
+				Sorted.SetNumUninitialized(BlockRows * RunStride);
+				ParallelFor(FMath::DivideAndRoundUp(BlockRows, FSpatialSort::BatchSize), [&](int32 BatchIndex)
+				{
+					const int32 First = BatchIndex * FSpatialSort::BatchSize;
+					const int32 Last = FMath::Min(First + FSpatialSort::BatchSize, BlockRows);
+					for (int32 i = First; i < Last; ++i)
+					{
+						uint8* Row = Sorted.GetData() + static_cast<int64>(i) * RunStride;
+						if (!bSingleRun)
+						{
+							FMemory::Memcpy(Row, &Keys[i], sizeof(uint64));
+							Row += sizeof(uint64);
+						}
+						FMemory::Memcpy(Row, Records.GetData() + static_cast<int64>(Order[i]) * Stride, Stride);
+					}
+				});
+
+				TUniquePtr<IFileHandle> RunOutput;
+				if (bSingleRun)
+				{
+					RunOutput.Reset(OpenOutput());
+				}
+				else
+				{
+					FRunFile& Run = Runs.AddDefaulted_GetRef();
+					Run.Path = MakeRunPath(TempDirectory);
+					Run.NumRows = BlockRows;
+					RunOutput.Reset(PlatformFile.OpenWrite(*Run.Path));
+				}
+
+				if (!RunOutput || !RunOutput->Write(Sorted.GetData(), Sorted.Num()) || !RunOutput->Flush())
+				{
+					UE_LOG(LogTemp, Error, TEXT("Failed to write sorted run %d"), RunIndex);
+					DeleteRuns(Runs);
+					return false;
+				}
+			}
+		}
+
+		Input.Reset();
+
+		// Pass 3: merge; more runs than read buffers fit in the budget take intermediate passes
+		const int32 FanIn = static_cast<int32>(FMath::Clamp<int64>(Budget / MinMergeBufferBytes - 1, 2, MaxMergeFanIn));
+
+		while (Runs.Num() > FanIn)
+		{
+			TArray<FRunFile> Merged;
+			for (int32 First = 0; First < Runs.Num(); First += FanIn)
+			{
+				TArray<FRunFile> Group(Runs.GetData() + First, FMath::Min(FanIn, Runs.Num() - First));
+
+				FRunFile& Run = Merged.AddDefaulted_GetRef();
+				Run.Path = MakeRunPath(TempDirectory);
+				for (const FRunFile& Source : Group)
+				{
+					Run.NumRows += Source.NumRows;
+				}
+
+				TUniquePtr<IFileHandle> RunOutput(PlatformFile.OpenWrite(*Run.Path));
+				if (!RunOutput || !MergeRuns(Group, Stride, Budget, *RunOutput, true))
+				{
+					UE_LOG(LogTemp, Error, TEXT("Failed to merge sorted runs"));
+					RunOutput.Reset();
+					DeleteRuns(Runs);
+					DeleteRuns(Merged);
+					return false;
+				}
+			}
+
+			DeleteRuns(Runs);
+			Runs = MoveTemp(Merged);
+			Stats.NumMergePasses++;
+		}
+
+		if (Runs.Num() > 0)
+		{
+			TUniquePtr<IFileHandle> Output(OpenOutput());
+			const bool bMerged = Output && MergeRuns(Runs, Stride, Budget, *Output, false) && Output->Flush();
+			Output.Reset();
+			DeleteRuns(Runs);
+
+			if (!bMerged)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to merge sorted runs into: %s"), *OutputPath);
+				return false;
+			}
+			Stats.NumMergePasses++;
+		}
+
+		if (OutStats)
+		{
+			*OutStats = Stats;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Sorted %lld rows out of core: %d runs, %d merge passes -> %s"),
+			Stats.NumRows, Stats.NumRuns, Stats.NumMergePasses, *OutputPath);
+		return true;
+	}
+
+	bool FExternalSort::ScanBounds(IFileHandle& Input, int64 DataOffset, int64 NumRows, int32 Stride, int32 PositionOffset, int32 BlockRows, FBox3f& OutBounds)
+	{
+		OutBounds = FBox3f(ForceInit);
+
+		if (!Input.Seek(DataOffset))
+		{
+			return false;
+		}
+
+		TArray<uint8> Block;
+		TArray<FVector3f> Positions;
+		for (int64 First = 0; First < NumRows; First += BlockRows)
+		{
+			const int32 Rows = static_cast<int32>(FMath::Min<int64>(BlockRows, NumRows - First));
+			Block.SetNumUninitialized(Rows * Stride);
+			if (!Input.Read(Block.GetData(), Block.Num()))
+			{
+				return false;
+			}
+
+			ExtractPositions(Block.GetData(), Rows, Stride, PositionOffset, Positions);
+			OutBounds += FSpatialSort::ComputeBounds(Positions);
+		}
+
+		return true;
+	}
+
+	void FExternalSort::ExtractPositions(const uint8* Rows, int32 NumRows, int32 Stride, int32 PositionOffset, TArray<FVector3f>& OutPositions)
+	{
+		OutPositions.SetNumUninitialized(NumRows);
+		ParallelFor(FMath::DivideAndRoundUp(NumRows, FSpatialSort::BatchSize), [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * FSpatialSort::BatchSize;
+			const int32 Last = FMath::Min(First + FSpatialSort::BatchSize, NumRows);
+			for (int32 i = First; i < Last; ++i)
+			{
+				FMemory::Memcpy(&OutPositions[i], Rows + static_cast<int64>(i) * Stride + PositionOffset, sizeof(FVector3f));
+			}
+		});
+	}
+
+	bool FExternalSort::MergeRuns(const TArray<FRunFile>& Runs, int32 Stride, int64 BudgetBytes, IFileHandle& Output, bool bWriteKeys)
+	{
+		const int32 KeyedStride = Stride + sizeof(uint64);
+		const int32 OutputStride = bWriteKeys ? KeyedStride : Stride;
+		const int32 NumInputs = Runs.Num();
+
+		// The budget is split evenly between one read buffer per run and the write buffer
+		const int32 BufferRows = static_cast<int32>(FMath::Clamp<int64>(BudgetBytes / ((NumInputs + 1) * static_cast<int64>(KeyedStride)), 1, MAX_int32 / KeyedStride));
+
+		struct FCursor
+		{
+			TUniquePtr<IFileHandle> Handle;
+			TArray<uint8> Buffer;
+			int64 RowsInFile = 0;
+			int32 NumBuffered = 0;
+			int32 Position = 0;
+			uint64 Key = 0;
+		};
+
+		TArray<FCursor> Cursors;
+		Cursors.SetNum(NumInputs);
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		bool bReadError = false;
+
+		// Loads the next buffer of a run; false once it is exhausted or on error
+		auto Refill = [&](FCursor& Cursor)
+		{
+			Cursor.NumBuffered = static_cast<int32>(FMath::Min<int64>(BufferRows, Cursor.RowsInFile));
+			Cursor.Position = 0;
+			if (Cursor.NumBuffered == 0)
+			{
+				return false;
+			}
+
+			Cursor.Buffer.SetNumUninitialized(Cursor.NumBuffered * KeyedStride);
+			if (!Cursor.Handle->Read(Cursor.Buffer.GetData(), Cursor.Buffer.Num()))
+			{
+				bReadError = true;
+				return false;
+			}
+			Cursor.RowsInFile -= Cursor.NumBuffered;
+			return true;
+		};
+
+		// Min-heap of run indices by key; equal keys come from the earlier run, keeping the sort stable
+		auto KeyLess = [&Cursors](int32 A, int32 B)
+		{
+			return Cursors[A].Key < Cursors[B].Key || (Cursors[A].Key == Cursors[B].Key && A < B);
+		};
+
+		TArray<int32> Heap;
+		for (int32 RunIndex = 0; RunIndex < NumInputs; ++RunIndex)
+		{
+			FCursor& Cursor = Cursors[RunIndex];
+			Cursor.Handle.Reset(PlatformFile.OpenRead(*Runs[RunIndex].Path));
+			Cursor.RowsInFile = Runs[RunIndex].NumRows;
+			if (!Cursor.Handle)
+			{
+				return false;
+			}
+
+			if (Refill(Cursor))
+			{
+				FMemory::Memcpy(&Cursor.Key, Cursor.Buffer.GetData(), sizeof(uint64));
+				Heap.Add(RunIndex);
+			}
+		}
+		Heap.Heapify(KeyLess);
+
+		TArray<uint8> OutBuffer;
+		OutBuffer.SetNumUninitialized(BufferRows * OutputStride);
+		int32 NumOut = 0;
+
+		while (Heap.Num() > 0 && !bReadError)
+		{
+			int32 RunIndex;
+			Heap.HeapPop(RunIndex, KeyLess);
+			FCursor& Cursor = Cursors[RunIndex];
+
+			const uint8* Row = Cursor.Buffer.GetData() + static_cast<int64>(Cursor.Position) * KeyedStride;
+			FMemory::Memcpy(OutBuffer.GetData() + static_cast<int64>(NumOut) * OutputStride, bWriteKeys ? Row : Row + sizeof(uint64), OutputStride);
+
+			if (++NumOut == BufferRows)
+			{
+				if (!Output.Write(OutBuffer.GetData(), OutBuffer.Num()))
+				{
+					return false;
+				}
+				NumOut = 0;
+			}
+
+			if (++Cursor.Position == Cursor.NumBuffered && !Refill(Cursor))
+			{
+				continue;
+			}
+
+			FMemory::Memcpy(&Cursor.Key, Cursor.Buffer.GetData() + static_cast<int64>(Cursor.Position) * KeyedStride, sizeof(uint64));
+			Heap.HeapPush(RunIndex, KeyLess);
+		}
+
+		return !bReadError && (NumOut == 0 || Output.Write(OutBuffer.GetData(), static_cast<int64>(NumOut) * OutputStride));
+	}
+
+	FString FExternalSort::MakeRunPath(const FString& Directory)
+	{
+		return FPaths::CreateTempFilename(*Directory, TEXT("SplatSortRun"), TEXT(".tmp"));
+	}
+}
@@ -0,0 +1,148 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/GaussianCovariance.h"
+
+namespace UE5_3DGS
+{
+	FGaussianCovariance FGaussianCovariance::FromScaleRotation(const FVector3f& LogScale, const FQuat4f& Rotation)
+	{
+		const FQuat4d Q = FQuat4d(Rotation).GetNormalized();
+		const FVector3d Axes[3] = {
+			Q.RotateVector(FVector3d(1.0, 0.0, 0.0)),
+			Q.RotateVector(FVector3d(0.0, 1.0, 0.0)),
+			Q.RotateVector(FVector3d(0.0, 0.0, 1.0))
+		};
+
+		FGaussianCovariance Result;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Result.AddOuterProduct(Axes[Axis], FMath::Exp(2.0 * LogScale[Axis]));
+		}
+		return Result;
+	}
+
+	void FGaussianCovariance::AddOuterProduct(const FVector3d& V, double Weight)
+	{
+		XX += Weight * V.X * V.X;
+		XY += Weight * V.X * V.Y;
+		XZ += Weight * V.X * V.Z;
+		YY += Weight * V.Y * V.Y;
+		YZ += Weight * V.Y * V.Z;
+		ZZ += Weight * V.Z * V.Z;
+	}
+
+	void FGaussianCovariance::AddScaled(const FGaussianCovariance& Other, double Weight)
+	{
+		XX += Weight * Other.XX;
+		XY += Weight * Other.XY;
+		XZ += Weight * Other.XZ;
+		YY += Weight * Other.YY;
+		YZ += Weight * Other.YZ;
+		ZZ += Weight * Other.ZZ;
+	}
+
+	void FGaussianCovariance::Scale(double Factor)
+	{
+		XX *= Factor;
+		XY *= Factor;
+		XZ *= Factor;
+		YY *= Factor;
+		YZ *= Factor;
+		ZZ *= Factor;
+	}
+
+	double FGaussianCovariance::Determinant() const
+	{
+		return XX * (YY * ZZ - YZ * YZ) - XY * (XY * ZZ - YZ * XZ) + XZ * (XY * YZ - YY * XZ);
+	}
+
+	void FGaussianCovariance::Eigen(FVector3d& OutValues, FVector3d OutVectors[3]) const
+	{
+		double A[3][3] = {
+			{ XX, XY, XZ },
+			{ XY, YY, YZ },
+			{ XZ, YZ, ZZ }
+		};
+		double V[3][3] = {
+			{ 1.0, 0.0, 0.0 },
+			{ 0.0, 1.0, 0.0 },
+			{ 0.0, 0.0, 1.0 }
+		};
+
+		const double Scale = FMath::Abs(XX) + FMath::Abs(YY) + FMath::Abs(ZZ);
+		constexpr int32 MaxSweeps = 32;
+
+		for (int32 Sweep = 0; Sweep < MaxSweeps; ++Sweep)
+		{
+			const double OffDiagonal = A[0][1] * A[0][1] + A[0][2] * A[0][2] + A[1][2] * A[1][2];
+			if (OffDiagonal <= 1e-30 * Scale * Scale)
+			{
+				break;
+			}
+
+			static constexpr int32 Pairs[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+			for (const int32 (&Pair)[2] : Pairs)
+			{
+				const int32 P = Pair[0];
+				const int32 Q = Pair[1];
+				if (A[P][Q] == 0.0)
+				{
+					continue;
+				}
+
+				// Rotation zeroing A[P][Q]: A' = J^T A J
+				const double Theta = (A[Q][Q] - A[P][P]) / (2.0 * A[P][Q]);
+				const double T = (Theta >= 0.0 ? 1.0 : -1.0) / (FMath::Abs(Theta) + FMath::Sqrt(Theta * Theta + 1.0));
+				const double C = 1.0 / FMath::Sqrt(T * T + 1.0);
+				const double S = T * C;
+
+				for (int32 k = 0; k < 3; ++k)
+				{
+					const double AKP = A[k][P];
+					const double AKQ = A[k][Q];
+					A[k][P] = C * AKP - S * AKQ;
+					A[k][Q] = S * AKP + C * AKQ;
+				}
+				for (int32 k = 0; k < 3; ++k)
+				{
+					const double APK = A[P][k];
+					const double AQK = A[Q][k];
+					A[P][k] = C * APK - S * AQK;
+					A[Q][k] = S * APK + C * AQK;
+				}
+				for (int32 k = 0; k < 3; ++k)
+				{
+					const double VKP = V[k][P];
+					const double VKQ = V[k][Q];
+					V[k][P] = C * VKP - S * VKQ;
+					V[k][Q] = S * VKP + C * VKQ;
+				}
+			}
+		}
+
+		OutValues = FVector3d(A[0][0], A[1][1], A[2][2]);
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			OutVectors[Axis] = FVector3d(V[0][Axis], V[1][Axis], V[2][Axis]).GetSafeNormal();
+		}
+
+		// Jacobi rotations keep the basis orthonormal; fix the handedness only
+		OutVectors[2] = OutVectors[0] ^ OutVectors[1];
+	}
+
+	void FGaussianCovariance::ToScaleRotation(FVector3f& OutLogScale, FQuat4f& OutRotation, double MinVariance) const
+	{
+		FVector3d Values;
+		FVector3d Vectors[3];
+		Eigen(Values, Vectors);
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			OutLogScale[Axis] = static_cast<float>(0.5 * FMath::Loge(FMath::Max(Values[Axis], MinVariance)));
+		}
+
+		// Matrix rows are the images of the X/Y/Z axes
+		const FMatrix44d Basis(Vectors[0], Vectors[1], Vectors[2], FVector3d::ZeroVector);
+		OutRotation = FQuat4f(FQuat4d(Basis).GetNormalized());
+	}
+}
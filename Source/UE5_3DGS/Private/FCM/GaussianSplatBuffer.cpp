@@ -0,0 +1,127 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/GaussianSplatBuffer.h"
+#include "FCM/PlyWriter.h"
+#include "Async/ParallelFor.h"
+
+namespace UE5_3DGS
+{
+	void FGaussianSplatBuffer::SetNum(int32 NumSplats)
+	{
+		const int32 OldNum = Num();
+		SetNumUninitialized(NumSplats);
+
+		// Match FGaussianSplat defaults for newly added splats
+		const FGaussianSplat Defaults;
+		for (int32 i = OldNum; i < NumSplats; ++i)
+		{
+			SetSplat(i, Defaults);
+		}
+	}
+
+	void FGaussianSplatBuffer::SetNumUninitialized(int32 NumSplats)
+	{
+		Positions.SetNumUninitialized(NumSplats);
+		Normals.SetNumUninitialized(NumSplats);
+		SH_DC.SetNumUninitialized(NumSplats);
+		SH_Rest.SetNumUninitialized(static_cast<int64>(NumSplats) * NumSHRest);
+		Opacities.SetNumUninitialized(NumSplats);
+		Scales.SetNumUninitialized(NumSplats);
+		Rotations.SetNumUninitialized(NumSplats);
+	}
+
+	void FGaussianSplatBuffer::Reserve(int32 NumSplats)
+	{
+		Positions.Reserve(NumSplats);
+		Normals.Reserve(NumSplats);
+		SH_DC.Reserve(NumSplats);
+		SH_Rest.Reserve(static_cast<int64>(NumSplats) * NumSHRest);
+		Opacities.Reserve(NumSplats);
+		Scales.Reserve(NumSplats);
+		Rotations.Reserve(NumSplats);
+	}
+
+	void FGaussianSplatBuffer::Empty()
+	{
+		Positions.Empty();
+		Normals.Empty();
+		SH_DC.Empty();
+		SH_Rest.Empty();
+		Opacities.Empty();
+		Scales.Empty();
+		Rotations.Empty();
+	}
+
+	int32 FGaussianSplatBuffer::Add(const FGaussianSplat& Splat)
+	{
+		const int32 Index = Num();
+		SetNumUninitialized(Index + 1);
+		SetSplat(Index, Splat);
+		return Index;
+	}
+
+	FGaussianSplat FGaussianSplatBuffer::GetSplat(int32 Index) const
+	{
+		FGaussianSplat Splat;
+		Splat.Position = FVector(Positions[Index]);
+		Splat.Normal = FVector(Normals[Index]);
+		Splat.SH_DC = FVector(SH_DC[Index]);
+		FMemory::Memcpy(Splat.SH_Rest.GetData(), GetSHRest(Index), NumSHRest * sizeof(float));
+		Splat.Opacity = Opacities[Index];
+		Splat.Scale = FVector(Scales[Index]);
+		Splat.Rotation = FQuat(Rotations[Index]);
+		Splat.Color = FGaussianSplat::SH_DCToColor(Splat.SH_DC);
+		return Splat;
+	}
+
+	void FGaussianSplatBuffer::SetSplat(int32 Index, const FGaussianSplat& Splat)
+	{
+		Positions[Index] = FVector3f(Splat.Position);
+		Normals[Index] = FVector3f(Splat.Normal);
+		SH_DC[Index] = FVector3f(Splat.SH_DC);
+
+		float* Rest = GetSHRest(Index);
+		for (int32 i = 0; i < NumSHRest; ++i)
+		{
+			Rest[i] = (i < Splat.SH_Rest.Num()) ? Splat.SH_Rest[i] : 0.0f;
+		}
+
+		Opacities[Index] = Splat.Opacity;
+		Scales[Index] = FVector3f(Splat.Scale);
+		Rotations[Index] = FQuat4f(Splat.Rotation);
+	}
+
+	SIZE_T FGaussianSplatBuffer::GetAllocatedSize() const
+	{
+		return Positions.GetAllocatedSize() +
+			Normals.GetAllocatedSize() +
+			SH_DC.GetAllocatedSize() +
+			SH_Rest.GetAllocatedSize() +
+			Opacities.GetAllocatedSize() +
+			Scales.GetAllocatedSize() +
+			Rotations.GetAllocatedSize();
+	}
+
+	FGaussianSplatBuffer FGaussianSplatBuffer::FromSplats(const TArray<FGaussianSplat>& Splats)
+	{
+		FGaussianSplatBuffer Buffer;
+		Buffer.SetNumUninitialized(Splats.Num());
+
+		ParallelFor(Splats.Num(), [&](int32 i)
+		{
+			Buffer.SetSplat(i, Splats[i]);
+		});
+
+		return Buffer;
+	}
+
+	void FGaussianSplatBuffer::ToSplats(TArray<FGaussianSplat>& OutSplats) const
+	{
+		OutSplats.SetNum(Num());
+
+		ParallelFor(Num(), [&](int32 i)
+		{
+			OutSplats[i] = GetSplat(i);
+		});
+	}
+}
@@ -0,0 +1,461 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/GltfWriter.h"
+#include "FCM/SpzFormat.h"
+#include "HAL/FileManager.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace UE5_3DGS
+{
+	namespace GltfConstants
+	{
+		constexpr uint32 GlbMagic = 0x46546c67;      // "glTF"
+		constexpr uint32 GlbVersion = 2;
+		constexpr uint32 ChunkTypeJson = 0x4e4f534a; // "JSON"
+		constexpr uint32 ChunkTypeBin = 0x004e4942;  // "BIN\0"
+
+		constexpr int32 ComponentByte = 5120;
+		constexpr int32 ComponentUnsignedByte = 5121;
+		constexpr int32 ComponentShort = 5122;
+		constexpr int32 ComponentFloat = 5126;
+
+		constexpr int32 TargetArrayBuffer = 34962;
+		constexpr int32 ModePoints = 0;
+
+		/** Zeroth-order SH basis constant */
+		constexpr float SH_C0 = 0.28209479177387814f;
+	}
+
+	bool FGltfWriter::WriteGlb(const FString& FilePath, const FGaussianSplatBuffer& Splats, const FGltfConfig& Config)
+	{
+		using namespace GltfConstants;
+
+		if (Splats.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Empty splat buffer, nothing to write"));
+			return false;
+		}
+
+		TArray<FAttribute> Attributes;
+		FDequantization Dequantization;
+		BuildAttributes(Splats, Config, Attributes, Dequantization);
+
+		const int32 NumSplats = Splats.Num();
+		int64 BinaryBytes = 0;
+		for (const FAttribute& Attribute : Attributes)
+		{
+			BinaryBytes += static_cast<int64>(Attribute.Stride) * NumSplats;
+		}
+
+		if (BinaryBytes > MAX_uint32 - (1 << 20))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Splat data exceeds the 4 GB GLB limit (%lld bytes)"), BinaryBytes);
+			return false;
+		}
+
+		// JSON chunk (padded with spaces to 4 bytes)
+		FString Json;
+		{
+			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+				TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+			FJsonSerializer::Serialize(BuildDocument(NumSplats, Config, Attributes, Dequantization, BinaryBytes), JsonWriter);
+		}
+
+		FTCHARToUTF8 JsonUTF8(*Json);
+		TArray<uint8> JsonChunk(reinterpret_cast<const uint8*>(JsonUTF8.Get()), JsonUTF8.Length());
+		while (JsonChunk.Num() % 4 != 0)
+		{
+			JsonChunk.Add(' ');
+		}
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open glTF file for writing: %s"), *FilePath);
+			return false;
+		}
+
+		// Every view is a multiple of 4 bytes, so the binary chunk needs no padding
+		uint32 GlbHeader[3] = { GlbMagic, GlbVersion, static_cast<uint32>(12 + 8 + JsonChunk.Num() + 8 + BinaryBytes) };
+		uint32 JsonChunkHeader[2] = { static_cast<uint32>(JsonChunk.Num()), ChunkTypeJson };
+		uint32 BinChunkHeader[2] = { static_cast<uint32>(BinaryBytes), ChunkTypeBin };
+
+		Writer->Serialize(GlbHeader, sizeof(GlbHeader));
+		Writer->Serialize(JsonChunkHeader, sizeof(JsonChunkHeader));
+		Writer->Serialize(JsonChunk.GetData(), JsonChunk.Num());
+		Writer->Serialize(BinChunkHeader, sizeof(BinChunkHeader));
+
+		// Binary chunk: each attribute streamed through one reusable block buffer
+		constexpr int32 SplatsPerBatch = 4096;
+		TArray<uint8> Block;
+
+		for (const FAttribute& Attribute : Attributes)
+		{
+			Block.SetNumUninitialized(static_cast<int64>(FMath::Min(NumSplats, BlockSplats)) * Attribute.Stride);
+
+			for (int32 BlockStart = 0; BlockStart < NumSplats && !Writer->IsError(); BlockStart += BlockSplats)
+			{
+				const int32 BlockCount = FMath::Min(BlockSplats, NumSplats - BlockStart);
+				uint8* BlockData = Block.GetData();
+
+				ParallelFor(FMath::DivideAndRoundUp(BlockCount, SplatsPerBatch), [&](int32 BatchIndex)
+				{
+					const int32 First = BatchIndex * SplatsPerBatch;
+					const int32 Count = FMath::Min(SplatsPerBatch, BlockCount - First);
+					Attribute.Pack(BlockStart + First, Count, BlockData + static_cast<int64>(First) * Attribute.Stride);
+				});
+
+				Writer->Serialize(BlockData, static_cast<int64>(BlockCount) * Attribute.Stride);
+			}
+		}
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write glTF file: %s"), *FilePath);
+			return false;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Wrote %d splats to %s (%d attributes, %lld binary bytes%s)"),
+			NumSplats, *FilePath, Attributes.Num(), BinaryBytes, Config.bQuantize ? TEXT(", quantized") : TEXT(""));
+
+		return true;
+	}
+
+	void FGltfWriter::BuildAttributes(
+		const FGaussianSplatBuffer& Splats,
+		const FGltfConfig& Config,
+		TArray<FAttribute>& OutAttributes,
+		FDequantization& OutDequantization)
+	{
+		using namespace GltfConstants;
+
+		OutAttributes.Reset();
+		OutDequantization = FDequantization();
+
+		auto AddAttribute = [&OutAttributes](const FString& Semantic, int32 ComponentType, int32 ComponentBytes, int32 NumComponents, bool bNormalized) -> FAttribute&
+		{
+			FAttribute& Attribute = OutAttributes.AddDefaulted_GetRef();
+			Attribute.Semantic = Semantic;
+			Attribute.ComponentType = ComponentType;
+			Attribute.ComponentBytes = ComponentBytes;
+			Attribute.NumComponents = NumComponents;
+			Attribute.bNormalized = bNormalized;
+			Attribute.Stride = Align(ComponentBytes * NumComponents, 4);
+			return Attribute;
+		};
+
+		// PLY/COLMAP (right, down, forward) to glTF (right, up, back)
+		auto ToGltf = [](const FVector3f& V) { return FVector3f(V.X, -V.Y, -V.Z); };
+
+		// Bounds of finite positions in the glTF frame
+		FBox3f Bounds(ForceInit);
+		for (const FVector3f& Position : Splats.Positions)
+		{
+			if (FMath::IsFinite(Position.X) && FMath::IsFinite(Position.Y) && FMath::IsFinite(Position.Z))
+			{
+				Bounds += ToGltf(Position);
+			}
+		}
+		if (!Bounds.IsValid)
+		{
+			Bounds = FBox3f(FVector3f::ZeroVector, FVector3f::ZeroVector);
+		}
+
+		// POSITION
+		if (Config.bQuantize)
+		{
+			// Uniform scale keeps rotations and scales valid under the node transform
+			const FVector3f Center = Bounds.GetCenter();
+			const float HalfExtent = Bounds.GetExtent().GetMax();
+			const float Step = (HalfExtent > 0.0f) ? HalfExtent / 32767.0f : 1.0f;
+			OutDequantization.Translation = FVector3d(Center);
+			OutDequantization.Scale = Step;
+
+			FAttribute& Position = AddAttribute(TEXT("POSITION"), ComponentShort, 2, 3, false);
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Position.Min.Add(FMath::Clamp(FMath::RoundToInt((Bounds.Min[Axis] - Center[Axis]) / Step), -32767, 32767));
+				Position.Max.Add(FMath::Clamp(FMath::RoundToInt((Bounds.Max[Axis] - Center[Axis]) / Step), -32767, 32767));
+			}
+
+			Position.Pack = [&Splats, ToGltf, Center, Step](int32 First, int32 Count, uint8* Out)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const FVector3f P = ToGltf(Splats.Positions[First + i]);
+					int16* Element = reinterpret_cast<int16*>(Out + static_cast<int64>(i) * 8);
+					for (int32 Axis = 0; Axis < 3; ++Axis)
+					{
+						const float Cell = (P[Axis] - Center[Axis]) / Step;
+						Element[Axis] = FMath::IsFinite(Cell) ? static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Cell), -32767, 32767)) : 0;
+					}
+					Element[3] = 0;
+				}
+			};
+		}
+		else
+		{
+			FAttribute& Position = AddAttribute(TEXT("POSITION"), ComponentFloat, 4, 3, false);
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Position.Min.Add(Bounds.Min[Axis]);
+				Position.Max.Add(Bounds.Max[Axis]);
+			}
+
+			Position.Pack = [&Splats, ToGltf](int32 First, int32 Count, uint8* Out)
+			{
+				FVector3f* Elements = reinterpret_cast<FVector3f*>(Out);
+				for (int32 i = 0; i < Count; ++i)
+				{
+					Elements[i] = ToGltf(Splats.Positions[First + i]);
+				}
+			};
+		}
+
+		// COLOR_0: display color from DC with opacity in alpha
+		AddAttribute(TEXT("COLOR_0"), ComponentUnsignedByte, 1, 4, true).Pack = [&Splats](int32 First, int32 Count, uint8* Out)
+		{
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const FVector3f& DC = Splats.SH_DC[First + i];
+				uint8* Element = Out + static_cast<int64>(i) * 4;
+				for (int32 Channel = 0; Channel < 3; ++Channel)
+				{
+					Element[Channel] = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt((0.5f + SH_C0 * DC[Channel]) * 255.0f), 0, 255));
+				}
+				Element[3] = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Splats.Opacities[First + i] * 255.0f), 0, 255));
+			}
+		};
+
+		// Rotation (x, y, z, w): the axis flip is a 180 degree turn about X
+		auto ToGltfRotation = [](const FQuat4f& Q)
+		{
+			return FQuat4f(Q.X, -Q.Y, -Q.Z, Q.W).GetNormalized();
+		};
+
+		if (Config.bQuantize)
+		{
+			AddAttribute(TEXT("KHR_gaussian_splatting:ROTATION"), ComponentShort, 2, 4, true).Pack = [&Splats, ToGltfRotation](int32 First, int32 Count, uint8* Out)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const FQuat4f Q = ToGltfRotation(Splats.Rotations[First + i]);
+					int16* Element = reinterpret_cast<int16*>(Out + static_cast<int64>(i) * 8);
+					Element[0] = static_cast<int16>(FMath::RoundToInt(FMath::Clamp(Q.X, -1.0f, 1.0f) * 32767.0f));
+					Element[1] = static_cast<int16>(FMath::RoundToInt(FMath::Clamp(Q.Y, -1.0f, 1.0f) * 32767.0f));
+					Element[2] = static_cast<int16>(FMath::RoundToInt(FMath::Clamp(Q.Z, -1.0f, 1.0f) * 32767.0f));
+					Element[3] = static_cast<int16>(FMath::RoundToInt(FMath::Clamp(Q.W, -1.0f, 1.0f) * 32767.0f));
+				}
+			};
+		}
+		else
+		{
+			AddAttribute(TEXT("KHR_gaussian_splatting:ROTATION"), ComponentFloat, 4, 4, false).Pack = [&Splats, ToGltfRotation](int32 First, int32 Count, uint8* Out)
+			{
+				FQuat4f* Elements = reinterpret_cast<FQuat4f*>(Out);
+				for (int32 i = 0; i < Count; ++i)
+				{
+					Elements[i] = ToGltfRotation(Splats.Rotations[First + i]);
+				}
+			};
+		}
+
+		// Linear scale, in node-local units when positions are quantized
+		const float InvNodeScale = static_cast<float>(1.0 / OutDequantization.Scale);
+		AddAttribute(TEXT("KHR_gaussian_splatting:SCALE"), ComponentFloat, 4, 3, false).Pack = [&Splats, InvNodeScale](int32 First, int32 Count, uint8* Out)
+		{
+			FVector3f* Elements = reinterpret_cast<FVector3f*>(Out);
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const FVector3f& LogScale = Splats.Scales[First + i];
+				Elements[i] = FVector3f(FMath::Exp(LogScale.X), FMath::Exp(LogScale.Y), FMath::Exp(LogScale.Z)) * InvNodeScale;
+			}
+		};
+
+		AddAttribute(TEXT("KHR_gaussian_splatting:OPACITY"), ComponentFloat, 4, 1, false).Pack = [&Splats](int32 First, int32 Count, uint8* Out)
+		{
+			FMemory::Memcpy(Out, Splats.Opacities.GetData() + First, Count * sizeof(float));
+		};
+
+		// SH: one VEC3 accessor per coefficient, channels gathered from the channel-major SH_Rest
+		AddAttribute(TEXT("KHR_gaussian_splatting:SH_DEGREE_0_COEF_0"), ComponentFloat, 4, 3, false).Pack = [&Splats](int32 First, int32 Count, uint8* Out)
+		{
+			FMemory::Memcpy(Out, Splats.SH_DC.GetData() + First, Count * sizeof(FVector3f));
+		};
+
+		const int32 SHDegree = FMath::Clamp(Config.SHDegree, 0, 3);
+		constexpr int32 CoeffsPerChannel = FGaussianSplatBuffer::NumSHRest / 3;
+
+		for (int32 Degree = 1; Degree <= SHDegree; ++Degree)
+		{
+			for (int32 Coeff = 0; Coeff < 2 * Degree + 1; ++Coeff)
+			{
+				const int32 CoeffIndex = Degree * Degree - 1 + Coeff;
+				const float Flip = SpzFormat::GetSHAxisFlip(CoeffIndex);
+
+				AddAttribute(FString::Printf(TEXT("KHR_gaussian_splatting:SH_DEGREE_%d_COEF_%d"), Degree, Coeff), ComponentFloat, 4, 3, false).Pack =
+					[&Splats, CoeffIndex, Flip](int32 First, int32 Count, uint8* Out)
+				{
+					FVector3f* Elements = reinterpret_cast<FVector3f*>(Out);
+					for (int32 i = 0; i < Count; ++i)
+					{
+						const float* Rest = Splats.GetSHRest(First + i);
+						Elements[i] = FVector3f(Rest[CoeffIndex], Rest[CoeffsPerChannel + CoeffIndex], Rest[2 * CoeffsPerChannel + CoeffIndex]) * Flip;
+					}
+				};
+			}
+		}
+	}
+
+	TSharedRef<FJsonObject> FGltfWriter::BuildDocument(
+		int32 NumSplats,
+		const FGltfConfig& Config,
+		const TArray<FAttribute>& Attributes,
+		const FDequantization& Dequantization,
+		int64 BinaryBytes)
+	{
+		using namespace GltfConstants;
+
+		auto MakeNumberArray = [](std::initializer_list<double> Values)
+		{
+			TArray<TSharedPtr<FJsonValue>> Array;
+			for (double Value : Values)
+			{
+				Array.Add(MakeShared<FJsonValueNumber>(Value));
+			}
+			return Array;
+		};
+
+		auto MakeStringArray = [](std::initializer_list<const TCHAR*> Values)
+		{
+			TArray<TSharedPtr<FJsonValue>> Array;
+			for (const TCHAR* Value : Values)
+			{
+				Array.Add(MakeShared<FJsonValueString>(Value));
+			}
+			return Array;
+		};
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+
+		TSharedPtr<FJsonObject> Asset = MakeShared<FJsonObject>();
+		Asset->SetStringField(TEXT("version"), TEXT("2.0"));
+		Asset->SetStringField(TEXT("generator"), TEXT("UE5-3DGS"));
+		Root->SetObjectField(TEXT("asset"), Asset);
+
+		// The splat extension degrades to points; quantized attributes need KHR_mesh_quantization
+		if (Config.bQuantize)
+		{
+			Root->SetArrayField(TEXT("extensionsUsed"), MakeStringArray({ TEXT("KHR_gaussian_splatting"), TEXT("KHR_mesh_quantization") }));
+			Root->SetArrayField(TEXT("extensionsRequired"), MakeStringArray({ TEXT("KHR_mesh_quantization") }));
+		}
+		else
+		{
+			Root->SetArrayField(TEXT("extensionsUsed"), MakeStringArray({ TEXT("KHR_gaussian_splatting") }));
+		}
+
+		// Scene and node
+		TSharedPtr<FJsonObject> Scene = MakeShared<FJsonObject>();
+		Scene->SetArrayField(TEXT("nodes"), MakeNumberArray({ 0 }));
+		Root->SetNumberField(TEXT("scene"), 0);
+		Root->SetArrayField(TEXT("scenes"), { MakeShared<FJsonValueObject>(Scene) });
+
+		TSharedPtr<FJsonObject> Node = MakeShared<FJsonObject>();
+		Node->SetNumberField(TEXT("mesh"), 0);
+		if (Config.bQuantize)
+		{
+			const FVector3d& T = Dequantization.Translation;
+			const double S = Dequantization.Scale;
+			Node->SetArrayField(TEXT("translation"), MakeNumberArray({ T.X, T.Y, T.Z }));
+			Node->SetArrayField(TEXT("scale"), MakeNumberArray({ S, S, S }));
+		}
+		Root->SetArrayField(TEXT("nodes"), { MakeShared<FJsonValueObject>(Node) });
+
+		// Accessors and views, one view per attribute in write order
+		TArray<TSharedPtr<FJsonValue>> Accessors;
+		TArray<TSharedPtr<FJsonValue>> BufferViews;
+		TSharedPtr<FJsonObject> PrimitiveAttributes = MakeShared<FJsonObject>();
+		int64 ByteOffset = 0;
+
+		for (int32 Index = 0; Index < Attributes.Num(); ++Index)
+		{
+			const FAttribute& Attribute = Attributes[Index];
+			const int64 ByteLength = static_cast<int64>(Attribute.Stride) * NumSplats;
+
+			TSharedPtr<FJsonObject> View = MakeShared<FJsonObject>();
+			View->SetNumberField(TEXT("buffer"), 0);
+			View->SetNumberField(TEXT("byteOffset"), static_cast<double>(ByteOffset));
+			View->SetNumberField(TEXT("byteLength"), static_cast<double>(ByteLength));
+			View->SetNumberField(TEXT("byteStride"), Attribute.Stride);
+			View->SetNumberField(TEXT("target"), TargetArrayBuffer);
+			BufferViews.Add(MakeShared<FJsonValueObject>(View));
+
+			TSharedPtr<FJsonObject> Accessor = MakeShared<FJsonObject>();
+			Accessor->SetNumberField(TEXT("bufferView"), Index);
+			Accessor->SetNumberField(TEXT("componentType"), Attribute.ComponentType);
+			Accessor->SetNumberField(TEXT("count"), NumSplats);
+			Accessor->SetStringField(TEXT("type"), GetAccessorType(Attribute.NumComponents));
+			if (Attribute.bNormalized)
+			{
+				Accessor->SetBoolField(TEXT("normalized"), true);
+			}
+			if (Attribute.Min.Num() > 0)
+			{
+				TArray<TSharedPtr<FJsonValue>> Min;
+				TArray<TSharedPtr<FJsonValue>> Max;
+				for (int32 i = 0; i < Attribute.Min.Num(); ++i)
+				{
+					Min.Add(MakeShared<FJsonValueNumber>(Attribute.Min[i]));
+					Max.Add(MakeShared<FJsonValueNumber>(Attribute.Max[i]));
+				}
+				Accessor->SetArrayField(TEXT("min"), Min);
+				Accessor->SetArrayField(TEXT("max"), Max);
+			}
+			Accessors.Add(MakeShared<FJsonValueObject>(Accessor));
+
+			PrimitiveAttributes->SetNumberField(Attribute.Semantic, Index);
+			ByteOffset += ByteLength;
+		}
+
+		Root->SetArrayField(TEXT("accessors"), Accessors);
+		Root->SetArrayField(TEXT("bufferViews"), BufferViews);
+
+		TSharedPtr<FJsonObject> Buffer = MakeShared<FJsonObject>();
+		Buffer->SetNumberField(TEXT("byteLength"), static_cast<double>(BinaryBytes));
+		Root->SetArrayField(TEXT("buffers"), { MakeShared<FJsonValueObject>(Buffer) });
+
+		// Mesh with one splat primitive
+		TSharedPtr<FJsonObject> SplatExtension = MakeShared<FJsonObject>();
+		SplatExtension->SetStringField(TEXT("kernel"), TEXT("ellipse"));
+		SplatExtension->SetStringField(TEXT("colorSpace"), TEXT("srgb_rec709_display"));
+
+		TSharedPtr<FJsonObject> PrimitiveExtensions = MakeShared<FJsonObject>();
+		PrimitiveExtensions->SetObjectField(TEXT("KHR_gaussian_splatting"), SplatExtension);
+
+		TSharedPtr<FJsonObject> Primitive = MakeShared<FJsonObject>();
+		Primitive->SetNumberField(TEXT("mode"), ModePoints);
+		Primitive->SetObjectField(TEXT("attributes"), PrimitiveAttributes);
+		Primitive->SetObjectField(TEXT("extensions"), PrimitiveExtensions);
+
+		TSharedPtr<FJsonObject> Mesh = MakeShared<FJsonObject>();
+		Mesh->SetArrayField(TEXT("primitives"), { MakeShared<FJsonValueObject>(Primitive) });
+		Root->SetArrayField(TEXT("meshes"), { MakeShared<FJsonValueObject>(Mesh) });
+
+		return Root;
+	}
+
+	const TCHAR* FGltfWriter::GetAccessorType(int32 NumComponents)
+	{
+		switch (NumComponents)
+		{
+		case 1: return TEXT("SCALAR");
+		case 2: return TEXT("VEC2");
+		case 3: return TEXT("VEC3");
+		default: return TEXT("VEC4");
+		}
+	}
+}
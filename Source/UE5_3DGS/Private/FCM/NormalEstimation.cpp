@@ -0,0 +1,147 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/NormalEstimation.h"
+#include "FCM/PointKdTree.h"
+#include "FCM/PlyWriter.h"
+#include "FCM/GaussianCovariance.h"
+#include "Async/ParallelFor.h"
+
+#include <atomic>
+
+namespace UE5_3DGS
+{
+	bool FNormalEstimator::EstimateNormals(
+		const TArray<FVector3f>& Positions,
+		const FPointKdTree& Tree,
+		const FNormalEstimationConfig& Config,
+		TArray<FVector3f>& InOutNormals,
+		int32* OutNumEstimated)
+	{
+		if (OutNumEstimated)
+		{
+			*OutNumEstimated = 0;
+		}
+
+		const int32 NumPoints = Positions.Num();
+		if (InOutNormals.Num() != NumPoints)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Normal estimation needs one normal per position (%d normals, %d positions)"), InOutNormals.Num(), NumPoints);
+			return false;
+		}
+
+		// Plane fits need at least two neighbours besides the point
+		if (Config.NumNeighbors < 2 || Config.NumNeighbors > FPointKdTree::MaxNeighbors)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Normal estimation needs 2 to %d neighbours, got %d"), FPointKdTree::MaxNeighbors, Config.NumNeighbors);
+			return false;
+		}
+
+		FPointKdTree ViewTree;
+		ViewTree.Build(Config.ViewPositions);
+
+		constexpr int32 PointsPerBatch = 4096;
+		std::atomic<int32> NumEstimated(0);
+
+		ParallelFor(FMath::DivideAndRoundUp(NumPoints, PointsPerBatch), [&](int32 BatchIndex)
+		{
+			int32 Neighbors[FPointKdTree::MaxNeighbors];
+			float DistancesSquared[FPointKdTree::MaxNeighbors];
+			int32 BatchEstimated = 0;
+
+			const int32 First = BatchIndex * PointsPerBatch;
+			const int32 Last = FMath::Min(First + PointsPerBatch, NumPoints);
+			for (int32 i = First; i < Last; ++i)
+			{
+				const FVector3f& Position = Positions[i];
+				const int32 NumFound = Tree.FindNearest(Position, Config.NumNeighbors, Neighbors, DistancesSquared, i);
+				if (NumFound < 2)
+				{
+					continue;
+				}
+
+				FVector3d Mean(Position);
+				for (int32 k = 0; k < NumFound; ++k)
+				{
+					Mean += FVector3d(Positions[Neighbors[k]]);
+				}
+				Mean /= NumFound + 1;
+
+				FGaussianCovariance Scatter;
+				Scatter.AddOuterProduct(FVector3d(Position) - Mean, 1.0);
+				for (int32 k = 0; k < NumFound; ++k)
+				{
+					Scatter.AddOuterProduct(FVector3d(Positions[Neighbors[k]]) - Mean, 1.0);
+				}
+
+				FVector3d Values;
+				FVector3d Vectors[3];
+				Scatter.Eigen(Values, Vectors);
+
+				const int32 MinAxis = (Values.X <= Values.Y && Values.X <= Values.Z) ? 0 : (Values.Y <= Values.Z ? 1 : 2);
+				const int32 MaxAxis = (Values.X > Values.Y && Values.X > Values.Z) ? 0 : (Values.Y > Values.Z ? 1 : 2);
+				const double MidValue = Values.X + Values.Y + Values.Z - Values[MinAxis] - Values[MaxAxis];
+
+				// Coincident or collinear neighbours do not define a plane
+				if (!(MidValue > 1e-6 * Values[MaxAxis]) || !(Values[MaxAxis] > 0.0))
+				{
+					continue;
+				}
+
+				FVector3f Normal(Vectors[MinAxis]);
+
+				int32 View = INDEX_NONE;
+				float ViewDistanceSquared = 0.0f;
+				if (ViewTree.FindNearest(Position, 1, &View, &ViewDistanceSquared) == 1 &&
+					FVector3f::DotProduct(Normal, Config.ViewPositions[View] - Position) < 0.0f)
+				{
+					Normal = -Normal;
+				}
+
+				InOutNormals[i] = Normal;
+				++BatchEstimated;
+			}
+
+			NumEstimated += BatchEstimated;
+		});
+
+		if (OutNumEstimated)
+		{
+			*OutNumEstimated = NumEstimated.load();
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Estimated %d of %d normals from %d neighbours"), NumEstimated.load(), NumPoints, Config.NumNeighbors);
+		return true;
+	}
+
+	bool FNormalEstimator::EstimateNormals(
+		TArray<FPointCloudPoint>& Points,
+		const FNormalEstimationConfig& Config,
+		int32* OutNumEstimated)
+	{
+		const int32 NumPoints = Points.Num();
+
+		TArray<FVector3f> Positions;
+		TArray<FVector3f> Normals;
+		Positions.SetNumUninitialized(NumPoints);
+		Normals.SetNumUninitialized(NumPoints);
+		ParallelFor(NumPoints, [&](int32 i)
+		{
+			Positions[i] = FVector3f(Points[i].Position);
+			Normals[i] = FVector3f(Points[i].Normal);
+		});
+
+		FPointKdTree Tree;
+		Tree.Build(Positions);
+
+		if (!EstimateNormals(Positions, Tree, Config, Normals, OutNumEstimated))
+		{
+			return false;
+		}
+
+		ParallelFor(NumPoints, [&](int32 i)
+		{
+			Points[i].Normal = FVector(Normals[i]);
+		});
+		return true;
+	}
+}
@@ -0,0 +1,292 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/PlyAppendWriter.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/ParallelFor.h"
+
+namespace UE5_3DGS
+{
+	FPlyAppendWriter::FPlyAppendWriter() = default;
+
+	FPlyAppendWriter::~FPlyAppendWriter()
+	{
+		if (IsOpen())
+		{
+			Close();
+		}
+	}
+
+	bool FPlyAppendWriter::Open(const FString& FilePath, EPlyAppendLayout InLayout, int64 CheckpointVertices)
+	{
+		if (IsOpen())
+		{
+			Close();
+		}
+
+		Path = FilePath;
+		Layout = InLayout;
+		BytesPerRow = (Layout == EPlyAppendLayout::PointCloud) ? BytesPerPoint : FPlyWriter::BytesPerGaussianSplat;
+		NumVertices = 0;
+		CheckpointInterval = FMath::Max<int64>(0, CheckpointVertices);
+		NumSinceCheckpoint = 0;
+		bError = false;
+
+		// Same header as the one-shot writers, with the count widened to a fixed-width field
+		FString Header = (Layout == EPlyAppendLayout::PointCloud)
+			? FPlyWriter::GeneratePointCloudHeader(0, true)
+			: FPlyWriter::GenerateGaussianHeader(0, true);
+		Header.ReplaceInline(TEXT("element vertex 0\n"), *FString::Printf(TEXT("element vertex %0*d\n"), CountDigits, 0));
+
+		FTCHARToUTF8 UTF8Header(*Header);
+		CountOffset = FindCountOffset(UTF8Header.Get(), UTF8Header.Length());
+		check(CountOffset != INDEX_NONE);
+
+		FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FilePath));
+		if (!FileHandle)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to create PLY file: %s"), *FilePath);
+			return false;
+		}
+
+		if (!FileHandle->Write(reinterpret_cast<const uint8*>(UTF8Header.Get()), UTF8Header.Length()) || !FileHandle->Flush(true))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write PLY header: %s"), *FilePath);
+			FileHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FPlyAppendWriter::Append(const FPointCloudPoint* Points, int32 NumPoints)
+	{
+		if (Layout != EPlyAppendLayout::PointCloud)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Cannot append points to a gaussian PLY: %s"), *Path);
+			return false;
+		}
+
+		return AppendRows(NumPoints, [Points](int32 RowIndex, uint8* OutRow)
+		{
+			const FPointCloudPoint& Point = Points[RowIndex];
+			const float Values[6] = {
+				static_cast<float>(Point.Position.X), static_cast<float>(Point.Position.Y), static_cast<float>(Point.Position.Z),
+				static_cast<float>(Point.Normal.X), static_cast<float>(Point.Normal.Y), static_cast<float>(Point.Normal.Z)
+			};
+			FMemory::Memcpy(OutRow, Values, sizeof(Values));
+			OutRow[24] = Point.Color.R;
+			OutRow[25] = Point.Color.G;
+			OutRow[26] = Point.Color.B;
+		});
+	}
+
+	bool FPlyAppendWriter::Append(const FGaussianSplatBuffer& Splats)
+	{
+		if (Layout != EPlyAppendLayout::GaussianSplat)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Cannot append splats to a point cloud PLY: %s"), *Path);
+			return false;
+		}
+
+		return AppendRows(Splats.Num(), [&Splats](int32 RowIndex, uint8* OutRow)
+		{
+			float Row[FPlyWriter::NumGaussianProperties];
+			FPlyWriter::GatherGaussianRow(Splats, RowIndex, Row);
+			FMemory::Memcpy(OutRow, Row, sizeof(Row));
+		});
+	}
+
+	bool FPlyAppendWriter::AppendRows(int32 NumRows, TFunctionRef<void(int32 RowIndex, uint8* OutRow)> PackRow)
+	{
+		if (!IsOpen() || bError)
+		{
+			UE_LOG(LogTemp, Error, TEXT("PLY append writer is not open: %s"), *Path);
+			return false;
+		}
+
+		if (NumRows <= 0)
+		{
+			return true;
+		}
+
+		if (NumVertices + NumRows > MaxVertices)
+		{
+			UE_LOG(LogTemp, Error, TEXT("PLY vertex count exceeds %lld: %s"), MaxVertices, *Path);
+			return false;
+		}
+
+		constexpr int32 RowsPerBatch = 4096;
+
+		for (int32 FirstRow = 0; FirstRow < NumRows; FirstRow += RowsPerBlock)
+		{
+			const int32 BlockRows = FMath::Min(RowsPerBlock, NumRows - FirstRow);
+			Block.SetNumUninitialized(BlockRows * BytesPerRow);
+
+			uint8* BlockData = Block.GetData();
+			ParallelFor(FMath::DivideAndRoundUp(BlockRows, RowsPerBatch), [&](int32 BatchIndex)
+			{
+				const int32 First = BatchIndex * RowsPerBatch;
+				const int32 Last = FMath::Min(First + RowsPerBatch, BlockRows);
+				for (int32 i = First; i < Last; ++i)
+				{
+					PackRow(FirstRow + i, BlockData + static_cast<int64>(i) * BytesPerRow);
+				}
+			});
+
+			if (!FileHandle->Write(BlockData, Block.Num()))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to append to PLY file: %s"), *Path);
+				bError = true;
+				return false;
+			}
+
+			NumVertices += BlockRows;
+			NumSinceCheckpoint += BlockRows;
+
+			if (CheckpointInterval > 0 && NumSinceCheckpoint >= CheckpointInterval && !Flush())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool FPlyAppendWriter::Flush()
+	{
+		if (!IsOpen() || bError)
+		{
+			return false;
+		}
+
+		// Rows reach the disk before the count that covers them
+		if (!FileHandle->Flush(true) || !WriteCount(NumVertices) || !FileHandle->Flush(true))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to checkpoint PLY file: %s"), *Path);
+			bError = true;
+			return false;
+		}
+
+		NumSinceCheckpoint = 0;
+		return true;
+	}
+
+	bool FPlyAppendWriter::Close()
+	{
+		if (!IsOpen())
+		{
+			return false;
+		}
+
+		const bool bSuccess = !bError && Flush();
+		FileHandle.Reset();
+		Block.Empty();
+
+		if (bSuccess)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Wrote %lld vertices to PLY: %s"), NumVertices, *Path);
+		}
+		return bSuccess;
+	}
+
+	bool FPlyAppendWriter::WriteCount(int64 Count)
+	{
+		const int64 End = FileHandle->Tell();
+
+		ANSICHAR Digits[CountDigits + 1];
+		FCStringAnsi::Snprintf(Digits, sizeof(Digits), "%0*lld", CountDigits, Count);
+
+		return FileHandle->Seek(CountOffset) &&
+			FileHandle->Write(reinterpret_cast<const uint8*>(Digits), CountDigits) &&
+			FileHandle->Seek(End);
+	}
+
+	bool FPlyAppendWriter::Recover(const FString& FilePath, int64* OutNumVertices)
+	{
+		FPlySchema Schema;
+		if (!FPlyWriter::ReadPlyHeader(FilePath, Schema))
+		{
+			return false;
+		}
+
+		if (!Schema.IsBinary() || Schema.Elements.Num() != 1 || Schema.Elements[0].Name != TEXT("vertex") ||
+			!Schema.Elements[0].HasFixedStride() || Schema.Elements[0].Stride <= 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Not an append-mode PLY file: %s"), *FilePath);
+			return false;
+		}
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+		int64 FileSize = 0;
+		int64 HeaderCountOffset = INDEX_NONE;
+		{
+			TUniquePtr<IFileHandle> Reader(PlatformFile.OpenRead(*FilePath));
+			TArray<uint8> Header;
+			Header.SetNumUninitialized(Schema.DataOffset);
+			if (!Reader || !Reader->Read(Header.GetData(), Header.Num()))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to read PLY header: %s"), *FilePath);
+				return false;
+			}
+
+			FileSize = Reader->Size();
+			HeaderCountOffset = FindCountOffset(reinterpret_cast<const ANSICHAR*>(Header.GetData()), Header.Num());
+		}
+
+		if (HeaderCountOffset == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Error, TEXT("PLY vertex count is not a fixed-width field: %s"), *FilePath);
+			return false;
+		}
+
+		const int64 Count = FMath::Min((FileSize - Schema.DataOffset) / Schema.Elements[0].Stride, MaxVertices);
+
+		// Append mode keeps the existing contents; the count is overwritten in place
+		TUniquePtr<IFileHandle> Writer(PlatformFile.OpenWrite(*FilePath, true));
+		ANSICHAR Digits[CountDigits + 1];
+		FCStringAnsi::Snprintf(Digits, sizeof(Digits), "%0*lld", CountDigits, Count);
+
+		if (!Writer || !Writer->Seek(HeaderCountOffset) ||
+			!Writer->Write(reinterpret_cast<const uint8*>(Digits), CountDigits) || !Writer->Flush(true))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to patch PLY vertex count: %s"), *FilePath);
+			return false;
+		}
+
+		if (OutNumVertices)
+		{
+			*OutNumVertices = Count;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Recovered %lld vertices in PLY: %s"), Count, *FilePath);
+		return true;
+	}
+
+	int64 FPlyAppendWriter::FindCountOffset(const ANSICHAR* Header, int64 HeaderLength)
+	{
+		static const ANSICHAR Prefix[] = "element vertex ";
+		constexpr int64 PrefixLength = UE_ARRAY_COUNT(Prefix) - 1;
+
+		for (int64 Offset = 0; Offset + PrefixLength + CountDigits < HeaderLength; ++Offset)
+		{
+			if ((Offset > 0 && Header[Offset - 1] != '\n') || FCStringAnsi::Strncmp(Header + Offset, Prefix, PrefixLength) != 0)
+			{
+				continue;
+			}
+
+			const int64 DigitsOffset = Offset + PrefixLength;
+			for (int64 i = 0; i < CountDigits; ++i)
+			{
+				if (!FCharAnsi::IsDigit(Header[DigitsOffset + i]))
+				{
+					return INDEX_NONE;
+				}
+			}
+
+			return Header[DigitsOffset + CountDigits] == '\n' ? DigitsOffset : INDEX_NONE;
+		}
+
+		return INDEX_NONE;
+	}
+}
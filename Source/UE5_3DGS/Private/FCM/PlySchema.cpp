@@ -0,0 +1,511 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/PlySchema.h"
+#include "Async/ParallelFor.h"
+
+#include <limits>
+
+namespace UE5_3DGS
+{
+	int32 FPlyElement::FindProperty(const FString& PropertyName) const
+	{
+		return Properties.IndexOfByPredicate([&PropertyName](const FPlyProperty& Property)
+		{
+			return Property.Name == PropertyName;
+		});
+	}
+
+	int32 FPlySchema::FindElement(const FString& ElementName) const
+	{
+		return Elements.IndexOfByPredicate([&ElementName](const FPlyElement& Element)
+		{
+			return Element.Name == ElementName;
+		});
+	}
+
+	int64 FPlySchema::GetBinaryElementOffset(int32 ElementIndex) const
+	{
+		if (!IsBinary() || !Elements.IsValidIndex(ElementIndex))
+		{
+			return INDEX_NONE;
+		}
+
+		int64 Offset = DataOffset;
+		for (int32 i = 0; i < ElementIndex; ++i)
+		{
+			if (!Elements[i].HasFixedStride())
+			{
+				return INDEX_NONE;
+			}
+			Offset += Elements[i].Count * Elements[i].Stride;
+		}
+
+		return Offset;
+	}
+
+	int32 FPlySchema::FindAsciiRows(const uint8* Data, int64 Size, int64 FirstRow, int32 NumRows, TArray<int64>& OutRowStarts) const
+	{
+		OutRowStarts.SetNumUninitialized(NumRows);
+
+		const int64 DataSize = Size - DataOffset;
+		if (NumRows <= 0 || DataSize <= 0)
+		{
+			OutRowStarts.Reset();
+			return 0;
+		}
+
+		const uint8* DataStart = Data + DataOffset;
+		constexpr int64 BytesPerChunk = 4 << 20;
+		const int32 NumChunks = static_cast<int32>(FMath::DivideAndRoundUp(DataSize, BytesPerChunk));
+
+		// Pass 1: count newlines per chunk
+		TArray<int64> LinesBeforeChunk;
+		LinesBeforeChunk.SetNumZeroed(NumChunks + 1);
+
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			const uint8* Cursor = DataStart + ChunkIndex * BytesPerChunk;
+			const uint8* ChunkEnd = DataStart + FMath::Min((ChunkIndex + 1) * BytesPerChunk, DataSize);
+
+			int64 Count = 0;
+			while ((Cursor = static_cast<const uint8*>(memchr(Cursor, '\n', ChunkEnd - Cursor))) != nullptr)
+			{
+				++Count;
+				++Cursor;
+			}
+			LinesBeforeChunk[ChunkIndex + 1] = Count;
+		});
+
+		for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+		{
+			LinesBeforeChunk[ChunkIndex + 1] += LinesBeforeChunk[ChunkIndex];
+		}
+
+		// A final line without a trailing newline still holds a row
+		const int64 TotalLines = LinesBeforeChunk[NumChunks] + (DataStart[DataSize - 1] != '\n' ? 1 : 0);
+		const int32 NumFound = static_cast<int32>(FMath::Clamp<int64>(TotalLines - FirstRow, 0, NumRows));
+		const int64 LastRow = FirstRow + NumFound;
+
+		if (FirstRow == 0 && NumFound > 0)
+		{
+			OutRowStarts[0] = DataOffset;
+		}
+
+		// Pass 2: line N starts after the N-th newline; record the starts of wanted lines
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			int64 Line = LinesBeforeChunk[ChunkIndex] + 1;
+			if (Line + (LinesBeforeChunk[ChunkIndex + 1] - LinesBeforeChunk[ChunkIndex]) <= FirstRow || Line >= LastRow)
+			{
+				return;
+			}
+
+			const uint8* Cursor = DataStart + ChunkIndex * BytesPerChunk;
+			const uint8* ChunkEnd = DataStart + FMath::Min((ChunkIndex + 1) * BytesPerChunk, DataSize);
+
+			while (Line < LastRow && (Cursor = static_cast<const uint8*>(memchr(Cursor, '\n', ChunkEnd - Cursor))) != nullptr)
+			{
+				++Cursor;
+				if (Line >= FirstRow)
+				{
+					OutRowStarts[static_cast<int32>(Line - FirstRow)] = Cursor - Data;
+				}
+				++Line;
+			}
+		});
+
+		OutRowStarts.SetNum(NumFound);
+		return NumFound;
+	}
+
+	bool FPlySchema::Parse(const uint8* Data, int64 Size, FPlySchema& OutSchema)
+	{
+		OutSchema = FPlySchema();
+
+		if (Size < 3 || FMemory::Memcmp(Data, "ply", 3) != 0)
+		{
+			return false;
+		}
+
+		bool bHasFormat = false;
+		int64 LineStart = 0;
+
+		while (LineStart < Size)
+		{
+			// Find end of line
+			int64 LineEnd = LineStart;
+			while (LineEnd < Size && Data[LineEnd] != '\n')
+			{
+				++LineEnd;
+			}
+
+			if (LineEnd >= Size)
+			{
+				// Header truncated before end_header
+				return false;
+			}
+
+			// Header lines are ASCII; tolerate CRLF line endings
+			int64 ContentEnd = LineEnd;
+			if (ContentEnd > LineStart && Data[ContentEnd - 1] == '\r')
+			{
+				--ContentEnd;
+			}
+
+			FString Line(static_cast<int32>(ContentEnd - LineStart), reinterpret_cast<const ANSICHAR*>(Data + LineStart));
+			LineStart = LineEnd + 1;
+
+			TArray<FString> Parts;
+			Line.ParseIntoArrayWS(Parts);
+
+			if (Parts.Num() == 0 || Parts[0] == TEXT("ply") || Parts[0] == TEXT("comment") || Parts[0] == TEXT("obj_info"))
+			{
+				continue;
+			}
+
+			if (Parts[0] == TEXT("end_header"))
+			{
+				OutSchema.DataOffset = LineStart;
+				return bHasFormat;
+			}
+
+			if (Parts[0] == TEXT("format") && Parts.Num() >= 2)
+			{
+				if (Parts[1] == TEXT("ascii"))
+				{
+					OutSchema.Format = EPlyFormat::Ascii;
+				}
+				else if (Parts[1] == TEXT("binary_little_endian"))
+				{
+					OutSchema.Format = EPlyFormat::BinaryLittleEndian;
+				}
+				else if (Parts[1] == TEXT("binary_big_endian"))
+				{
+					OutSchema.Format = EPlyFormat::BinaryBigEndian;
+				}
+				else
+				{
+					UE_LOG(LogTemp, Error, TEXT("Unknown PLY format: %s"), *Parts[1]);
+					return false;
+				}
+				bHasFormat = true;
+			}
+			else if (Parts[0] == TEXT("element") && Parts.Num() >= 3)
+			{
+				FPlyElement& Element = OutSchema.Elements.AddDefaulted_GetRef();
+				Element.Name = Parts[1];
+				Element.Count = FCString::Atoi64(*Parts[2]);
+
+				// Counts size buffers downstream; reject them before anything is allocated
+				if (Element.Count < 0 || Element.Count > MAX_int32)
+				{
+					UE_LOG(LogTemp, Error, TEXT("Unsupported PLY element count: %s"), *Line);
+					return false;
+				}
+			}
+			else if (Parts[0] == TEXT("property") && Parts.Num() >= 3)
+			{
+				if (OutSchema.Elements.Num() == 0)
+				{
+					UE_LOG(LogTemp, Error, TEXT("PLY property declared before any element"));
+					return false;
+				}
+
+				FPlyElement& Element = OutSchema.Elements.Last();
+				FPlyProperty Property;
+
+				if (Parts[1] == TEXT("list"))
+				{
+					if (Parts.Num() < 5 ||
+						!ParseTypeName(Parts[2], Property.ListCountType) ||
+						!ParseTypeName(Parts[3], Property.Type))
+					{
+						UE_LOG(LogTemp, Error, TEXT("Malformed PLY list property: %s"), *Line);
+						return false;
+					}
+					Property.bIsList = true;
+					Property.Name = Parts[4];
+				}
+				else
+				{
+					if (!ParseTypeName(Parts[1], Property.Type))
+					{
+						UE_LOG(LogTemp, Error, TEXT("Unknown PLY property type: %s"), *Parts[1]);
+						return false;
+					}
+					Property.Name = Parts[2];
+				}
+
+				// Offsets and stride are only meaningful up to the first list property
+				if (Element.HasFixedStride())
+				{
+					Property.Offset = Property.bIsList ? INDEX_NONE : Element.Stride;
+					Element.Stride = Property.bIsList ? INDEX_NONE : Element.Stride + GetTypeSize(Property.Type);
+				}
+
+				Element.Properties.Add(MoveTemp(Property));
+			}
+		}
+
+		return false;
+	}
+
+	int32 FPlySchema::GetTypeSize(EPlyPropertyType Type)
+	{
+		switch (Type)
+		{
+		case EPlyPropertyType::Int8:
+		case EPlyPropertyType::UInt8:
+			return 1;
+		case EPlyPropertyType::Int16:
+		case EPlyPropertyType::UInt16:
+			return 2;
+		case EPlyPropertyType::Int32:
+		case EPlyPropertyType::UInt32:
+		case EPlyPropertyType::Float32:
+			return 4;
+		case EPlyPropertyType::Float64:
+			return 8;
+		default:
+			return 0;
+		}
+	}
+
+	bool FPlySchema::ParseTypeName(const FString& TypeName, EPlyPropertyType& OutType)
+	{
+		static const TPair<const TCHAR*, EPlyPropertyType> TypeNames[] = {
+			{ TEXT("char"), EPlyPropertyType::Int8 },
+			{ TEXT("int8"), EPlyPropertyType::Int8 },
+			{ TEXT("uchar"), EPlyPropertyType::UInt8 },
+			{ TEXT("uint8"), EPlyPropertyType::UInt8 },
+			{ TEXT("short"), EPlyPropertyType::Int16 },
+			{ TEXT("int16"), EPlyPropertyType::Int16 },
+			{ TEXT("ushort"), EPlyPropertyType::UInt16 },
+			{ TEXT("uint16"), EPlyPropertyType::UInt16 },
+			{ TEXT("int"), EPlyPropertyType::Int32 },
+			{ TEXT("int32"), EPlyPropertyType::Int32 },
+			{ TEXT("uint"), EPlyPropertyType::UInt32 },
+			{ TEXT("uint32"), EPlyPropertyType::UInt32 },
+			{ TEXT("float"), EPlyPropertyType::Float32 },
+			{ TEXT("float32"), EPlyPropertyType::Float32 },
+			{ TEXT("double"), EPlyPropertyType::Float64 },
+			{ TEXT("float64"), EPlyPropertyType::Float64 }
+		};
+
+		for (const TPair<const TCHAR*, EPlyPropertyType>& Entry : TypeNames)
+		{
+			if (TypeName == Entry.Key)
+			{
+				OutType = Entry.Value;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool FPlyDecodePlan::Compile(
+		const FPlySchema& Schema,
+		int32 ElementIndex,
+		TFunctionRef<int32(const FPlyProperty& Property)> ResolveTarget,
+		FPlyDecodePlan& OutPlan)
+	{
+		OutPlan = FPlyDecodePlan();
+
+		if (!Schema.Elements.IsValidIndex(ElementIndex))
+		{
+			return false;
+		}
+
+		const FPlyElement& Element = Schema.Elements[ElementIndex];
+		const EPlyFormat ForeignByteOrder = PLATFORM_LITTLE_ENDIAN ? EPlyFormat::BinaryBigEndian : EPlyFormat::BinaryLittleEndian;
+
+		OutPlan.bAscii = !Schema.IsBinary();
+		OutPlan.bSwapBytes = Schema.Format == ForeignByteOrder;
+		OutPlan.Stride = Element.Stride;
+
+		bool bAfterList = false;
+		for (int32 PropertyIndex = 0; PropertyIndex < Element.Properties.Num(); ++PropertyIndex)
+		{
+			const FPlyProperty& Property = Element.Properties[PropertyIndex];
+			bAfterList |= Property.bIsList;
+
+			if (!bAfterList)
+			{
+				OutPlan.NumColumns = PropertyIndex + 1;
+			}
+
+			const int32 Target = ResolveTarget(Property);
+			if (Target == INDEX_NONE)
+			{
+				continue;
+			}
+
+			// Values behind a list property have no fixed position in the record
+			if (bAfterList)
+			{
+				UE_LOG(LogTemp, Error, TEXT("PLY property %s follows a list property and cannot be decoded"), *Property.Name);
+				return false;
+			}
+
+			FPlyDecodeOp& Op = OutPlan.Ops.AddDefaulted_GetRef();
+			Op.Offset = OutPlan.bAscii ? PropertyIndex : Property.Offset;
+			Op.Target = Target;
+			Op.Type = Property.Type;
+		}
+
+		return true;
+	}
+
+	bool FPlyDecodePlan::HasTarget(int32 Target) const
+	{
+		return Ops.ContainsByPredicate([Target](const FPlyDecodeOp& Op)
+		{
+			return Op.Target == Target;
+		});
+	}
+
+	void FPlyDecodePlan::DecodeAscii(const uint8* Row, const uint8* End, double* OutSlots) const
+	{
+		if (Ops.Num() == 0)
+		{
+			return;
+		}
+
+		// Ops are in column order, so the row is walked once
+		const int32 LastColumn = Ops.Last().Offset;
+		const uint8* Cursor = Row;
+		int32 OpIndex = 0;
+
+		for (int32 Column = 0; Column <= LastColumn; ++Column)
+		{
+			while (Cursor < End && (*Cursor == ' ' || *Cursor == '\t' || *Cursor == '\r'))
+			{
+				++Cursor;
+			}
+
+			if (Cursor >= End || *Cursor == '\n')
+			{
+				return;
+			}
+
+			const uint8* TokenEnd = nullptr;
+			if (Ops[OpIndex].Offset == Column)
+			{
+				double Value;
+				TokenEnd = ParseAsciiNumber(Cursor, End, Value);
+				if (TokenEnd)
+				{
+					OutSlots[Ops[OpIndex].Target] = Value;
+				}
+				++OpIndex;
+			}
+
+			// Skip unmapped or malformed tokens
+			Cursor = TokenEnd ? TokenEnd : Cursor;
+			while (Cursor < End && *Cursor > ' ')
+			{
+				++Cursor;
+			}
+		}
+	}
+
+	const uint8* FPlyDecodePlan::ParseAsciiNumber(const uint8* Cursor, const uint8* End, double& OutValue)
+	{
+		static constexpr double PowersOf10[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		auto IsDigit = [](uint8 Char) { return Char >= '0' && Char <= '9'; };
+
+		bool bNegative = false;
+		if (Cursor < End && (*Cursor == '-' || *Cursor == '+'))
+		{
+			bNegative = *Cursor == '-';
+			++Cursor;
+		}
+
+		if (Cursor < End && (*Cursor | 0x20) == 'n')
+		{
+			OutValue = std::numeric_limits<double>::quiet_NaN();
+			return End - Cursor >= 3 && (Cursor[1] | 0x20) == 'a' && (Cursor[2] | 0x20) == 'n' ? Cursor + 3 : nullptr;
+		}
+		if (Cursor < End && (*Cursor | 0x20) == 'i')
+		{
+			OutValue = bNegative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+			return End - Cursor >= 3 && (Cursor[1] | 0x20) == 'n' && (Cursor[2] | 0x20) == 'f' ? Cursor + 3 : nullptr;
+		}
+
+		// Accumulate up to 19 significant digits exactly; further digits only shift the exponent
+		uint64 Mantissa = 0;
+		int32 NumDigits = 0;
+		int32 Exponent = 0;
+		bool bAnyDigits = false;
+
+		for (; Cursor < End && IsDigit(*Cursor); ++Cursor)
+		{
+			bAnyDigits = true;
+			if (NumDigits < 19)
+			{
+				Mantissa = Mantissa * 10 + (*Cursor - '0');
+				NumDigits += Mantissa != 0;
+			}
+			else
+			{
+				++Exponent;
+			}
+		}
+
+		if (Cursor < End && *Cursor == '.')
+		{
+			for (++Cursor; Cursor < End && IsDigit(*Cursor); ++Cursor)
+			{
+				bAnyDigits = true;
+				if (NumDigits < 19)
+				{
+					Mantissa = Mantissa * 10 + (*Cursor - '0');
+					NumDigits += Mantissa != 0;
+					--Exponent;
+				}
+			}
+		}
+
+		if (!bAnyDigits)
+		{
+			return nullptr;
+		}
+
+		if (Cursor < End && (*Cursor | 0x20) == 'e')
+		{
+			const uint8* ExponentStart = Cursor + 1;
+			bool bNegativeExponent = false;
+			if (ExponentStart < End && (*ExponentStart == '-' || *ExponentStart == '+'))
+			{
+				bNegativeExponent = *ExponentStart == '-';
+				++ExponentStart;
+			}
+
+			if (ExponentStart < End && IsDigit(*ExponentStart))
+			{
+				int32 ExplicitExponent = 0;
+				for (Cursor = ExponentStart; Cursor < End && IsDigit(*Cursor); ++Cursor)
+				{
+					ExplicitExponent = FMath::Min(ExplicitExponent * 10 + (*Cursor - '0'), 100000);
+				}
+				Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+			}
+		}
+
+		double Value = static_cast<double>(Mantissa);
+		if (Mantissa != 0 && Exponent != 0)
+		{
+			const int32 AbsExponent = FMath::Abs(Exponent);
+			const double Scale = AbsExponent < UE_ARRAY_COUNT(PowersOf10) ? PowersOf10[AbsExponent] : FMath::Pow(10.0, static_cast<double>(AbsExponent));
+			Value = Exponent < 0 ? Value / Scale : Value * Scale;
+		}
+
+		OutValue = bNegative ? -Value : Value;
+		return Cursor;
+	}
+}
@@ -2,8 +2,18 @@
 
 #include "FCM/PlyWriter.h"
 #include "FCM/CoordinateConverter.h"
+#include "FCM/PointKdTree.h"
+#include "FCM/SHCodebook.h"
+#include "FCM/SHDegreeReduction.h"
 #include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+#include <atomic>
+#include <charconv>
 
 namespace UE5_3DGS
 {
@@ -73,7 +83,239 @@ namespace UE5_3DGS
 			return false;
 		}
 
-		return bBinary ? WriteGaussianBinary(FilePath, Splats) : WriteGaussianASCII(FilePath, Splats);
+		auto GatherRow = [&Splats](int32 SplatIndex, float* OutRow)
+		{
+			GatherGaussianRow(Splats[SplatIndex], OutRow);
+		};
+
+		return bBinary ?
+			WriteGaussianBinary(FilePath, Splats.Num(), GatherRow) :
+			WriteGaussianASCII(FilePath, Splats.Num(), GatherRow);
+	}
+
+	bool FPlyWriter::WriteGaussianSplats(
+		const FString& FilePath,
+		const FGaussianSplatBuffer& Splats,
+		bool bBinary)
+	{
+		if (Splats.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Empty splat buffer, nothing to write"));
+			return false;
+		}
+
+		auto GatherRow = [&Splats](int32 SplatIndex, float* OutRow)
+		{
+			GatherGaussianRow(Splats, SplatIndex, OutRow);
+		};
+
+		return bBinary ?
+			WriteGaussianBinary(FilePath, Splats.Num(), GatherRow) :
+			WriteGaussianASCII(FilePath, Splats.Num(), GatherRow);
+	}
+
+	bool FPlyWriter::WriteGaussianSplats(
+		const FString& FilePath,
+		const FGaussianSplatBuffer& Splats,
+		const FPlyExportOptions& Options,
+		TArray<int32>* OutPermutation)
+	{
+		if (Splats.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Empty splat buffer, nothing to write"));
+			return false;
+		}
+
+		TArray<int32> Order;
+		FSpatialSort::ComputeOrder(Splats.Positions, Options.SpatialOrder, Order);
+
+		auto GatherRow = [&Splats, &Order](int32 RowIndex, float* OutRow)
+		{
+			GatherGaussianRow(Splats, Order[RowIndex], OutRow);
+		};
+
+		const bool bSuccess = Options.bBinary ?
+			WriteGaussianBinary(FilePath, Splats.Num(), GatherRow) :
+			WriteGaussianASCII(FilePath, Splats.Num(), GatherRow);
+
+		if (bSuccess && OutPermutation)
+		{
+			*OutPermutation = MoveTemp(Order);
+		}
+
+		return bSuccess;
+	}
+
+	bool FPlyWriter::WriteGaussianSplats(
+		const FString& FilePath,
+		const FGaussianSplatBuffer& Splats,
+		const FSHCodebook& Codebook)
+	{
+		if (Splats.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Empty splat buffer, nothing to write"));
+			return false;
+		}
+
+		if (Codebook.Indices.Num() != Splats.Num() || Codebook.NumEntries() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("SH codebook does not match the splat buffer"));
+			return false;
+		}
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open PLY file for writing: %s"), *FilePath);
+			return false;
+		}
+
+		const int32 NumSplats = Splats.Num();
+		FString Header = GenerateGaussianCodebookHeader(NumSplats, Codebook.NumEntries());
+		FTCHARToUTF8 UTF8Header(*Header);
+		Writer->Serialize(const_cast<ANSICHAR*>(UTF8Header.Get()), UTF8Header.Length());
+
+		// Same chunked streaming as WriteGaussianBinary, with f_rest_* replaced by the index
+		constexpr int32 FirstRestSlot = 9;
+		constexpr int32 FirstTailSlot = FirstRestSlot + FGaussianSplatBuffer::NumSHRest;
+		constexpr int32 RowsPerBatch = 1024;
+
+		TArray<uint8> ChunkBuffer;
+		ChunkBuffer.SetNumUninitialized(FMath::Min(NumSplats, BinaryWriteChunkSplats) * BytesPerCodebookSplat);
+
+		for (int32 ChunkStart = 0; ChunkStart < NumSplats && !Writer->IsError(); ChunkStart += BinaryWriteChunkSplats)
+		{
+			const int32 ChunkCount = FMath::Min(BinaryWriteChunkSplats, NumSplats - ChunkStart);
+			uint8* ChunkData = ChunkBuffer.GetData();
+
+			ParallelFor(FMath::DivideAndRoundUp(ChunkCount, RowsPerBatch), [&](int32 BatchIndex)
+			{
+				const int32 First = BatchIndex * RowsPerBatch;
+				const int32 Last = FMath::Min(First + RowsPerBatch, ChunkCount);
+
+				float Row[NumGaussianProperties];
+				for (int32 i = First; i < Last; ++i)
+				{
+					const int32 SplatIndex = ChunkStart + i;
+					GatherGaussianRow(Splats, SplatIndex, Row);
+
+					uint8* Record = ChunkData + static_cast<int64>(i) * BytesPerCodebookSplat;
+					FMemory::Memcpy(Record, Row, FirstRestSlot * sizeof(float));
+					Record += FirstRestSlot * sizeof(float);
+					FMemory::Memcpy(Record, Row + FirstTailSlot, (NumGaussianProperties - FirstTailSlot) * sizeof(float));
+					Record += (NumGaussianProperties - FirstTailSlot) * sizeof(float);
+					FMemory::Memcpy(Record, &Codebook.Indices[SplatIndex], sizeof(uint16));
+				}
+			});
+
+			Writer->Serialize(ChunkData, static_cast<int64>(ChunkCount) * BytesPerCodebookSplat);
+		}
+
+		Writer->Serialize(const_cast<float*>(Codebook.Entries.GetData()), Codebook.Entries.Num() * sizeof(float));
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write PLY file: %s"), *FilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FPlyWriter::WriteGaussianSplats(
+		const FString& FilePath,
+		const FGaussianSplatBuffer& Splats,
+		const FSHDegreeReduction& Reduction,
+		TArray<int32>* OutPermutation)
+	{
+		if (Splats.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Empty splat buffer, nothing to write"));
+			return false;
+		}
+
+		if (Reduction.Degrees.Num() != Splats.Num())
+		{
+			UE_LOG(LogTemp, Error, TEXT("SH degree selection does not match the splat buffer"));
+			return false;
+		}
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open PLY file for writing: %s"), *FilePath);
+			return false;
+		}
+
+		FString Header = GenerateGaussianDegreeHeader(Reduction.NumPerDegree);
+		FTCHARToUTF8 UTF8Header(*Header);
+		Writer->Serialize(const_cast<ANSICHAR*>(UTF8Header.Get()), UTF8Header.Length());
+
+		// Buckets are written in ascending degree; each row keeps its bucket's f_rest prefix per channel
+		TArray<int32> Order;
+		Reduction.GetBucketOrder(Order);
+
+		constexpr int32 FirstRestSlot = 9;
+		constexpr int32 FirstTailSlot = FirstRestSlot + FGaussianSplatBuffer::NumSHRest;
+		constexpr int32 NumTailProperties = NumGaussianProperties - FirstTailSlot;
+		constexpr int32 RestCoeffsPerChannel = FGaussianSplatBuffer::NumSHRest / 3;
+		constexpr int32 RowsPerBatch = 1024;
+
+		TArray<float> ChunkBuffer;
+		ChunkBuffer.SetNumUninitialized(FMath::Min(Splats.Num(), BinaryWriteChunkSplats) * NumGaussianProperties);
+
+		int32 BucketStart = 0;
+		for (int32 Degree = 0; Degree <= FSHDegreeReduction::MaxDegree; ++Degree)
+		{
+			const int32 BucketCount = Reduction.NumPerDegree[Degree];
+			const int32 KeptCoeffs = FSHDegreeReduction::GetCoeffsPerChannel(Degree);
+			const int32 RowFloats = NumGaussianProperties - FGaussianSplatBuffer::NumSHRest + 3 * KeptCoeffs;
+
+			for (int32 ChunkStart = 0; ChunkStart < BucketCount && !Writer->IsError(); ChunkStart += BinaryWriteChunkSplats)
+			{
+				const int32 ChunkCount = FMath::Min(BinaryWriteChunkSplats, BucketCount - ChunkStart);
+				float* ChunkData = ChunkBuffer.GetData();
+
+				ParallelFor(FMath::DivideAndRoundUp(ChunkCount, RowsPerBatch), [&](int32 BatchIndex)
+				{
+					const int32 First = BatchIndex * RowsPerBatch;
+					const int32 Last = FMath::Min(First + RowsPerBatch, ChunkCount);
+
+					float Row[NumGaussianProperties];
+					for (int32 i = First; i < Last; ++i)
+					{
+						GatherGaussianRow(Splats, Order[BucketStart + ChunkStart + i], Row);
+
+						float* Record = ChunkData + static_cast<int64>(i) * RowFloats;
+						FMemory::Memcpy(Record, Row, FirstRestSlot * sizeof(float));
+						Record += FirstRestSlot;
+						for (int32 Channel = 0; Channel < 3; ++Channel)
+						{
+							FMemory::Memcpy(Record, Row + FirstRestSlot + Channel * RestCoeffsPerChannel, KeptCoeffs * sizeof(float));
+							Record += KeptCoeffs;
+						}
+						FMemory::Memcpy(Record, Row + FirstTailSlot, NumTailProperties * sizeof(float));
+					}
+				});
+
+				Writer->Serialize(ChunkData, static_cast<int64>(ChunkCount) * RowFloats * sizeof(float));
+			}
+
+			BucketStart += BucketCount;
+		}
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write PLY file: %s"), *FilePath);
+			return false;
+		}
+
+		if (OutPermutation)
+		{
+			*OutPermutation = MoveTemp(Order);
+		}
+
+		return true;
 	}
 
 	TArray<FPointCloudPoint> FPlyWriter::CreatePointCloudFromMesh(
@@ -112,20 +354,25 @@ namespace UE5_3DGS
 
 	TArray<FGaussianSplat> FPlyWriter::CreateSplatsFromPointCloud(
 		const TArray<FPointCloudPoint>& Points,
-		float InitialScale)
+		float InitialScale,
+		int32 NumScaleNeighbors)
 	{
+		TArray<float> LogScales;
+		EstimateInitialScales(Points, NumScaleNeighbors, InitialScale, LogScales);
+
 		TArray<FGaussianSplat> Splats;
 		Splats.Reserve(Points.Num());
 
-		for (const FPointCloudPoint& Point : Points)
+		for (int32 i = 0; i < Points.Num(); ++i)
 		{
+			const FPointCloudPoint& Point = Points[i];
 			FGaussianSplat Splat;
 			Splat.Position = Point.Position;
 			Splat.Normal = Point.Normal;
 			Splat.Color = Point.Color;
 			Splat.SH_DC = FGaussianSplat::ColorToSH_DC(Point.Color);
 			Splat.Opacity = 1.0f;
-			Splat.Scale = FVector(InitialScale, InitialScale, InitialScale);
+			Splat.Scale = FVector(LogScales[i], LogScales[i], LogScales[i]);
 			Splat.Rotation = FQuat::Identity;
 
 			Splats.Add(Splat);
@@ -134,150 +381,609 @@ namespace UE5_3DGS
 		return Splats;
 	}
 
+	FGaussianSplatBuffer FPlyWriter::CreateSplatBufferFromPointCloud(
+		const TArray<FPointCloudPoint>& Points,
+		float InitialScale,
+		int32 NumScaleNeighbors)
+	{
+		TArray<float> LogScales;
+		EstimateInitialScales(Points, NumScaleNeighbors, InitialScale, LogScales);
+
+		FGaussianSplatBuffer Splats;
+		Splats.SetNumUninitialized(Points.Num());
+
+		FMemory::Memzero(Splats.SH_Rest.GetData(), Splats.SH_Rest.Num() * sizeof(float));
+
+		ParallelFor(Points.Num(), [&](int32 i)
+		{
+			const FPointCloudPoint& Point = Points[i];
+			Splats.Positions[i] = FVector3f(Point.Position);
+			Splats.Normals[i] = FVector3f(Point.Normal);
+			Splats.SH_DC[i] = FVector3f(FGaussianSplat::ColorToSH_DC(Point.Color));
+			Splats.Opacities[i] = 1.0f;
+			Splats.Scales[i] = FVector3f(LogScales[i], LogScales[i], LogScales[i]);
+			Splats.Rotations[i] = FQuat4f::Identity;
+		});
+
+		return Splats;
+	}
+
+	void FPlyWriter::EstimateInitialScales(const TArray<FPointCloudPoint>& Points, int32 NumNeighbors, float FallbackScale, TArray<float>& OutLogScales)
+	{
+		const int32 NumPoints = Points.Num();
+		OutLogScales.Init(FallbackScale, NumPoints);
+
+		NumNeighbors = FMath::Min(NumNeighbors, FPointKdTree::MaxNeighbors);
+		if (NumNeighbors <= 0 || NumPoints < 2)
+		{
+			return;
+		}
+
+		TArray<FVector3f> Positions;
+		Positions.SetNumUninitialized(NumPoints);
+		ParallelFor(NumPoints, [&](int32 i)
+		{
+			Positions[i] = FVector3f(Points[i].Position);
+		});
+
+		FPointKdTree Tree;
+		Tree.Build(Positions);
+
+		// Squared distances are floored as in reference 3DGS so coincident points keep a finite scale
+		constexpr float MinMeanDistanceSquared = 1e-7f;
+		constexpr int32 PointsPerBatch = 4096;
+
+		ParallelFor(FMath::DivideAndRoundUp(NumPoints, PointsPerBatch), [&](int32 BatchIndex)
+		{
+			int32 Neighbors[FPointKdTree::MaxNeighbors];
+			float DistancesSquared[FPointKdTree::MaxNeighbors];
+
+			const int32 First = BatchIndex * PointsPerBatch;
+			const int32 Last = FMath::Min(First + PointsPerBatch, NumPoints);
+			for (int32 i = First; i < Last; ++i)
+			{
+				const int32 NumFound = Tree.FindNearest(Positions[i], NumNeighbors, Neighbors, DistancesSquared, i);
+				if (NumFound == 0)
+				{
+					continue;
+				}
+
+				float Sum = 0.0f;
+				for (int32 k = 0; k < NumFound; ++k)
+				{
+					Sum += DistancesSquared[k];
+				}
+				OutLogScales[i] = 0.5f * FMath::Loge(FMath::Max(Sum / NumFound, MinMeanDistanceSquared));
+			}
+		});
+	}
+
 	bool FPlyWriter::ReadPointCloud(const FString& FilePath, TArray<FPointCloudPoint>& OutPoints)
 	{
 		OutPoints.Empty();
 
-		FString FileContent;
-		if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+		FMappedPlyFile File;
+		if (!MapPlyFile(FilePath, File))
 		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to load PLY file: %s"), *FilePath);
 			return false;
 		}
 
-		int32 NumVertices;
-		bool bIsBinary;
-		TArray<FString> Properties;
+		const FPlySchema& Schema = File.Schema;
+		const int32 VertexElementIndex = Schema.FindElement(TEXT("vertex"));
+		if (VertexElementIndex == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Error, TEXT("PLY file has no vertex element: %s"), *FilePath);
+			return false;
+		}
 
-		if (!ParsePlyHeader(FileContent, NumVertices, bIsBinary, Properties))
+		const FPlyElement& Vertex = Schema.Elements[VertexElementIndex];
+		if (Vertex.Count <= 0 || Vertex.Count > MAX_int32)
 		{
+			UE_LOG(LogTemp, Error, TEXT("Unsupported PLY vertex count %lld: %s"), Vertex.Count, *FilePath);
 			return false;
 		}
 
-		// Find data start
-		int32 EndHeaderPos = FileContent.Find(TEXT("end_header"));
-		if (EndHeaderPos == INDEX_NONE)
+		// Compile the header into a decode plan once; the per-vertex loop does no name lookups
+		FPlyDecodePlan Plan;
+		const bool bCompiled = FPlyDecodePlan::Compile(Schema, VertexElementIndex, [](const FPlyProperty& Property)
 		{
+			return GetPointCloudSlot(Property.Name);
+		}, Plan);
+
+		if (!bCompiled || !Plan.HasTarget(PointSlot_X) || !Plan.HasTarget(PointSlot_Y) || !Plan.HasTarget(PointSlot_Z))
+		{
+			UE_LOG(LogTemp, Error, TEXT("PLY vertex element lacks decodable x/y/z properties: %s"), *FilePath);
 			return false;
 		}
 
-		if (bIsBinary)
+		// Colors are normalized from their stored type to 0-255
+		double ColorScales[PointSlot_Count] = {};
+		for (const FPlyDecodeOp& Op : Plan.Ops)
+		{
+			switch (Op.Type)
+			{
+			case EPlyPropertyType::UInt16:
+				ColorScales[Op.Target] = 255.0 / 65535.0;
+				break;
+			case EPlyPropertyType::Float32:
+			case EPlyPropertyType::Float64:
+				ColorScales[Op.Target] = 255.0;
+				break;
+			default:
+				ColorScales[Op.Target] = 1.0;
+				break;
+			}
+		}
+
+		double DefaultSlots[PointSlot_Count] = {};
+		DefaultSlots[PointSlot_NZ] = 1.0;
+		DefaultSlots[PointSlot_Red] = DefaultSlots[PointSlot_Green] = DefaultSlots[PointSlot_Blue] = DefaultSlots[PointSlot_Alpha] = 255.0;
+		for (int32 Slot = PointSlot_Red; Slot <= PointSlot_Alpha; ++Slot)
+		{
+			// Defaults are already in 0-255
+			if (!Plan.HasTarget(Slot))
+			{
+				ColorScales[Slot] = 1.0;
+			}
+		}
+
+		const int32 NumVertices = static_cast<int32>(Vertex.Count);
+		OutPoints.SetNum(NumVertices);
+
+		if (Schema.IsBinary())
 		{
-			// Binary reading requires loading as byte array
-			TArray<uint8> FileData;
-			if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+			const int64 VertexDataOffset = Schema.GetBinaryElementOffset(VertexElementIndex);
+			if (!Vertex.HasFixedStride() ||
+				VertexDataOffset == INDEX_NONE ||
+				VertexDataOffset + Vertex.Count * Vertex.Stride > File.Size)
 			{
+				UE_LOG(LogTemp, Error, TEXT("PLY file is truncated or has variable-size vertices: %s"), *FilePath);
+				OutPoints.Empty();
 				return false;
 			}
 
-			// Find header end in binary data
-			int32 DataStart = EndHeaderPos + 11; // "end_header\n"
-			while (DataStart < FileData.Num() && FileData[DataStart - 1] != '\n')
+			const uint8* VertexData = File.Data + VertexDataOffset;
+			const int32 Stride = Plan.Stride;
+
+			constexpr int32 RowsPerBatch = 4096;
+			ParallelFor(FMath::DivideAndRoundUp(NumVertices, RowsPerBatch), [&](int32 BatchIndex)
 			{
-				DataStart++;
+				const int32 First = BatchIndex * RowsPerBatch;
+				const int32 Last = FMath::Min(First + RowsPerBatch, NumVertices);
+
+				double Slots[PointSlot_Count];
+				for (int32 i = First; i < Last; ++i)
+				{
+					FMemory::Memcpy(Slots, DefaultSlots, sizeof(Slots));
+					Plan.DecodeBinary(VertexData + static_cast<int64>(i) * Stride, Slots);
+					ApplyPointCloudSlots(Slots, ColorScales, OutPoints[i]);
+				}
+			});
+		}
+		else
+		{
+			// Records of elements stored before the vertices occupy one line each
+			int64 FirstRow = 0;
+			for (int32 ElementIndex = 0; ElementIndex < VertexElementIndex; ++ElementIndex)
+			{
+				FirstRow += Schema.Elements[ElementIndex].Count;
+			}
+
+			TArray<int64> RowStarts;
+			const int32 NumRows = Schema.FindAsciiRows(File.Data, File.Size, FirstRow, NumVertices, RowStarts);
+			if (NumRows != NumVertices)
+			{
+				UE_LOG(LogTemp, Error, TEXT("PLY file is truncated (%d of %d vertex rows): %s"), NumRows, NumVertices, *FilePath);
+				OutPoints.Empty();
+				return false;
 			}
 
-			OutPoints.SetNum(NumVertices);
+			const uint8* DataEnd = File.Data + File.Size;
 
-			// Read binary data
-			const uint8* Data = FileData.GetData() + DataStart;
-			for (int32 i = 0; i < NumVertices; ++i)
+			constexpr int32 RowsPerBatch = 4096;
+			ParallelFor(FMath::DivideAndRoundUp(NumVertices, RowsPerBatch), [&](int32 BatchIndex)
 			{
-				// Assume format: x y z nx ny nz r g b (little-endian floats + uint8 colors)
-				OutPoints[i].Position.X = *reinterpret_cast<const float*>(Data); Data += 4;
-				OutPoints[i].Position.Y = *reinterpret_cast<const float*>(Data); Data += 4;
-				OutPoints[i].Position.Z = *reinterpret_cast<const float*>(Data); Data += 4;
+				const int32 First = BatchIndex * RowsPerBatch;
+				const int32 Last = FMath::Min(First + RowsPerBatch, NumVertices);
 
-				if (Properties.Contains(TEXT("nx")))
+				double Slots[PointSlot_Count];
+				for (int32 i = First; i < Last; ++i)
 				{
-					OutPoints[i].Normal.X = *reinterpret_cast<const float*>(Data); Data += 4;
-					OutPoints[i].Normal.Y = *reinterpret_cast<const float*>(Data); Data += 4;
-					OutPoints[i].Normal.Z = *reinterpret_cast<const float*>(Data); Data += 4;
+					FMemory::Memcpy(Slots, DefaultSlots, sizeof(Slots));
+					Plan.DecodeAscii(File.Data + RowStarts[i], DataEnd, Slots);
+					ApplyPointCloudSlots(Slots, ColorScales, OutPoints[i]);
 				}
+			});
+		}
+
+		return OutPoints.Num() > 0;
+	}
+
+	int32 FPlyWriter::GetPointCloudSlot(const FString& PropertyName)
+	{
+		static const TMap<FString, int32> SlotsByName = {
+			{ TEXT("x"), PointSlot_X },
+			{ TEXT("y"), PointSlot_Y },
+			{ TEXT("z"), PointSlot_Z },
+			{ TEXT("nx"), PointSlot_NX },
+			{ TEXT("ny"), PointSlot_NY },
+			{ TEXT("nz"), PointSlot_NZ },
+			{ TEXT("red"), PointSlot_Red },
+			{ TEXT("green"), PointSlot_Green },
+			{ TEXT("blue"), PointSlot_Blue },
+			{ TEXT("alpha"), PointSlot_Alpha },
+			{ TEXT("diffuse_red"), PointSlot_Red },
+			{ TEXT("diffuse_green"), PointSlot_Green },
+			{ TEXT("diffuse_blue"), PointSlot_Blue },
+			{ TEXT("diffuse_alpha"), PointSlot_Alpha }
+		};
+
+		const int32* Slot = SlotsByName.Find(PropertyName);
+		return Slot ? *Slot : INDEX_NONE;
+	}
 
-				if (Properties.Contains(TEXT("red")))
+	void FPlyWriter::ApplyPointCloudSlots(const double* Slots, const double* ColorScales, FPointCloudPoint& OutPoint)
+	{
+		OutPoint.Position = FVector(Slots[PointSlot_X], Slots[PointSlot_Y], Slots[PointSlot_Z]);
+		OutPoint.Normal = FVector(Slots[PointSlot_NX], Slots[PointSlot_NY], Slots[PointSlot_NZ]);
+
+		auto ToColorChannel = [Slots, ColorScales](int32 Slot)
+		{
+			return static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Slots[Slot] * ColorScales[Slot]), 0, 255));
+		};
+
+		OutPoint.Color = FColor(
+			ToColorChannel(PointSlot_Red),
+			ToColorChannel(PointSlot_Green),
+			ToColorChannel(PointSlot_Blue),
+			ToColorChannel(PointSlot_Alpha)
+		);
+	}
+
+	FPlyWriter::FMappedPlyFile::~FMappedPlyFile()
+	{
+		// Region must be released before the file handle
+		Region.Reset();
+		Handle.Reset();
+	}
+
+	bool FPlyWriter::MapPlyFile(const FString& FilePath, FMappedPlyFile& OutFile)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		OutFile.Handle.Reset(PlatformFile.OpenMapped(*FilePath));
+		if (!OutFile.Handle)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to map PLY file: %s"), *FilePath);
+			return false;
+		}
+
+		OutFile.Size = OutFile.Handle->GetFileSize();
+		OutFile.Region.Reset(OutFile.Handle->MapRegion(0, OutFile.Size));
+		if (!OutFile.Region)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to map PLY file region: %s"), *FilePath);
+			return false;
+		}
+
+		OutFile.Data = OutFile.Region->GetMappedPtr();
+
+		if (!FPlySchema::Parse(OutFile.Data, OutFile.Size, OutFile.Schema))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Not a valid PLY file: %s"), *FilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FPlyWriter::ReadGaussianSplats(const FString& FilePath, TArray<FGaussianSplat>& OutSplats)
+	{
+		OutSplats.Empty();
+
+		FGaussianSplatBuffer Buffer;
+		if (!ReadGaussianSplats(FilePath, Buffer))
+		{
+			return false;
+		}
+
+		Buffer.ToSplats(OutSplats);
+		return true;
+	}
+
+	bool FPlyWriter::ReadGaussianSplats(const FString& FilePath, FGaussianSplatBuffer& OutSplats)
+	{
+		OutSplats.Empty();
+
+		// Map the file; the header is parsed and the splats decoded straight from the mapped pages
+		FMappedPlyFile File;
+		if (!MapPlyFile(FilePath, File))
+		{
+			return false;
+		}
+
+		const FPlySchema& Schema = File.Schema;
+		const int32 VertexElementIndex = Schema.FindElement(TEXT("vertex"));
+
+		// Degree-bucketed files store splats in one element per SH degree instead of "vertex"
+		TArray<int32> ElementIndices;
+		if (VertexElementIndex != INDEX_NONE)
+		{
+			ElementIndices.Add(VertexElementIndex);
+		}
+		else
+		{
+			for (int32 Degree = 0; Degree <= FSHDegreeReduction::MaxDegree; ++Degree)
+			{
+				const int32 BucketElementIndex = Schema.FindElement(FString::Printf(TEXT("%s%d"), DegreeElementPrefix, Degree));
+				if (BucketElementIndex != INDEX_NONE)
 				{
-					OutPoints[i].Color.R = *Data++;
-					OutPoints[i].Color.G = *Data++;
-					OutPoints[i].Color.B = *Data++;
+					ElementIndices.Add(BucketElementIndex);
 				}
 			}
 		}
-		else
+
+		if (ElementIndices.Num() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("PLY file has no vertex element: %s"), *FilePath);
+			return false;
+		}
+
+		int64 TotalSplats = 0;
+		for (int32 ElementIndex : ElementIndices)
+		{
+			TotalSplats += Schema.Elements[ElementIndex].Count;
+		}
+
+		if (TotalSplats > MAX_int32)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Gaussian splat PLY is truncated or has an unsupported layout: %s"), *FilePath);
+			return false;
+		}
+
+		OutSplats.SetNumUninitialized(static_cast<int32>(TotalSplats));
+
+		int32 FirstSplat = 0;
+		for (int32 ElementIndex : ElementIndices)
+		{
+			if (!DecodeGaussianElement(File, ElementIndex, FilePath, OutSplats, FirstSplat))
+			{
+				OutSplats.Empty();
+				return false;
+			}
+			FirstSplat += static_cast<int32>(Schema.Elements[ElementIndex].Count);
+		}
+
+		// SH codebook extension: vertices reference shared SH vectors
+		const int32 CodebookElementIndex = Schema.FindElement(TEXT("sh_codebook"));
+		if (VertexElementIndex != INDEX_NONE && CodebookElementIndex != INDEX_NONE &&
+			Schema.Elements[VertexElementIndex].FindProperty(TEXT("sh_index")) != INDEX_NONE)
+		{
+			if (!DecodeSHCodebook(File, VertexElementIndex, CodebookElementIndex, OutSplats))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Invalid SH codebook in %s"), *FilePath);
+				OutSplats.Empty();
+				return false;
+			}
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Read %d gaussian splats from %s"), OutSplats.Num(), *FilePath);
+		return true;
+	}
+
+	bool FPlyWriter::DecodeGaussianElement(const FMappedPlyFile& File, int32 ElementIndex, const FString& FilePath, FGaussianSplatBuffer& OutSplats, int32 FirstSplat)
+	{
+		const FPlySchema& Schema = File.Schema;
+		const FPlyElement& Vertex = Schema.Elements[ElementIndex];
+
+		const bool bIsGaussian = Vertex.FindProperty(TEXT("f_dc_0")) != INDEX_NONE ||
+			Vertex.FindProperty(TEXT("opacity")) != INDEX_NONE ||
+			Vertex.FindProperty(TEXT("scale_0")) != INDEX_NONE;
+
+		if (!bIsGaussian)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PLY file does not appear to contain gaussian splat data"));
+			return false;
+		}
+
+		if (!Schema.IsBinary() || !Vertex.HasFixedStride())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Gaussian splat PLY must be binary with fixed-size vertices: %s"), *FilePath);
+			return false;
+		}
+
+		const int64 VertexDataOffset = Schema.GetBinaryElementOffset(ElementIndex);
+		if (VertexDataOffset == INDEX_NONE ||
+			FirstSplat + Vertex.Count > OutSplats.Num() ||
+			VertexDataOffset + Vertex.Count * Vertex.Stride > File.Size)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Gaussian splat PLY is truncated or has an unsupported layout: %s"), *FilePath);
+			return false;
+		}
+
+		FPlyDecodePlan Plan;
+		if (!CompileGaussianPlan(Schema, ElementIndex, Plan))
+		{
+			return false;
+		}
+
+		// The layout written by this class maps one-to-one onto a row, allowing a single copy per record
+		bool bIsCanonicalLayout = Plan.Stride == BytesPerGaussianSplat && !Plan.bSwapBytes && Plan.Ops.Num() == NumGaussianProperties;
+		for (int32 i = 0; i < Plan.Ops.Num() && bIsCanonicalLayout; ++i)
+		{
+			const FPlyDecodeOp& Op = Plan.Ops[i];
+			bIsCanonicalLayout = Op.Type == EPlyPropertyType::Float32 &&
+				Op.Target == i &&
+				Op.Offset == i * static_cast<int32>(sizeof(float));
+		}
+
+		double DefaultSlots[NumGaussianProperties];
+		{
+			float DefaultRow[NumGaussianProperties];
+			GatherGaussianRow(FGaussianSplat(), DefaultRow);
+			for (int32 i = 0; i < NumGaussianProperties; ++i)
+			{
+				DefaultSlots[i] = DefaultRow[i];
+			}
+		}
+
+		const int32 NumSplats = static_cast<int32>(Vertex.Count);
+		const int32 Stride = Plan.Stride;
+		const uint8* VertexData = File.Data + VertexDataOffset;
+
+		constexpr int32 RowsPerBatch = 4096;
+		ParallelFor(FMath::DivideAndRoundUp(NumSplats, RowsPerBatch), [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * RowsPerBatch;
+			const int32 Last = FMath::Min(First + RowsPerBatch, NumSplats);
+
+			float Row[NumGaussianProperties];
+			double Slots[NumGaussianProperties];
+
+			for (int32 i = First; i < Last; ++i)
+			{
+				const uint8* Record = VertexData + static_cast<int64>(i) * Stride;
+
+				if (bIsCanonicalLayout)
+				{
+					FMemory::Memcpy(Row, Record, BytesPerGaussianSplat);
+				}
+				else
+				{
+					FMemory::Memcpy(Slots, DefaultSlots, sizeof(Slots));
+					Plan.DecodeBinary(Record, Slots);
+					for (int32 p = 0; p < NumGaussianProperties; ++p)
+					{
+						Row[p] = static_cast<float>(Slots[p]);
+					}
+				}
+
+				ScatterGaussianRow(OutSplats, FirstSplat + i, Row);
+			}
+		});
+
+		return true;
+	}
+
+	bool FPlyWriter::DecodeSHCodebook(const FMappedPlyFile& File, int32 VertexElementIndex, int32 CodebookElementIndex, FGaussianSplatBuffer& OutSplats)
+	{
+		const FPlySchema& Schema = File.Schema;
+		const FPlyElement& Vertex = Schema.Elements[VertexElementIndex];
+		const FPlyElement& CodebookElement = Schema.Elements[CodebookElementIndex];
+		const int64 CodebookOffset = Schema.GetBinaryElementOffset(CodebookElementIndex);
+
+		if (!CodebookElement.HasFixedStride() ||
+			CodebookOffset == INDEX_NONE ||
+			CodebookElement.Count > FSHCodebook::MaxEntries ||
+			CodebookOffset + CodebookElement.Count * CodebookElement.Stride > File.Size)
 		{
-			// ASCII reading
-			TArray<FString> Lines;
-			FileContent.ParseIntoArrayLines(Lines);
+			return false;
+		}
 
-			int32 LineIdx = 0;
-			for (; LineIdx < Lines.Num(); ++LineIdx)
+		FPlyDecodePlan IndexPlan;
+		FPlyDecodePlan EntryPlan;
+		const bool bCompiled =
+			FPlyDecodePlan::Compile(Schema, VertexElementIndex, [](const FPlyProperty& Property)
 			{
-				if (Lines[LineIdx].StartsWith(TEXT("end_header")))
+				return Property.Name == TEXT("sh_index") ? 0 : INDEX_NONE;
+			}, IndexPlan) &&
+			FPlyDecodePlan::Compile(Schema, CodebookElementIndex, [](const FPlyProperty& Property)
+			{
+				// Entries use the 45-coefficient SH_Rest layout directly
+				int32 RestIndex = INDEX_NONE;
+				if (Property.Name.StartsWith(TEXT("f_rest_")))
 				{
-					LineIdx++;
-					break;
+					LexFromString(RestIndex, *Property.Name.RightChop(7));
 				}
-			}
+				return (RestIndex >= 0 && RestIndex < FSHCodebook::Dimension) ? RestIndex : INDEX_NONE;
+			}, EntryPlan);
+
+		if (!bCompiled)
+		{
+			return false;
+		}
 
-			OutPoints.SetNum(NumVertices);
-			for (int32 i = 0; i < NumVertices && LineIdx < Lines.Num(); ++i, ++LineIdx)
+		const int32 NumEntries = static_cast<int32>(CodebookElement.Count);
+		TArray<float> Entries;
+		Entries.SetNumUninitialized(NumEntries * FSHCodebook::Dimension);
+
+		const uint8* EntryData = File.Data + CodebookOffset;
+		for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+		{
+			double Slots[FSHCodebook::Dimension] = {};
+			EntryPlan.DecodeBinary(EntryData + static_cast<int64>(Entry) * CodebookElement.Stride, Slots);
+			for (int32 d = 0; d < FSHCodebook::Dimension; ++d)
 			{
-				TArray<FString> Values;
-				Lines[LineIdx].ParseIntoArray(Values, TEXT(" "));
+				Entries[Entry * FSHCodebook::Dimension + d] = static_cast<float>(Slots[d]);
+			}
+		}
 
-				if (Values.Num() >= 3)
-				{
-					OutPoints[i].Position.X = FCString::Atof(*Values[0]);
-					OutPoints[i].Position.Y = FCString::Atof(*Values[1]);
-					OutPoints[i].Position.Z = FCString::Atof(*Values[2]);
-				}
+		const uint8* VertexData = File.Data + Schema.GetBinaryElementOffset(VertexElementIndex);
+		std::atomic<bool> bInvalidIndex(false);
 
-				if (Values.Num() >= 6)
-				{
-					OutPoints[i].Normal.X = FCString::Atof(*Values[3]);
-					OutPoints[i].Normal.Y = FCString::Atof(*Values[4]);
-					OutPoints[i].Normal.Z = FCString::Atof(*Values[5]);
-				}
+		ParallelFor(OutSplats.Num(), [&](int32 i)
+		{
+			double Index = 0.0;
+			IndexPlan.DecodeBinary(VertexData + static_cast<int64>(i) * Vertex.Stride, &Index);
 
-				if (Values.Num() >= 9)
-				{
-					OutPoints[i].Color.R = FCString::Atoi(*Values[6]);
-					OutPoints[i].Color.G = FCString::Atoi(*Values[7]);
-					OutPoints[i].Color.B = FCString::Atoi(*Values[8]);
-				}
+			const int32 Entry = static_cast<int32>(Index);
+			if (Entry < 0 || Entry >= NumEntries)
+			{
+				bInvalidIndex = true;
+				return;
 			}
-		}
 
-		return OutPoints.Num() > 0;
+			FMemory::Memcpy(OutSplats.GetSHRest(i), Entries.GetData() + Entry * FSHCodebook::Dimension, FSHCodebook::Dimension * sizeof(float));
+		});
+
+		return !bInvalidIndex;
 	}
 
-	bool FPlyWriter::ReadGaussianSplats(const FString& FilePath, TArray<FGaussianSplat>& OutSplats)
+	bool FPlyWriter::CompileGaussianPlan(const FPlySchema& Schema, int32 VertexElementIndex, FPlyDecodePlan& OutPlan)
 	{
-		// Gaussian splat PLY reading is more complex due to the 59 properties
-		// This is a simplified implementation
-		OutSplats.Empty();
-
-		int32 NumVertices;
-		bool bIsBinary;
-		bool bIsGaussian;
-
-		if (!GetPlyInfo(FilePath, NumVertices, bIsBinary, bIsGaussian))
+		const FPlyElement& Vertex = Schema.Elements[VertexElementIndex];
+		const TArray<FString>& Names = GetGaussianPropertyNames();
+		constexpr int32 FirstRestSlot = 9;
+		constexpr int32 RestCoeffsPerChannel = FGaussianSplatBuffer::NumSHRest / 3;
+
+		// Files trained with fewer SH bands store fewer f_rest values, still channel-major
+		int32 NumRest = 0;
+		while (Vertex.FindProperty(FString::Printf(TEXT("f_rest_%d"), NumRest)) != INDEX_NONE)
 		{
-			return false;
+			++NumRest;
 		}
 
-		if (!bIsGaussian)
+		if (NumRest % 3 != 0 || NumRest > FGaussianSplatBuffer::NumSHRest)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("PLY file does not appear to contain gaussian splat data"));
+			UE_LOG(LogTemp, Error, TEXT("Unsupported number of f_rest properties: %d"), NumRest);
 			return false;
 		}
 
-		// Full implementation would read all 59 properties
-		// For now, we just create default splats based on count
-		OutSplats.SetNum(NumVertices);
+		const int32 FileCoeffsPerChannel = NumRest / 3;
 
-		UE_LOG(LogTemp, Log, TEXT("Gaussian splat file contains %d splats"), NumVertices);
-		return true;
+		TMap<FString, int32> SlotsByName;
+		for (int32 Slot = 0; Slot < NumGaussianProperties; ++Slot)
+		{
+			// Remap f_rest slots from the file's band count to the 45-coefficient layout
+			const int32 RestIndex = Slot - FirstRestSlot;
+			if (RestIndex >= 0 && RestIndex < FGaussianSplatBuffer::NumSHRest)
+			{
+				const int32 Channel = RestIndex / RestCoeffsPerChannel;
+				const int32 Coeff = RestIndex % RestCoeffsPerChannel;
+				if (Coeff < FileCoeffsPerChannel)
+				{
+					SlotsByName.Add(FString::Printf(TEXT("f_rest_%d"), Channel * FileCoeffsPerChannel + Coeff), Slot);
+				}
+				continue;
+			}
+
+			SlotsByName.Add(Names[Slot], Slot);
+		}
+
+		return FPlyDecodePlan::Compile(Schema, VertexElementIndex, [&SlotsByName](const FPlyProperty& Property)
+		{
+			const int32* Slot = SlotsByName.Find(Property.Name);
+			return Slot ? *Slot : INDEX_NONE;
+		}, OutPlan);
 	}
 
 	bool FPlyWriter::GetPlyInfo(
@@ -290,31 +996,104 @@ namespace UE5_3DGS
 		OutIsBinary = false;
 		OutIsGaussian = false;
 
-		FString FileContent;
-		if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+		FPlySchema Schema;
+		if (!ReadPlyHeader(FilePath, Schema))
 		{
 			return false;
 		}
 
-		TArray<FString> Properties;
-		if (!ParsePlyHeader(FileContent, OutNumVertices, OutIsBinary, Properties))
+		const int32 VertexElementIndex = Schema.FindElement(TEXT("vertex"));
+		if (VertexElementIndex == INDEX_NONE)
+		{
+			// Degree-bucketed gaussian file
+			int64 NumSplats = 0;
+			for (int32 Degree = 0; Degree <= FSHDegreeReduction::MaxDegree; ++Degree)
+			{
+				const int32 BucketElementIndex = Schema.FindElement(FString::Printf(TEXT("%s%d"), DegreeElementPrefix, Degree));
+				if (BucketElementIndex != INDEX_NONE)
+				{
+					NumSplats += Schema.Elements[BucketElementIndex].Count;
+				}
+			}
+
+			if (NumSplats <= 0)
+			{
+				return false;
+			}
+
+			OutNumVertices = static_cast<int32>(FMath::Min<int64>(NumSplats, MAX_int32));
+			OutIsBinary = Schema.IsBinary();
+			OutIsGaussian = true;
+			return true;
+		}
+
+		if (Schema.Elements[VertexElementIndex].Count <= 0)
 		{
 			return false;
 		}
 
+		const FPlyElement& Vertex = Schema.Elements[VertexElementIndex];
+		OutNumVertices = static_cast<int32>(FMath::Min<int64>(Vertex.Count, MAX_int32));
+		OutIsBinary = Schema.IsBinary();
+
 		// Check for gaussian-specific properties
-		OutIsGaussian = Properties.Contains(TEXT("f_dc_0")) ||
-			Properties.Contains(TEXT("opacity")) ||
-			Properties.Contains(TEXT("scale_0"));
+		OutIsGaussian = Vertex.FindProperty(TEXT("f_dc_0")) != INDEX_NONE ||
+			Vertex.FindProperty(TEXT("opacity")) != INDEX_NONE ||
+			Vertex.FindProperty(TEXT("scale_0")) != INDEX_NONE;
+
+		return true;
+	}
+
+	bool FPlyWriter::ReadPlyHeader(const FString& FilePath, FPlySchema& OutSchema)
+	{
+		OutSchema = FPlySchema();
+
+		// Each call owns its handle and buffer, so concurrent probes never contend
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		if (!Handle)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open PLY file: %s"), *FilePath);
+			return false;
+		}
+
+		const int64 FileSize = Handle->Size();
+		TArray<uint8> Buffer;
+		int64 BytesRead = 0;
+
+		for (int64 ProbeSize = HeaderProbeBytes; ; ProbeSize *= 2)
+		{
+			ProbeSize = FMath::Min<int64>(ProbeSize, FMath::Min<int64>(FileSize, MaxHeaderBytes));
+
+			// Extra byte keeps the buffer null-terminated for the end_header search
+			Buffer.SetNumZeroed(ProbeSize + 1);
+			if (!Handle->Read(Buffer.GetData() + BytesRead, ProbeSize - BytesRead))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to read PLY header: %s"), *FilePath);
+				return false;
+			}
+			BytesRead = ProbeSize;
+
+			// The header is complete only once end_header's line terminator is in the buffer
+			const ANSICHAR* HeaderEnd = FCStringAnsi::Strstr(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), "end_header");
+			if ((HeaderEnd && FCStringAnsi::Strchr(HeaderEnd, '\n')) || BytesRead >= FileSize || BytesRead >= MaxHeaderBytes)
+			{
+				break;
+			}
+		}
+
+		if (!FPlySchema::Parse(Buffer.GetData(), BytesRead, OutSchema))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Not a valid PLY file: %s"), *FilePath);
+			return false;
+		}
 
 		return true;
 	}
 
 	int64 FPlyWriter::EstimateMemoryUsage(int32 NumSplats)
 	{
-		// 236 bytes per splat (standard 3DGS format)
 		// Position: 12, Normal: 12, SH_DC: 12, SH_Rest: 180, Opacity: 4, Scale: 12, Rotation: 16
-		return static_cast<int64>(NumSplats) * 236;
+		return static_cast<int64>(NumSplats) * BytesPerGaussianSplat;
 	}
 
 	bool FPlyWriter::ValidateSplats(const TArray<FGaussianSplat>& Splats, TArray<FString>& OutWarnings)
@@ -335,7 +1114,7 @@ namespace UE5_3DGS
 		for (const FGaussianSplat& Splat : Splats)
 		{
 			// Check position
-			if (!Splat.Position.ContainsNaN() && !FMath::IsFinite(Splat.Position.X))
+			if (!IsValidSplatPosition(FVector3f(Splat.Position)))
 			{
 				InvalidPos++;
 			}
@@ -360,6 +1139,61 @@ namespace UE5_3DGS
 			}
 		}
 
+		return AppendValidationWarnings(Splats.Num(), InvalidPos, InvalidOpacity, InvalidScale, InvalidRotation, OutWarnings);
+	}
+
+	bool FPlyWriter::ValidateSplats(const FGaussianSplatBuffer& Splats, TArray<FString>& OutWarnings)
+	{
+		OutWarnings.Empty();
+
+		if (Splats.IsEmpty())
+		{
+			OutWarnings.Add(TEXT("Empty splat array"));
+			return false;
+		}
+
+		int32 InvalidPos = 0;
+		int32 InvalidOpacity = 0;
+		int32 InvalidScale = 0;
+		int32 InvalidRotation = 0;
+
+		// Per-attribute passes over contiguous arrays
+		for (const FVector3f& Position : Splats.Positions)
+		{
+			InvalidPos += IsValidSplatPosition(Position) ? 0 : 1;
+		}
+
+		for (float Opacity : Splats.Opacities)
+		{
+			InvalidOpacity += (Opacity < 0.0f || Opacity > 1.0f) ? 1 : 0;
+		}
+
+		for (const FVector3f& Scale : Splats.Scales)
+		{
+			InvalidScale += (Scale.X > 10.0f || Scale.X < -20.0f) ? 1 : 0;
+		}
+
+		for (const FQuat4f& Rotation : Splats.Rotations)
+		{
+			InvalidRotation += (FMath::Abs(Rotation.Size() - 1.0f) > 0.01f) ? 1 : 0;
+		}
+
+		return AppendValidationWarnings(Splats.Num(), InvalidPos, InvalidOpacity, InvalidScale, InvalidRotation, OutWarnings);
+	}
+
+	bool FPlyWriter::IsValidSplatPosition(const FVector3f& Position)
+	{
+		return FMath::IsFinite(Position.X) && FMath::IsFinite(Position.Y) && FMath::IsFinite(Position.Z);
+	}
+
+	bool FPlyWriter::AppendValidationWarnings(
+		int32 NumSplats,
+		int32 InvalidPos,
+		int32 InvalidOpacity,
+		int32 InvalidScale,
+		int32 InvalidRotation,
+		TArray<FString>& OutWarnings)
+	{
 		if (InvalidPos > 0)
 		{
 			OutWarnings.Add(FString::Printf(TEXT("%d splats have invalid positions"), InvalidPos));
@@ -378,13 +1212,13 @@ namespace UE5_3DGS
 		}
 
 		// Check total count
-		if (Splats.Num() < 1000)
+		if (NumSplats < 1000)
 		{
-			OutWarnings.Add(FString::Printf(TEXT("Low splat count (%d). 10K-1M typical for quality scenes."), Splats.Num()));
+			OutWarnings.Add(FString::Printf(TEXT("Low splat count (%d). 10K-1M typical for quality scenes."), NumSplats));
 		}
-		else if (Splats.Num() > 10000000)
+		else if (NumSplats > 10000000)
 		{
-			OutWarnings.Add(FString::Printf(TEXT("Very high splat count (%d). May impact performance."), Splats.Num()));
+			OutWarnings.Add(FString::Printf(TEXT("Very high splat count (%d). May impact performance."), NumSplats));
 		}
 
 		return InvalidPos == 0;
@@ -416,45 +1250,107 @@ namespace UE5_3DGS
 		Header += bBinary ? TEXT("format binary_little_endian 1.0\n") : TEXT("format ascii 1.0\n");
 		Header += FString::Printf(TEXT("element vertex %d\n"), NumSplats);
 
-		// Position
-		Header += TEXT("property float x\n");
-		Header += TEXT("property float y\n");
-		Header += TEXT("property float z\n");
+		// Position, normal, DC SH, rest SH (45 values for order 3), opacity, scale, rotation
+		for (const FString& Name : GetGaussianPropertyNames())
+		{
+			Header += FString::Printf(TEXT("property float %s\n"), *Name);
+		}
 
-		// Normal
-		Header += TEXT("property float nx\n");
-		Header += TEXT("property float ny\n");
-		Header += TEXT("property float nz\n");
+		Header += TEXT("end_header\n");
+		return Header;
+	}
+
+	FString FPlyWriter::GenerateGaussianCodebookHeader(int32 NumSplats, int32 NumEntries)
+	{
+		constexpr int32 FirstRestSlot = 9;
+		const TArray<FString>& Names = GetGaussianPropertyNames();
+
+		FString Header;
+		Header += TEXT("ply\n");
+		Header += TEXT("format binary_little_endian 1.0\n");
+		Header += TEXT("comment f_rest_* of each vertex are the sh_codebook entry at sh_index\n");
+		Header += FString::Printf(TEXT("element vertex %d\n"), NumSplats);
 
-		// DC SH coefficients
-		Header += TEXT("property float f_dc_0\n");
-		Header += TEXT("property float f_dc_1\n");
-		Header += TEXT("property float f_dc_2\n");
+		for (int32 Slot = 0; Slot < Names.Num(); ++Slot)
+		{
+			if (Slot < FirstRestSlot || Slot >= FirstRestSlot + FGaussianSplatBuffer::NumSHRest)
+			{
+				Header += FString::Printf(TEXT("property float %s\n"), *Names[Slot]);
+			}
+		}
+		Header += TEXT("property ushort sh_index\n");
 
-		// Rest SH coefficients (45 values for order 3)
-		for (int32 i = 0; i < 45; ++i)
+		Header += FString::Printf(TEXT("element sh_codebook %d\n"), NumEntries);
+		for (int32 i = 0; i < FGaussianSplatBuffer::NumSHRest; ++i)
 		{
-			Header += FString::Printf(TEXT("property float f_rest_%d\n"), i);
+			Header += FString::Printf(TEXT("property float %s\n"), *Names[FirstRestSlot + i]);
 		}
 
-		// Opacity
-		Header += TEXT("property float opacity\n");
+		Header += TEXT("end_header\n");
+		return Header;
+	}
 
-		// Scale
-		Header += TEXT("property float scale_0\n");
-		Header += TEXT("property float scale_1\n");
-		Header += TEXT("property float scale_2\n");
+	FString FPlyWriter::GenerateGaussianDegreeHeader(const int32* NumPerDegree)
+	{
+		constexpr int32 FirstRestSlot = 9;
+		constexpr int32 FirstTailSlot = FirstRestSlot + FGaussianSplatBuffer::NumSHRest;
+		const TArray<FString>& Names = GetGaussianPropertyNames();
+
+		FString Header;
+		Header += TEXT("ply\n");
+		Header += TEXT("format binary_little_endian 1.0\n");
+		Header += TEXT("comment splats bucketed by SH degree, vertex_sh<d> stores bands 1..d\n");
+
+		for (int32 Degree = 0; Degree <= FSHDegreeReduction::MaxDegree; ++Degree)
+		{
+			Header += FString::Printf(TEXT("element %s%d %d\n"), DegreeElementPrefix, Degree, NumPerDegree[Degree]);
 
-		// Rotation
-		Header += TEXT("property float rot_0\n");
-		Header += TEXT("property float rot_1\n");
-		Header += TEXT("property float rot_2\n");
-		Header += TEXT("property float rot_3\n");
+			for (int32 Slot = 0; Slot < FirstRestSlot; ++Slot)
+			{
+				Header += FString::Printf(TEXT("property float %s\n"), *Names[Slot]);
+			}
+			for (int32 i = 0; i < 3 * FSHDegreeReduction::GetCoeffsPerChannel(Degree); ++i)
+			{
+				Header += FString::Printf(TEXT("property float f_rest_%d\n"), i);
+			}
+			for (int32 Slot = FirstTailSlot; Slot < NumGaussianProperties; ++Slot)
+			{
+				Header += FString::Printf(TEXT("property float %s\n"), *Names[Slot]);
+			}
+		}
 
 		Header += TEXT("end_header\n");
 		return Header;
 	}
 
+	const TArray<FString>& FPlyWriter::GetGaussianPropertyNames()
+	{
+		static const TArray<FString> Names = []()
+		{
+			TArray<FString> Result = {
+				TEXT("x"), TEXT("y"), TEXT("z"),
+				TEXT("nx"), TEXT("ny"), TEXT("nz"),
+				TEXT("f_dc_0"), TEXT("f_dc_1"), TEXT("f_dc_2")
+			};
+
+			for (int32 i = 0; i < FGaussianSplatBuffer::NumSHRest; ++i)
+			{
+				Result.Add(FString::Printf(TEXT("f_rest_%d"), i));
+			}
+
+			Result.Append({
+				TEXT("opacity"),
+				TEXT("scale_0"), TEXT("scale_1"), TEXT("scale_2"),
+				TEXT("rot_0"), TEXT("rot_1"), TEXT("rot_2"), TEXT("rot_3")
+			});
+
+			check(Result.Num() == NumGaussianProperties);
+			return Result;
+		}();
+
+		return Names;
+	}
+
 	bool FPlyWriter::WritePointCloudBinary(const FString& FilePath, const TArray<FPointCloudPoint>& Points)
 	{
 		FString Header = GeneratePointCloudHeader(Points.Num(), true);
@@ -494,177 +1390,249 @@ namespace UE5_3DGS
 
 	bool FPlyWriter::WritePointCloudASCII(const FString& FilePath, const TArray<FPointCloudPoint>& Points)
 	{
-		FString Content = GeneratePointCloudHeader(Points.Num(), false);
+		// 6 floats + 3 colors (up to 3 digits) with separators
+		constexpr int32 MaxRowChars = 6 * (MaxAsciiFloatChars + 1) + 3 * 4;
 
-		for (const FPointCloudPoint& Point : Points)
-		{
-			Content += FString::Printf(TEXT("%.6f %.6f %.6f %.6f %.6f %.6f %d %d %d\n"),
-				Point.Position.X, Point.Position.Y, Point.Position.Z,
-				Point.Normal.X, Point.Normal.Y, Point.Normal.Z,
-				Point.Color.R, Point.Color.G, Point.Color.B
-			);
-		}
+		return WriteAsciiPly(FilePath, GeneratePointCloudHeader(Points.Num(), false), Points.Num(), MaxRowChars,
+			[&Points](int32 RowIndex, ANSICHAR* Cursor)
+			{
+				const FPointCloudPoint& Point = Points[RowIndex];
+				const float Values[6] = {
+					static_cast<float>(Point.Position.X), static_cast<float>(Point.Position.Y), static_cast<float>(Point.Position.Z),
+					static_cast<float>(Point.Normal.X), static_cast<float>(Point.Normal.Y), static_cast<float>(Point.Normal.Z)
+				};
+
+				for (float Value : Values)
+				{
+					Cursor = AppendAsciiFloat(Cursor, Value);
+					*Cursor++ = ' ';
+				}
 
-		return FFileHelper::SaveStringToFile(Content, *FilePath);
+				Cursor = AppendAsciiInt(Cursor, Point.Color.R);
+				*Cursor++ = ' ';
+				Cursor = AppendAsciiInt(Cursor, Point.Color.G);
+				*Cursor++ = ' ';
+				Cursor = AppendAsciiInt(Cursor, Point.Color.B);
+				*Cursor++ = '\n';
+				return Cursor;
+			});
 	}
 
-	bool FPlyWriter::WriteGaussianBinary(const FString& FilePath, const TArray<FGaussianSplat>& Splats)
+	bool FPlyWriter::WriteAsciiPly(const FString& FilePath, const FString& Header, int32 NumRows, int32 MaxRowChars, FAsciiRowFormatter FormatRow)
 	{
-		FString Header = GenerateGaussianHeader(Splats.Num(), true);
-
-		// 236 bytes per splat
-		TArray<uint8> Data;
-		Data.Reserve(Header.Len() + Splats.Num() * 236);
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open PLY file for writing: %s"), *FilePath);
+			return false;
+		}
 
-		// Append header
 		FTCHARToUTF8 UTF8Header(*Header);
-		Data.Append(reinterpret_cast<const uint8*>(UTF8Header.Get()), UTF8Header.Length());
+		Writer->Serialize(const_cast<ANSICHAR*>(UTF8Header.Get()), UTF8Header.Length());
 
-		// Append splat data
-		for (const FGaussianSplat& Splat : Splats)
-		{
-			// Position (12 bytes)
-			float X = Splat.Position.X;
-			float Y = Splat.Position.Y;
-			float Z = Splat.Position.Z;
-			Data.Append(reinterpret_cast<uint8*>(&X), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&Y), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&Z), sizeof(float));
+		// Rows are formatted in blocks, a wave of blocks at a time, so memory stays bounded
+		constexpr int32 RowsPerBlock = 1024;
+		const int32 NumBlocks = FMath::DivideAndRoundUp(NumRows, RowsPerBlock);
+		const int32 BlocksPerWave = FMath::Max(1, 2 * (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1));
 
-			// Normal (12 bytes)
-			float NX = Splat.Normal.X;
-			float NY = Splat.Normal.Y;
-			float NZ = Splat.Normal.Z;
-			Data.Append(reinterpret_cast<uint8*>(&NX), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&NY), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&NZ), sizeof(float));
+		TArray<TArray<ANSICHAR>> BlockBuffers;
+		TArray<int64> BlockLengths;
+		BlockBuffers.SetNum(FMath::Min(BlocksPerWave, NumBlocks));
+		BlockLengths.SetNumZeroed(BlockBuffers.Num());
 
-			// DC SH (12 bytes)
-			float DC0 = Splat.SH_DC.X;
-			float DC1 = Splat.SH_DC.Y;
-			float DC2 = Splat.SH_DC.Z;
-			Data.Append(reinterpret_cast<uint8*>(&DC0), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&DC1), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&DC2), sizeof(float));
+		for (int32 WaveStart = 0; WaveStart < NumBlocks && !Writer->IsError(); WaveStart += BlocksPerWave)
+		{
+			const int32 WaveBlocks = FMath::Min(BlocksPerWave, NumBlocks - WaveStart);
 
-			// Rest SH (180 bytes = 45 floats)
-			for (int32 i = 0; i < 45; ++i)
+			ParallelFor(WaveBlocks, [&](int32 WaveBlock)
 			{
-				float SHVal = (i < Splat.SH_Rest.Num()) ? Splat.SH_Rest[i] : 0.0f;
-				Data.Append(reinterpret_cast<uint8*>(&SHVal), sizeof(float));
-			}
-
-			// Opacity (4 bytes)
-			float Opacity = Splat.Opacity;
-			Data.Append(reinterpret_cast<uint8*>(&Opacity), sizeof(float));
-
-			// Scale (12 bytes)
-			float S0 = Splat.Scale.X;
-			float S1 = Splat.Scale.Y;
-			float S2 = Splat.Scale.Z;
-			Data.Append(reinterpret_cast<uint8*>(&S0), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&S1), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&S2), sizeof(float));
-
-			// Rotation XYZW (16 bytes)
-			float R0 = Splat.Rotation.X;
-			float R1 = Splat.Rotation.Y;
-			float R2 = Splat.Rotation.Z;
-			float R3 = Splat.Rotation.W;
-			Data.Append(reinterpret_cast<uint8*>(&R0), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&R1), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&R2), sizeof(float));
-			Data.Append(reinterpret_cast<uint8*>(&R3), sizeof(float));
-		}
-
-		return FFileHelper::SaveArrayToFile(Data, *FilePath);
-	}
-
-	bool FPlyWriter::WriteGaussianASCII(const FString& FilePath, const TArray<FGaussianSplat>& Splats)
-	{
-		FString Content = GenerateGaussianHeader(Splats.Num(), false);
+				const int32 First = (WaveStart + WaveBlock) * RowsPerBlock;
+				const int32 Last = FMath::Min(First + RowsPerBlock, NumRows);
 
-		for (const FGaussianSplat& Splat : Splats)
-		{
-			// Position
-			Content += FString::Printf(TEXT("%.6f %.6f %.6f "),
-				Splat.Position.X, Splat.Position.Y, Splat.Position.Z);
+				TArray<ANSICHAR>& Buffer = BlockBuffers[WaveBlock];
+				Buffer.Reset();
+				Buffer.AddUninitialized((Last - First) * MaxRowChars);
 
-			// Normal
-			Content += FString::Printf(TEXT("%.6f %.6f %.6f "),
-				Splat.Normal.X, Splat.Normal.Y, Splat.Normal.Z);
+				ANSICHAR* Cursor = Buffer.GetData();
+				for (int32 RowIndex = First; RowIndex < Last; ++RowIndex)
+				{
+					Cursor = FormatRow(RowIndex, Cursor);
+				}
 
-			// DC SH
-			Content += FString::Printf(TEXT("%.6f %.6f %.6f "),
-				Splat.SH_DC.X, Splat.SH_DC.Y, Splat.SH_DC.Z);
+				BlockLengths[WaveBlock] = Cursor - Buffer.GetData();
+			});
 
-			// Rest SH
-			for (int32 i = 0; i < 45; ++i)
+			// Concatenate in row order
+			for (int32 WaveBlock = 0; WaveBlock < WaveBlocks; ++WaveBlock)
 			{
-				float SHVal = (i < Splat.SH_Rest.Num()) ? Splat.SH_Rest[i] : 0.0f;
-				Content += FString::Printf(TEXT("%.6f "), SHVal);
+				Writer->Serialize(BlockBuffers[WaveBlock].GetData(), BlockLengths[WaveBlock]);
 			}
+		}
 
-			// Opacity
-			Content += FString::Printf(TEXT("%.6f "), Splat.Opacity);
-
-			// Scale
-			Content += FString::Printf(TEXT("%.6f %.6f %.6f "),
-				Splat.Scale.X, Splat.Scale.Y, Splat.Scale.Z);
-
-			// Rotation
-			Content += FString::Printf(TEXT("%.6f %.6f %.6f %.6f\n"),
-				Splat.Rotation.X, Splat.Rotation.Y, Splat.Rotation.Z, Splat.Rotation.W);
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write PLY file: %s"), *FilePath);
+			return false;
 		}
 
-		return FFileHelper::SaveStringToFile(Content, *FilePath);
+		return true;
 	}
 
-	bool FPlyWriter::ParsePlyHeader(const FString& Content, int32& OutNumVertices, bool& OutIsBinary, TArray<FString>& OutProperties)
+	ANSICHAR* FPlyWriter::AppendAsciiFloat(ANSICHAR* Cursor, float Value)
 	{
-		OutNumVertices = 0;
-		OutIsBinary = false;
-		OutProperties.Empty();
+#if PLATFORM_MAC
+		// Floating-point to_chars needs macOS 13.3; 9 significant digits still round-trip exactly
+		return Cursor + FCStringAnsi::Snprintf(Cursor, MaxAsciiFloatChars, "%.9g", static_cast<double>(Value));
+#else
+		// Shortest representation that parses back to the same float
+		const std::to_chars_result Result = std::to_chars(Cursor, Cursor + MaxAsciiFloatChars, Value);
+		return Result.ptr;
+#endif
+	}
 
-		TArray<FString> Lines;
-		Content.ParseIntoArrayLines(Lines);
+	ANSICHAR* FPlyWriter::AppendAsciiInt(ANSICHAR* Cursor, int32 Value)
+	{
+		const std::to_chars_result Result = std::to_chars(Cursor, Cursor + 12, Value);
+		return Result.ptr;
+	}
 
-		if (Lines.Num() == 0 || !Lines[0].StartsWith(TEXT("ply")))
+	bool FPlyWriter::WriteGaussianBinary(const FString& FilePath, int32 NumSplats, FGaussianRowGatherer GatherRow)
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
 		{
-			UE_LOG(LogTemp, Error, TEXT("Not a valid PLY file"));
+			UE_LOG(LogTemp, Error, TEXT("Failed to open PLY file for writing: %s"), *FilePath);
 			return false;
 		}
 
-		for (const FString& Line : Lines)
+		// Header
+		FString Header = GenerateGaussianHeader(NumSplats, true);
+		FTCHARToUTF8 UTF8Header(*Header);
+		Writer->Serialize(const_cast<ANSICHAR*>(UTF8Header.Get()), UTF8Header.Length());
+
+		// Splat data is serialized chunk by chunk into one reusable buffer, so peak memory
+		// stays at BinaryWriteChunkSplats * BytesPerGaussianSplat bytes regardless of the splat count
+		TArray<float> ChunkBuffer;
+		ChunkBuffer.SetNumUninitialized(FMath::Min(NumSplats, BinaryWriteChunkSplats) * NumGaussianProperties);
+
+		// Rows within a chunk are independent, gather them in parallel batches
+		constexpr int32 RowsPerBatch = 1024;
+
+		for (int32 ChunkStart = 0; ChunkStart < NumSplats && !Writer->IsError(); ChunkStart += BinaryWriteChunkSplats)
 		{
-			if (Line.Contains(TEXT("binary")))
-			{
-				OutIsBinary = true;
-			}
-			else if (Line.StartsWith(TEXT("element vertex")))
+			const int32 ChunkCount = FMath::Min(BinaryWriteChunkSplats, NumSplats - ChunkStart);
+			const int32 NumBatches = FMath::DivideAndRoundUp(ChunkCount, RowsPerBatch);
+			float* ChunkData = ChunkBuffer.GetData();
+
+			ParallelFor(NumBatches, [&](int32 BatchIndex)
 			{
-				TArray<FString> Parts;
-				Line.ParseIntoArray(Parts, TEXT(" "));
-				if (Parts.Num() >= 3)
+				const int32 First = BatchIndex * RowsPerBatch;
+				const int32 Last = FMath::Min(First + RowsPerBatch, ChunkCount);
+				for (int32 i = First; i < Last; ++i)
 				{
-					OutNumVertices = FCString::Atoi(*Parts[2]);
+					GatherRow(ChunkStart + i, ChunkData + static_cast<int64>(i) * NumGaussianProperties);
 				}
-			}
-			else if (Line.StartsWith(TEXT("property")))
+			});
+
+			Writer->Serialize(ChunkData, static_cast<int64>(ChunkCount) * BytesPerGaussianSplat);
+		}
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write PLY file: %s"), *FilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FPlyWriter::WriteGaussianASCII(const FString& FilePath, int32 NumSplats, FGaussianRowGatherer GatherRow)
+	{
+		constexpr int32 MaxRowChars = NumGaussianProperties * (MaxAsciiFloatChars + 1);
+
+		return WriteAsciiPly(FilePath, GenerateGaussianHeader(NumSplats, false), NumSplats, MaxRowChars,
+			[&GatherRow](int32 RowIndex, ANSICHAR* Cursor)
 			{
-				TArray<FString> Parts;
-				Line.ParseIntoArray(Parts, TEXT(" "));
-				if (Parts.Num() >= 3)
+				float Row[NumGaussianProperties];
+				GatherRow(RowIndex, Row);
+
+				for (int32 i = 0; i < NumGaussianProperties; ++i)
 				{
-					OutProperties.Add(Parts.Last());
+					Cursor = AppendAsciiFloat(Cursor, Row[i]);
+					*Cursor++ = (i + 1 < NumGaussianProperties) ? ' ' : '\n';
 				}
-			}
-			else if (Line.StartsWith(TEXT("end_header")))
-			{
-				break;
-			}
+
+				return Cursor;
+			});
+	}
+
+	void FPlyWriter::GatherGaussianRow(const FGaussianSplat& Splat, float* OutRow)
+	{
+		int32 Index = 0;
+
+		// Position
+		OutRow[Index++] = Splat.Position.X;
+		OutRow[Index++] = Splat.Position.Y;
+		OutRow[Index++] = Splat.Position.Z;
+
+		// Normal
+		OutRow[Index++] = Splat.Normal.X;
+		OutRow[Index++] = Splat.Normal.Y;
+		OutRow[Index++] = Splat.Normal.Z;
+
+		// DC SH
+		OutRow[Index++] = Splat.SH_DC.X;
+		OutRow[Index++] = Splat.SH_DC.Y;
+		OutRow[Index++] = Splat.SH_DC.Z;
+
+		// Rest SH (45 floats)
+		for (int32 i = 0; i < FGaussianSplatBuffer::NumSHRest; ++i)
+		{
+			OutRow[Index++] = (i < Splat.SH_Rest.Num()) ? Splat.SH_Rest[i] : 0.0f;
 		}
 
-		return OutNumVertices > 0;
+		// Opacity
+		OutRow[Index++] = Splat.Opacity;
+
+		// Scale
+		OutRow[Index++] = Splat.Scale.X;
+		OutRow[Index++] = Splat.Scale.Y;
+		OutRow[Index++] = Splat.Scale.Z;
+
+		// Rotation XYZW
+		OutRow[Index++] = Splat.Rotation.X;
+		OutRow[Index++] = Splat.Rotation.Y;
+		OutRow[Index++] = Splat.Rotation.Z;
+		OutRow[Index++] = Splat.Rotation.W;
+
+		check(Index == NumGaussianProperties);
+	}
+
+	void FPlyWriter::GatherGaussianRow(const FGaussianSplatBuffer& Splats, int32 SplatIndex, float* OutRow)
+	{
+		// Position, normal, DC SH
+		FMemory::Memcpy(OutRow + 0, &Splats.Positions[SplatIndex], 3 * sizeof(float));
+		FMemory::Memcpy(OutRow + 3, &Splats.Normals[SplatIndex], 3 * sizeof(float));
+		FMemory::Memcpy(OutRow + 6, &Splats.SH_DC[SplatIndex], 3 * sizeof(float));
+
+		// Rest SH
+		FMemory::Memcpy(OutRow + 9, Splats.GetSHRest(SplatIndex), FGaussianSplatBuffer::NumSHRest * sizeof(float));
+
+		// Opacity, scale, rotation XYZW
+		OutRow[54] = Splats.Opacities[SplatIndex];
+		FMemory::Memcpy(OutRow + 55, &Splats.Scales[SplatIndex], 3 * sizeof(float));
+		FMemory::Memcpy(OutRow + 58, &Splats.Rotations[SplatIndex], 4 * sizeof(float));
+	}
+
+	void FPlyWriter::ScatterGaussianRow(FGaussianSplatBuffer& Splats, int32 SplatIndex, const float* Row)
+	{
+		// Inverse of GatherGaussianRow
+		FMemory::Memcpy(&Splats.Positions[SplatIndex], Row + 0, 3 * sizeof(float));
+		FMemory::Memcpy(&Splats.Normals[SplatIndex], Row + 3, 3 * sizeof(float));
+		FMemory::Memcpy(&Splats.SH_DC[SplatIndex], Row + 6, 3 * sizeof(float));
+		FMemory::Memcpy(Splats.GetSHRest(SplatIndex), Row + 9, FGaussianSplatBuffer::NumSHRest * sizeof(float));
+		Splats.Opacities[SplatIndex] = Row[54];
+		FMemory::Memcpy(&Splats.Scales[SplatIndex], Row + 55, 3 * sizeof(float));
+		FMemory::Memcpy(&Splats.Rotations[SplatIndex], Row + 58, 4 * sizeof(float));
 	}
 }
@@ -0,0 +1,324 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/PointCloudFilter.h"
+#include "FCM/PlyWriter.h"
+#include "FCM/SpatialSort.h"
+#include "FCM/PointKdTree.h"
+#include "Async/ParallelFor.h"
+
+namespace UE5_3DGS
+{
+	bool FPointCloudFilter::VoxelDownsample(
+		const TArray<FPointCloudPoint>& Points,
+		const FVoxelDownsampleConfig& Config,
+		TArray<FPointCloudPoint>& OutPoints,
+		float* OutVoxelSize)
+	{
+		OutPoints.Reset();
+
+		if (!(Config.VoxelSize > 0.0f) || Config.TargetPoints < 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Voxel downsampling needs a positive voxel size"));
+			return false;
+		}
+
+		// Finite points only; their source indices map voxel members back to Points
+		TArray<FVector3f> Positions;
+		TArray<int32> SourceIndices;
+		Positions.Reserve(Points.Num());
+		SourceIndices.Reserve(Points.Num());
+		for (int32 i = 0; i < Points.Num(); ++i)
+		{
+			const FVector3f Position(Points[i].Position);
+			if (FSpatialSort::IsFinitePosition(Position))
+			{
+				Positions.Add(Position);
+				SourceIndices.Add(i);
+			}
+		}
+
+		if (Positions.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No finite points to downsample"));
+			return false;
+		}
+
+		const FBox3f Bounds = FSpatialSort::ComputeBounds(Positions);
+		const float Extent = (Bounds.Max - Bounds.Min).GetMax();
+
+		// Keys hold MaxVoxelsPerAxis voxels per axis; smaller voxels would alias
+		const float MinVoxelSize = Extent / (MaxVoxelsPerAxis - 1);
+		float VoxelSize = Config.VoxelSize;
+		if (VoxelSize < MinVoxelSize)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Voxel size %g too small for the cloud extent, using %g"), VoxelSize, MinVoxelSize);
+			VoxelSize = MinVoxelSize;
+		}
+
+		TArray<uint64> Keys;
+		TArray<int32> Order;
+		ComputeVoxelKeys(Positions, Bounds.Min, VoxelSize, Keys, Order);
+
+		// Smallest voxel size within the budget: bisect between a size known to be over it and one voxel spanning the cloud
+		if (Config.TargetPoints > 0 && CountDistinct(Keys) > Config.TargetPoints)
+		{
+			float Low = VoxelSize;
+			float High = FMath::Max(Extent, VoxelSize) * 2.0f;
+
+			for (int32 Iteration = 0; Iteration < Config.MaxSearchIterations && High > Low * 1.001f; ++Iteration)
+			{
+				const float Mid = FMath::Sqrt(Low * High);
+				ComputeVoxelKeys(Positions, Bounds.Min, Mid, Keys, Order);
+				if (CountDistinct(Keys) > Config.TargetPoints)
+				{
+					Low = Mid;
+				}
+				else
+				{
+					High = Mid;
+				}
+			}
+
+			VoxelSize = High;
+			ComputeVoxelKeys(Positions, Bounds.Min, VoxelSize, Keys, Order);
+		}
+
+		// Start of each voxel's run in sorted order
+		TArray<int32> VoxelStarts;
+		for (int32 s = 0; s < Keys.Num(); ++s)
+		{
+			if (s == 0 || Keys[s] != Keys[s - 1])
+			{
+				VoxelStarts.Add(s);
+			}
+		}
+		const int32 NumVoxels = VoxelStarts.Num();
+		VoxelStarts.Add(Keys.Num());
+
+		OutPoints.SetNum(NumVoxels);
+		ParallelFor(NumVoxels, [&](int32 Voxel)
+		{
+			FVector3d PositionSum = FVector3d::ZeroVector;
+			FVector3d NormalSum = FVector3d::ZeroVector;
+			int64 ColorSum[4] = { 0, 0, 0, 0 };
+
+			const int32 First = VoxelStarts[Voxel];
+			const int32 Last = VoxelStarts[Voxel + 1];
+			for (int32 s = First; s < Last; ++s)
+			{
+				const FPointCloudPoint& Point = Points[SourceIndices[Order[s]]];
+				PositionSum += Point.Position;
+				NormalSum += Point.Normal;
+				ColorSum[0] += Point.Color.R;
+				ColorSum[1] += Point.Color.G;
+				ColorSum[2] += Point.Color.B;
+				ColorSum[3] += Point.Color.A;
+			}
+
+			const int32 Count = Last - First;
+			FPointCloudPoint& Out = OutPoints[Voxel];
+			Out.Position = PositionSum / Count;
+
+			// Opposing normals cancel out; such voxels keep the default normal
+			Out.Normal = NormalSum.GetSafeNormal(UE_DOUBLE_SMALL_NUMBER, FVector3d::UpVector);
+			Out.Color = FColor(
+				static_cast<uint8>((ColorSum[0] + Count / 2) / Count),
+				static_cast<uint8>((ColorSum[1] + Count / 2) / Count),
+				static_cast<uint8>((ColorSum[2] + Count / 2) / Count),
+				static_cast<uint8>((ColorSum[3] + Count / 2) / Count));
+		});
+
+		if (OutVoxelSize)
+		{
+			*OutVoxelSize = VoxelSize;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Voxel downsampled %d -> %d points (voxel size %g)"), Points.Num(), NumVoxels, VoxelSize);
+		return true;
+	}
+
+	void FOutlierRemovalStats::Log() const
+	{
+		UE_LOG(LogTemp, Log, TEXT("Outlier removal %d -> %d points: %d invalid, %d statistical, %d radius"),
+			NumInput, NumOutput, NumInvalid, NumStatistical, NumRadius);
+	}
+
+	bool FPointCloudFilter::RemoveOutliers(
+		const TArray<FPointCloudPoint>& Points,
+		const FOutlierRemovalConfig& Config,
+		TArray<FPointCloudPoint>& OutPoints,
+		FOutlierRemovalStats& OutStats)
+	{
+		OutStats = FOutlierRemovalStats();
+		OutPoints.Reset();
+
+		const int32 NumPoints = Points.Num();
+		OutStats.NumInput = NumPoints;
+
+		const bool bStatistical = Config.NumNeighbors > 0;
+		const bool bRadius = Config.Radius > 0.0f;
+
+		if (Config.NumNeighbors < 0 || Config.NumNeighbors > FPointKdTree::MaxNeighbors ||
+			(bRadius && (Config.MinRadiusNeighbors < 1 || Config.MinRadiusNeighbors > FPointKdTree::MaxNeighbors)) ||
+			(bStatistical && !(Config.StdDevMultiplier >= 0.0f)))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Invalid outlier removal settings (neighbour counts must be within 1 to %d)"), FPointKdTree::MaxNeighbors);
+			return false;
+		}
+
+		TArray<FVector3f> Positions;
+		Positions.SetNumUninitialized(NumPoints);
+		ParallelFor(NumPoints, [&](int32 i)
+		{
+			Positions[i] = FVector3f(Points[i].Position);
+		});
+
+		FPointKdTree Tree;
+		if (bStatistical || bRadius)
+		{
+			Tree.Build(Positions);
+		}
+
+		// One query per point serves both tests
+		const int32 K = FMath::Max(bStatistical ? Config.NumNeighbors : 0, bRadius ? Config.MinRadiusNeighbors : 0);
+		const float RadiusSquared = Config.Radius * Config.Radius;
+
+		TArray<EOutlierReason> Reasons;
+		TArray<float> MeanDistances;
+		Reasons.SetNumUninitialized(NumPoints);
+		MeanDistances.SetNumUninitialized(NumPoints);
+
+		constexpr int32 PointsPerBatch = 4096;
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumPoints, PointsPerBatch);
+
+		// Per-batch sums of the mean distance and its square, merged in order so the threshold is deterministic
+		TArray<FVector3d> BatchMoments;
+		BatchMoments.Init(FVector3d::ZeroVector, NumBatches);
+
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			int32 Neighbors[FPointKdTree::MaxNeighbors];
+			float DistancesSquared[FPointKdTree::MaxNeighbors];
+			FVector3d& Moments = BatchMoments[BatchIndex];
+
+			const int32 First = BatchIndex * PointsPerBatch;
+			const int32 Last = FMath::Min(First + PointsPerBatch, NumPoints);
+			for (int32 i = First; i < Last; ++i)
+			{
+				MeanDistances[i] = 0.0f;
+				if (!FSpatialSort::IsFinitePosition(Positions[i]))
+				{
+					Reasons[i] = EOutlierReason::Invalid;
+					continue;
+				}
+
+				Reasons[i] = EOutlierReason::Keep;
+				if (K == 0)
+				{
+					continue;
+				}
+
+				const int32 NumFound = Tree.FindNearest(Positions[i], K, Neighbors, DistancesSquared, i);
+
+				if (bRadius && (NumFound < Config.MinRadiusNeighbors || DistancesSquared[Config.MinRadiusNeighbors - 1] > RadiusSquared))
+				{
+					Reasons[i] = EOutlierReason::Radius;
+				}
+
+				if (bStatistical)
+				{
+					const int32 NumUsed = FMath::Min(NumFound, Config.NumNeighbors);
+					double Sum = 0.0;
+					for (int32 k = 0; k < NumUsed; ++k)
+					{
+						Sum += FMath::Sqrt(DistancesSquared[k]);
+					}
+
+					const double Mean = (NumUsed > 0) ? Sum / NumUsed : 0.0;
+					MeanDistances[i] = static_cast<float>(Mean);
+					Moments += FVector3d(Mean, Mean * Mean, 1.0);
+				}
+			}
+		});
+
+		if (bStatistical)
+		{
+			FVector3d Moments = FVector3d::ZeroVector;
+			for (const FVector3d& Batch : BatchMoments)
+			{
+				Moments += Batch;
+			}
+
+			const double Count = FMath::Max(Moments.Z, 1.0);
+			const double Mean = Moments.X / Count;
+			const double StdDev = FMath::Sqrt(FMath::Max(Moments.Y / Count - Mean * Mean, 0.0));
+			const double Threshold = Mean + Config.StdDevMultiplier * StdDev;
+
+			ParallelFor(NumPoints, [&](int32 i)
+			{
+				if (Reasons[i] != EOutlierReason::Invalid && MeanDistances[i] > Threshold)
+				{
+					Reasons[i] = EOutlierReason::Statistical;
+				}
+			});
+		}
+
+		OutPoints.Reserve(NumPoints);
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			switch (Reasons[i])
+			{
+			case EOutlierReason::Keep:
+				OutPoints.Add(Points[i]);
+				break;
+			case EOutlierReason::Invalid:
+				OutStats.NumInvalid++;
+				break;
+			case EOutlierReason::Statistical:
+				OutStats.NumStatistical++;
+				break;
+			case EOutlierReason::Radius:
+				OutStats.NumRadius++;
+				break;
+			}
+		}
+		OutStats.NumOutput = OutPoints.Num();
+
+		OutStats.Log();
+		return true;
+	}
+
+	void FPointCloudFilter::ComputeVoxelKeys(const TArray<FVector3f>& Positions, const FVector3f& Origin, float VoxelSize, TArray<uint64>& OutKeys, TArray<int32>& OutOrder)
+	{
+		const int32 NumPositions = Positions.Num();
+		const float InvVoxelSize = 1.0f / VoxelSize;
+		constexpr float MaxVoxel = static_cast<float>(MaxVoxelsPerAxis);
+
+		OutKeys.SetNumUninitialized(NumPositions);
+		ParallelFor(FMath::DivideAndRoundUp(NumPositions, FSpatialSort::BatchSize), [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * FSpatialSort::BatchSize;
+			const int32 Last = FMath::Min(First + FSpatialSort::BatchSize, NumPositions);
+			for (int32 i = First; i < Last; ++i)
+			{
+				const FVector3f Voxel = (Positions[i] - Origin) * InvVoxelSize;
+				OutKeys[i] = FSpatialSort::EncodeMorton(
+					static_cast<uint32>(FMath::Clamp(Voxel.X, 0.0f, MaxVoxel)),
+					static_cast<uint32>(FMath::Clamp(Voxel.Y, 0.0f, MaxVoxel)),
+					static_cast<uint32>(FMath::Clamp(Voxel.Z, 0.0f, MaxVoxel)));
+			}
+		});
+
+		FSpatialSort::RadixSort(OutKeys, OutOrder);
+	}
+
+	int32 FPointCloudFilter::CountDistinct(const TArray<uint64>& SortedKeys)
+	{
+		int32 Count = 0;
+		for (int32 i = 0; i < SortedKeys.Num(); ++i)
+		{
+			Count += (i == 0 || SortedKeys[i] != SortedKeys[i - 1]) ? 1 : 0;
+		}
+		return Count;
+	}
+}
@@ -0,0 +1,154 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/PointKdTree.h"
+#include "Async/ParallelFor.h"
+
+#include <algorithm>
+
+namespace UE5_3DGS
+{
+	void FPointKdTree::Build(const TArray<FVector3f>& Points)
+	{
+		Indices.Reset();
+		for (int32 i = 0; i < Points.Num(); ++i)
+		{
+			const FVector3f& P = Points[i];
+			if (FMath::IsFinite(P.X) && FMath::IsFinite(P.Y) && FMath::IsFinite(P.Z))
+			{
+				Indices.Add(i);
+			}
+		}
+
+		const int32 NumPoints = Indices.Num();
+		SplitAxes.SetNumZeroed(NumPoints);
+
+		// Level-synchronous build: every node of a level is split in parallel
+		TArray<FIntPoint> Level;
+		if (NumPoints > LeafSize)
+		{
+			Level.Add(FIntPoint(0, NumPoints));
+		}
+
+		TArray<FIntPoint> Children;
+		while (Level.Num() > 0)
+		{
+			Children.SetNumUninitialized(Level.Num() * 2);
+
+			ParallelFor(Level.Num(), [&](int32 NodeIndex)
+			{
+				const int32 Begin = Level[NodeIndex].X;
+				const int32 End = Level[NodeIndex].Y;
+
+				FBox3f Bounds(ForceInit);
+				for (int32 i = Begin; i < End; ++i)
+				{
+					Bounds += Points[Indices[i]];
+				}
+
+				const FVector3f Extent = Bounds.Max - Bounds.Min;
+				const uint8 Axis = (Extent.X >= Extent.Y && Extent.X >= Extent.Z) ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+				const int32 Mid = Begin + (End - Begin) / 2;
+
+				std::nth_element(Indices.GetData() + Begin, Indices.GetData() + Mid, Indices.GetData() + End,
+					[&Points, Axis](int32 A, int32 B)
+					{
+						return Points[A][Axis] < Points[B][Axis];
+					});
+
+				SplitAxes[Mid] = Axis;
+				Children[NodeIndex * 2] = FIntPoint(Begin, Mid);
+				Children[NodeIndex * 2 + 1] = FIntPoint(Mid + 1, End);
+			});
+
+			Level.Reset();
+			for (const FIntPoint& Child : Children)
+			{
+				if (Child.Y - Child.X > LeafSize)
+				{
+					Level.Add(Child);
+				}
+			}
+		}
+
+		TreePoints.SetNumUninitialized(NumPoints);
+		ParallelFor(NumPoints, [&](int32 i)
+		{
+			TreePoints[i] = Points[Indices[i]];
+		});
+	}
+
+	int32 FPointKdTree::FindNearest(const FVector3f& Query, int32 K, int32* OutIndices, float* OutDistancesSquared, int32 ExcludeIndex) const
+	{
+		check(K >= 0 && K <= MaxNeighbors);
+
+		if (K == 0 || Indices.Num() == 0 || !FMath::IsFinite(Query.X) || !FMath::IsFinite(Query.Y) || !FMath::IsFinite(Query.Z))
+		{
+			return 0;
+		}
+
+		FNearestList List;
+		List.K = K;
+		List.ExcludeIndex = ExcludeIndex;
+		List.OutIndices = OutIndices;
+		List.OutDistancesSquared = OutDistancesSquared;
+
+		SearchNearest(0, Indices.Num(), Query, List);
+		return List.Num;
+	}
+
+	void FPointKdTree::SearchNearest(int32 Begin, int32 End, const FVector3f& Query, FNearestList& List) const
+	{
+		if (End - Begin <= LeafSize)
+		{
+			for (int32 i = Begin; i < End; ++i)
+			{
+				List.Offer(Indices[i], FVector3f::DistSquared(TreePoints[i], Query));
+			}
+			return;
+		}
+
+		const int32 Mid = Begin + (End - Begin) / 2;
+		const float Delta = Query[SplitAxes[Mid]] - TreePoints[Mid][SplitAxes[Mid]];
+
+		List.Offer(Indices[Mid], FVector3f::DistSquared(TreePoints[Mid], Query));
+
+		// Near side first; the far side only if the splitting plane is closer than the current K-th neighbour
+		if (Delta < 0.0f)
+		{
+			SearchNearest(Begin, Mid, Query, List);
+			if (Delta * Delta < List.GetWorst())
+			{
+				SearchNearest(Mid + 1, End, Query, List);
+			}
+		}
+		else
+		{
+			SearchNearest(Mid + 1, End, Query, List);
+			if (Delta * Delta < List.GetWorst())
+			{
+				SearchNearest(Begin, Mid, Query, List);
+			}
+		}
+	}
+
+	void FPointKdTree::FNearestList::Offer(int32 Index, float DistanceSquared)
+	{
+		if (Index == ExcludeIndex || DistanceSquared >= GetWorst())
+		{
+			return;
+		}
+
+		// Insertion into the sorted list, dropping the current K-th neighbour when full
+		int32 Position = FMath::Min(Num, K - 1);
+		while (Position > 0 && DistanceSquared < OutDistancesSquared[Position - 1])
+		{
+			OutDistancesSquared[Position] = OutDistancesSquared[Position - 1];
+			OutIndices[Position] = OutIndices[Position - 1];
+			--Position;
+		}
+
+		OutDistancesSquared[Position] = DistanceSquared;
+		OutIndices[Position] = Index;
+		Num = FMath::Min(Num + 1, K);
+	}
+}
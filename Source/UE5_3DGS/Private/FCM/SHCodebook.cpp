@@ -0,0 +1,308 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SHCodebook.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/Crc.h"
+
+#include <atomic>
+
+namespace UE5_3DGS
+{
+	double FSHCodebook::GetSignalToNoiseDb() const
+	{
+		if (MeanSquaredError <= 0.0)
+		{
+			return TNumericLimits<double>::Max();
+		}
+		return 10.0 * FMath::LogX(10.0, SignalPower / MeanSquaredError);
+	}
+
+	bool FSHCodebook::Build(const FGaussianSplatBuffer& Splats, const FSHCodebookConfig& Config, FSHCodebook& OutCodebook)
+	{
+		OutCodebook = FSHCodebook();
+
+		const int32 NumSplats = Splats.Num();
+		if (NumSplats == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No splats to build an SH codebook from"));
+			return false;
+		}
+
+		if (Config.NumEntries < 1 || Config.NumEntries > MaxEntries)
+		{
+			UE_LOG(LogTemp, Error, TEXT("SH codebook size must be 1-%d (got %d)"), MaxEntries, Config.NumEntries);
+			return false;
+		}
+
+		FRandomStream Random(Config.Seed);
+
+		// Training set: a random subset of splats, copied contiguously
+		TArray<int32> SampleOrder;
+		SampleOrder.SetNumUninitialized(NumSplats);
+		for (int32 i = 0; i < NumSplats; ++i)
+		{
+			SampleOrder[i] = i;
+		}
+
+		const int32 NumSamples = (Config.MaxTrainingSamples > 0) ? FMath::Min(NumSplats, Config.MaxTrainingSamples) : NumSplats;
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			SampleOrder.Swap(i, Random.RandRange(i, NumSplats - 1));
+		}
+
+		TArray64<float> Training;
+		Training.SetNumUninitialized(static_cast<int64>(NumSamples) * Dimension);
+		ParallelFor(NumSamples, [&](int32 i)
+		{
+			FMemory::Memcpy(Training.GetData() + static_cast<int64>(i) * Dimension, Splats.GetSHRest(SampleOrder[i]), Dimension * sizeof(float));
+		});
+
+		// Initialize entries from training samples with distinct vectors (the shuffle above is already random);
+		// duplicate seeds would leave entries that can never win a sample
+		TArray<float>& Entries = OutCodebook.Entries;
+		{
+			const int32 MaxSeeds = FMath::Min(Config.NumEntries, NumSamples);
+			TMultiMap<uint32, int32> SeedsByHash;
+			Entries.Reserve(static_cast<int64>(MaxSeeds) * Dimension);
+
+			for (int32 Sample = 0; Sample < NumSamples && Entries.Num() < static_cast<int64>(MaxSeeds) * Dimension; ++Sample)
+			{
+				const float* Vector = Training.GetData() + static_cast<int64>(Sample) * Dimension;
+				const uint32 Hash = FCrc::MemCrc32(Vector, Dimension * sizeof(float));
+
+				bool bDuplicate = false;
+				for (auto It = SeedsByHash.CreateConstKeyIterator(Hash); It && !bDuplicate; ++It)
+				{
+					bDuplicate = FMemory::Memcmp(Vector, Entries.GetData() + static_cast<int64>(It.Value()) * Dimension, Dimension * sizeof(float)) == 0;
+				}
+
+				if (!bDuplicate)
+				{
+					SeedsByHash.Add(Hash, Entries.Num() / Dimension);
+					Entries.Append(Vector, Dimension);
+				}
+			}
+		}
+
+		// Fewer distinct vectors than requested entries: the extra entries would stay empty
+		const int32 NumEntries = Entries.Num() / Dimension;
+
+		TArray<int32> Assignments;
+		TArray<float> SquaredErrors;
+		TArray<int32> MemberOffsets;
+		TArray<int32> Members;
+		double PreviousError = TNumericLimits<double>::Max();
+
+		for (int32 Iteration = 0; Iteration < Config.MaxIterations; ++Iteration)
+		{
+			AssignNearest(Entries, Training.GetData(), NumSamples, Assignments, SquaredErrors);
+
+			double TotalError = 0.0;
+			for (float Error : SquaredErrors)
+			{
+				TotalError += Error;
+			}
+
+			// Group samples by entry (counting sort) so each entry's mean is computed by one task
+			MemberOffsets.SetNumZeroed(NumEntries + 1);
+			for (int32 Entry : Assignments)
+			{
+				++MemberOffsets[Entry + 1];
+			}
+			for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+			{
+				MemberOffsets[Entry + 1] += MemberOffsets[Entry];
+			}
+
+			Members.SetNumUninitialized(NumSamples);
+			{
+				TArray<int32> Cursor(MemberOffsets.GetData(), NumEntries);
+				for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+				{
+					Members[Cursor[Assignments[Sample]]++] = Sample;
+				}
+			}
+
+			std::atomic<bool> bReseeded(false);
+			ParallelFor(NumEntries, [&](int32 Entry)
+			{
+				float* Centroid = Entries.GetData() + static_cast<int64>(Entry) * Dimension;
+				const int32 First = MemberOffsets[Entry];
+				const int32 Last = MemberOffsets[Entry + 1];
+
+				if (First == Last)
+				{
+					// Empty entry: reseed from a random sample so it can capture a new cluster
+					const int32 Sample = FRandomStream(Config.Seed + Iteration * NumEntries + Entry).RandHelper(NumSamples);
+					FMemory::Memcpy(Centroid, Training.GetData() + static_cast<int64>(Sample) * Dimension, Dimension * sizeof(float));
+					bReseeded = true;
+					return;
+				}
+
+				double Sum[Dimension] = {};
+				for (int32 m = First; m < Last; ++m)
+				{
+					const float* Vector = Training.GetData() + static_cast<int64>(Members[m]) * Dimension;
+					for (int32 d = 0; d < Dimension; ++d)
+					{
+						Sum[d] += Vector[d];
+					}
+				}
+
+				const double InvCount = 1.0 / (Last - First);
+				for (int32 d = 0; d < Dimension; ++d)
+				{
+					Centroid[d] = static_cast<float>(Sum[d] * InvCount);
+				}
+			});
+
+			// TotalError predates a reseed, so it says nothing about the moved entries; keep iterating
+			if (!bReseeded && PreviousError - TotalError <= Config.ConvergenceThreshold * PreviousError)
+			{
+				break;
+			}
+			PreviousError = TotalError;
+		}
+
+		// Final assignment of every splat
+		AssignNearest(Entries, Splats.SH_Rest.GetData(), NumSplats, Assignments, SquaredErrors);
+
+		OutCodebook.Indices.SetNumUninitialized(NumSplats);
+		double TotalError = 0.0;
+		double TotalPower = 0.0;
+		float MaxSquaredError = 0.0f;
+
+		for (int32 i = 0; i < NumSplats; ++i)
+		{
+			OutCodebook.Indices[i] = static_cast<uint16>(Assignments[i]);
+			TotalError += SquaredErrors[i];
+			MaxSquaredError = FMath::Max(MaxSquaredError, SquaredErrors[i]);
+		}
+
+		for (float Value : Splats.SH_Rest)
+		{
+			TotalPower += static_cast<double>(Value) * Value;
+		}
+
+		const double NumValues = static_cast<double>(NumSplats) * Dimension;
+		OutCodebook.MeanSquaredError = TotalError / NumValues;
+		OutCodebook.SignalPower = TotalPower / NumValues;
+		OutCodebook.MaxError = FMath::Sqrt(MaxSquaredError);
+
+		UE_LOG(LogTemp, Log, TEXT("Built SH codebook: %d entries for %d splats, RMSE %.5f, max error %.4f, SNR %.1f dB"),
+			NumEntries, NumSplats, FMath::Sqrt(OutCodebook.MeanSquaredError), OutCodebook.MaxError, OutCodebook.GetSignalToNoiseDb());
+
+		return true;
+	}
+
+	void FSHCodebook::Apply(FGaussianSplatBuffer& Splats) const
+	{
+		check(Indices.Num() == Splats.Num());
+
+		ParallelFor(Splats.Num(), [this, &Splats](int32 i)
+		{
+			FMemory::Memcpy(Splats.GetSHRest(i), GetEntry(Indices[i]), Dimension * sizeof(float));
+		});
+	}
+
+	void FSHCodebook::AssignNearest(
+		const TArray<float>& Entries,
+		const float* Vectors,
+		int32 NumVectors,
+		TArray<int32>& OutAssignments,
+		TArray<float>& OutSquaredErrors)
+	{
+		const int32 NumEntries = Entries.Num() / Dimension;
+
+		auto Norm = [](const float* Vector)
+		{
+			float SumSquares = 0.0f;
+			for (int32 d = 0; d < Dimension; ++d)
+			{
+				SumSquares += Vector[d] * Vector[d];
+			}
+			return FMath::Sqrt(SumSquares);
+		};
+
+		// Entries sorted by norm: |a - b| >= ||a| - |b||, so the search can stop once the norm gap exceeds the best distance
+		TArray<int32> Order;
+		TArray<float> SortedNorms;
+		{
+			TArray<float> Norms;
+			Norms.SetNumUninitialized(NumEntries);
+			Order.SetNumUninitialized(NumEntries);
+			for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+			{
+				Norms[Entry] = Norm(Entries.GetData() + static_cast<int64>(Entry) * Dimension);
+				Order[Entry] = Entry;
+			}
+
+			Order.Sort([&Norms](int32 A, int32 B) { return Norms[A] < Norms[B]; });
+
+			SortedNorms.SetNumUninitialized(NumEntries);
+			for (int32 i = 0; i < NumEntries; ++i)
+			{
+				SortedNorms[i] = Norms[Order[i]];
+			}
+		}
+
+		OutAssignments.SetNumUninitialized(NumVectors);
+		OutSquaredErrors.SetNumUninitialized(NumVectors);
+
+		constexpr int32 VectorsPerBatch = 256;
+		ParallelFor(FMath::DivideAndRoundUp(NumVectors, VectorsPerBatch), [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * VectorsPerBatch;
+			const int32 Last = FMath::Min(First + VectorsPerBatch, NumVectors);
+
+			for (int32 v = First; v < Last; ++v)
+			{
+				const float* Vector = Vectors + static_cast<int64>(v) * Dimension;
+				const float VectorNorm = Norm(Vector);
+
+				int32 Above = Algo::LowerBound(SortedNorms, VectorNorm);
+				int32 Below = Above - 1;
+				float BestDistance = TNumericLimits<float>::Max();
+				int32 BestEntry = 0;
+
+				while (Below >= 0 || Above < NumEntries)
+				{
+					// Visit the closer side in norm first
+					const float GapBelow = Below >= 0 ? VectorNorm - SortedNorms[Below] : TNumericLimits<float>::Max();
+					const float GapAbove = Above < NumEntries ? SortedNorms[Above] - VectorNorm : TNumericLimits<float>::Max();
+					const bool bTakeBelow = GapBelow < GapAbove;
+					const float Gap = bTakeBelow ? GapBelow : GapAbove;
+
+					if (Gap * Gap >= BestDistance)
+					{
+						break;
+					}
+
+					const int32 Entry = Order[bTakeBelow ? Below-- : Above++];
+					const float* Candidate = Entries.GetData() + static_cast<int64>(Entry) * Dimension;
+
+					// Partial distance: abandon the candidate once it cannot win
+					float Distance = 0.0f;
+					for (int32 d = 0; d < Dimension && Distance < BestDistance; d += 9)
+					{
+						for (int32 k = d; k < d + 9; ++k)
+						{
+							const float Delta = Vector[k] - Candidate[k];
+							Distance += Delta * Delta;
+						}
+					}
+
+					if (Distance < BestDistance)
+					{
+						BestDistance = Distance;
+						BestEntry = Entry;
+					}
+				}
+
+				OutAssignments[v] = BestEntry;
+				OutSquaredErrors[v] = BestDistance;
+			}
+		});
+	}
+}
@@ -0,0 +1,168 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SHDegreeReduction.h"
+#include "Async/ParallelFor.h"
+
+namespace UE5_3DGS
+{
+	int64 FSHDegreeReduction::GetSHRestBytes() const
+	{
+		int64 Bytes = 0;
+		for (int32 Degree = 0; Degree <= MaxDegree; ++Degree)
+		{
+			Bytes += static_cast<int64>(NumPerDegree[Degree]) * 3 * GetCoeffsPerChannel(Degree) * sizeof(float);
+		}
+		return Bytes;
+	}
+
+	bool FSHDegreeReduction::Build(const FGaussianSplatBuffer& Splats, const FSHDegreeConfig& Config, FSHDegreeReduction& OutReduction)
+	{
+		OutReduction = FSHDegreeReduction();
+
+		const int32 NumSplats = Splats.Num();
+		if (NumSplats == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No splats to select SH degrees for"));
+			return false;
+		}
+
+		if (Config.MaxColorError < 0.0f || Config.MaxDegree < 0 || Config.MaxDegree > MaxDegree)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Invalid SH degree settings (error %f, degree %d)"), Config.MaxColorError, Config.MaxDegree);
+			return false;
+		}
+
+		OutReduction.Degrees.SetNumUninitialized(NumSplats);
+
+		// Per-batch counts and maxima, merged afterwards
+		constexpr int32 SplatsPerBatch = 4096;
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumSplats, SplatsPerBatch);
+
+		struct FBatchResult
+		{
+			int32 NumPerDegree[MaxDegree + 1] = {};
+			float MaxError = 0.0f;
+		};
+		TArray<FBatchResult> BatchResults;
+		BatchResults.SetNum(NumBatches);
+
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * SplatsPerBatch;
+			const int32 Last = FMath::Min(First + SplatsPerBatch, NumSplats);
+			FBatchResult& Result = BatchResults[BatchIndex];
+
+			float Errors[MaxDegree + 1];
+			for (int32 i = First; i < Last; ++i)
+			{
+				ComputeTruncationErrors(Splats.GetSHRest(i), Errors);
+
+				const float Weight = Config.bWeightByOpacity ? FMath::Clamp(Splats.Opacities[i], 0.0f, 1.0f) : 1.0f;
+
+				// Errors shrink with degree, so the first degree within the threshold is the lowest
+				int32 Degree = Config.MaxDegree;
+				for (int32 d = 0; d < Config.MaxDegree; ++d)
+				{
+					if (Errors[d] * Weight <= Config.MaxColorError)
+					{
+						Degree = d;
+						break;
+					}
+				}
+
+				OutReduction.Degrees[i] = static_cast<uint8>(Degree);
+				Result.NumPerDegree[Degree]++;
+				Result.MaxError = FMath::Max(Result.MaxError, Errors[Degree] * Weight);
+			}
+		});
+
+		for (const FBatchResult& Result : BatchResults)
+		{
+			for (int32 Degree = 0; Degree <= MaxDegree; ++Degree)
+			{
+				OutReduction.NumPerDegree[Degree] += Result.NumPerDegree[Degree];
+			}
+			OutReduction.MaxError = FMath::Max(OutReduction.MaxError, Result.MaxError);
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("SH degrees: %d / %d / %d / %d splats at degree 0 / 1 / 2 / 3, max error %f"),
+			OutReduction.NumPerDegree[0], OutReduction.NumPerDegree[1], OutReduction.NumPerDegree[2], OutReduction.NumPerDegree[3],
+			OutReduction.MaxError);
+
+		return true;
+	}
+
+	void FSHDegreeReduction::Apply(FGaussianSplatBuffer& Splats) const
+	{
+		check(Degrees.Num() == Splats.Num());
+
+		constexpr int32 CoeffsPerChannel = FGaussianSplatBuffer::NumSHRest / 3;
+
+		ParallelFor(Splats.Num(), [&](int32 i)
+		{
+			const int32 Kept = GetCoeffsPerChannel(Degrees[i]);
+			float* Rest = Splats.GetSHRest(i);
+			for (int32 Channel = 0; Channel < 3; ++Channel)
+			{
+				for (int32 Coeff = Kept; Coeff < CoeffsPerChannel; ++Coeff)
+				{
+					Rest[Channel * CoeffsPerChannel + Coeff] = 0.0f;
+				}
+			}
+		});
+	}
+
+	void FSHDegreeReduction::GetBucketOrder(TArray<int32>& OutOrder) const
+	{
+		// Counting sort on degree keeps source (e.g. spatial) order within each bucket
+		int32 BucketStart[MaxDegree + 1];
+		int32 Offset = 0;
+		for (int32 Degree = 0; Degree <= MaxDegree; ++Degree)
+		{
+			BucketStart[Degree] = Offset;
+			Offset += NumPerDegree[Degree];
+		}
+
+		OutOrder.SetNumUninitialized(Degrees.Num());
+		for (int32 i = 0; i < Degrees.Num(); ++i)
+		{
+			OutOrder[BucketStart[Degrees[i]]++] = i;
+		}
+	}
+
+	void FSHDegreeReduction::ComputeTruncationErrors(const float* Rest, float OutErrors[MaxDegree + 1])
+	{
+		constexpr int32 CoeffsPerChannel = FGaussianSplatBuffer::NumSHRest / 3;
+
+		// Energy of each band (degrees 1..3) per channel
+		float BandEnergy[MaxDegree + 1][3] = {};
+		for (int32 Channel = 0; Channel < 3; ++Channel)
+		{
+			const float* ChannelRest = Rest + Channel * CoeffsPerChannel;
+			for (int32 Degree = 1; Degree <= MaxDegree; ++Degree)
+			{
+				for (int32 Coeff = GetCoeffsPerChannel(Degree - 1); Coeff < GetCoeffsPerChannel(Degree); ++Coeff)
+				{
+					BandEnergy[Degree][Channel] += ChannelRest[Coeff] * ChannelRest[Coeff];
+				}
+			}
+		}
+
+		// Error of keeping degree d: the energy of all higher bands, worst channel
+		const float InvSphereArea = 1.0f / (4.0f * PI);
+		float Dropped[3] = {};
+		OutErrors[MaxDegree] = 0.0f;
+		for (int32 Degree = MaxDegree - 1; Degree >= 0; --Degree)
+		{
+			float Worst = 0.0f;
+			for (int32 Channel = 0; Channel < 3; ++Channel)
+			{
+				Dropped[Channel] += BandEnergy[Degree + 1][Channel];
+				Worst = FMath::Max(Worst, Dropped[Channel]);
+			}
+			// Non-finite coefficients never pass the threshold
+			const bool bFinite = FMath::IsFinite(Dropped[0] + Dropped[1] + Dropped[2]);
+			OutErrors[Degree] = bFinite ? FMath::Sqrt(Worst * InvSphereArea) : TNumericLimits<float>::Max();
+		}
+	}
+}
@@ -0,0 +1,297 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SpatialSort.h"
+#include "Async/ParallelFor.h"
+
+namespace UE5_3DGS
+{
+	void FSpatialSort::ComputeOrder(const TArray<FVector3f>& Positions, ESpatialCurve Curve, TArray<int32>& OutOrder)
+	{
+		if (Curve == ESpatialCurve::None)
+		{
+			OutOrder.SetNumUninitialized(Positions.Num());
+			for (int32 i = 0; i < Positions.Num(); ++i)
+			{
+				OutOrder[i] = i;
+			}
+			return;
+		}
+
+		TArray<uint64> Keys;
+		ComputeKeys(Positions, Curve, Keys);
+		RadixSort(Keys, OutOrder);
+	}
+
+	void FSpatialSort::ComputeKeys(const TArray<FVector3f>& Positions, ESpatialCurve Curve, TArray<uint64>& OutKeys)
+	{
+		ComputeKeys(Positions, Curve, (Curve == ESpatialCurve::None) ? FBox3f(ForceInit) : ComputeBounds(Positions), OutKeys);
+	}
+
+	FBox3f FSpatialSort::ComputeBounds(const TArray<FVector3f>& Positions)
+	{
+		const int32 NumPositions = Positions.Num();
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumPositions, BatchSize);
+
+		// Bounds of the finite positions, reduced per batch
+		TArray<FBox3f> BatchBounds;
+		BatchBounds.Init(FBox3f(ForceInit), NumBatches);
+
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * BatchSize;
+			const int32 Last = FMath::Min(First + BatchSize, NumPositions);
+			FBox3f& Bounds = BatchBounds[BatchIndex];
+
+			for (int32 i = First; i < Last; ++i)
+			{
+				if (IsFinitePosition(Positions[i]))
+				{
+					Bounds += Positions[i];
+				}
+			}
+		});
+
+		FBox3f Bounds(ForceInit);
+		for (const FBox3f& Box : BatchBounds)
+		{
+			Bounds += Box;
+		}
+		return Bounds;
+	}
+
+	void FSpatialSort::ComputeKeys(const TArray<FVector3f>& Positions, ESpatialCurve Curve, const FBox3f& Bounds, TArray<uint64>& OutKeys)
+	{
+		const int32 NumPositions = Positions.Num();
+		OutKeys.SetNumUninitialized(NumPositions);
+
+		if (NumPositions == 0)
+		{
+			return;
+		}
+
+		if (Curve == ESpatialCurve::None)
+		{
+			FMemory::Memzero(OutKeys.GetData(), NumPositions * sizeof(uint64));
+			return;
+		}
+
+		// One scale for all axes keeps curve cells cubic
+		const float MaxCell = static_cast<float>((1u << BitsPerAxis) - 1);
+		const float Extent = Bounds.IsValid ? (Bounds.Max - Bounds.Min).GetMax() : 0.0f;
+		const float Scale = (Extent > 0.0f) ? MaxCell / Extent : 0.0f;
+		const FVector3f Origin = Bounds.Min;
+		const bool bHilbert = (Curve == ESpatialCurve::Hilbert);
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumPositions, BatchSize);
+
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * BatchSize;
+			const int32 Last = FMath::Min(First + BatchSize, NumPositions);
+
+			for (int32 i = First; i < Last; ++i)
+			{
+				const FVector3f& P = Positions[i];
+				if (!IsFinitePosition(P))
+				{
+					OutKeys[i] = MAX_uint64;
+					continue;
+				}
+
+				const FVector3f Cell = (P - Origin) * Scale;
+				const uint32 X = static_cast<uint32>(FMath::Clamp(Cell.X, 0.0f, MaxCell));
+				const uint32 Y = static_cast<uint32>(FMath::Clamp(Cell.Y, 0.0f, MaxCell));
+				const uint32 Z = static_cast<uint32>(FMath::Clamp(Cell.Z, 0.0f, MaxCell));
+
+				OutKeys[i] = bHilbert ? EncodeHilbert(X, Y, Z) : EncodeMorton(X, Y, Z);
+			}
+		});
+	}
+
+	void FSpatialSort::RadixSort(TArray<uint64>& Keys, TArray<int32>& OutOrder)
+	{
+		const int32 NumKeys = Keys.Num();
+		OutOrder.SetNumUninitialized(NumKeys);
+		for (int32 i = 0; i < NumKeys; ++i)
+		{
+			OutOrder[i] = i;
+		}
+
+		if (NumKeys <= 1)
+		{
+			return;
+		}
+
+		constexpr int32 RadixBits = 8;
+		constexpr int32 NumBuckets = 1 << RadixBits;
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumKeys, BatchSize);
+
+		// Digits that are equal in every key need no pass
+		TArray<uint64> BatchOr;
+		TArray<uint64> BatchAnd;
+		BatchOr.Init(0, NumBatches);
+		BatchAnd.Init(MAX_uint64, NumBatches);
+
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * BatchSize;
+			const int32 Last = FMath::Min(First + BatchSize, NumKeys);
+			for (int32 i = First; i < Last; ++i)
+			{
+				BatchOr[BatchIndex] |= Keys[i];
+				BatchAnd[BatchIndex] &= Keys[i];
+			}
+		});
+
+		uint64 AllOr = 0;
+		uint64 AllAnd = MAX_uint64;
+		for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
+		{
+			AllOr |= BatchOr[BatchIndex];
+			AllAnd &= BatchAnd[BatchIndex];
+		}
+		const uint64 VaryingBits = AllOr ^ AllAnd;
+
+		TArray<uint64> TempKeys;
+		TArray<int32> TempOrder;
+		TempKeys.SetNumUninitialized(NumKeys);
+		TempOrder.SetNumUninitialized(NumKeys);
+
+		// Per-batch bucket counts, turned into per-batch scatter offsets
+		TArray<int32> Offsets;
+		Offsets.SetNumUninitialized(NumBatches * NumBuckets);
+
+		for (int32 Shift = 0; Shift < 64; Shift += RadixBits)
+		{
+			if (((VaryingBits >> Shift) & (NumBuckets - 1)) == 0)
+			{
+				continue;
+			}
+
+			ParallelFor(NumBatches, [&](int32 BatchIndex)
+			{
+				const int32 First = BatchIndex * BatchSize;
+				const int32 Last = FMath::Min(First + BatchSize, NumKeys);
+				int32* Counts = Offsets.GetData() + BatchIndex * NumBuckets;
+
+				FMemory::Memzero(Counts, NumBuckets * sizeof(int32));
+				for (int32 i = First; i < Last; ++i)
+				{
+					++Counts[(Keys[i] >> Shift) & (NumBuckets - 1)];
+				}
+			});
+
+			// Bucket-major prefix sum: batch b writes bucket d after batches 0..b-1, which keeps the sort stable
+			int32 Offset = 0;
+			for (int32 Digit = 0; Digit < NumBuckets; ++Digit)
+			{
+				for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
+				{
+					int32& Count = Offsets[BatchIndex * NumBuckets + Digit];
+					const int32 BucketCount = Count;
+					Count = Offset;
+					Offset += BucketCount;
+				}
+			}
+
+			ParallelFor(NumBatches, [&](int32 BatchIndex)
+			{
+				const int32 First = BatchIndex * BatchSize;
+				const int32 Last = FMath::Min(First + BatchSize, NumKeys);
+				int32* Cursor = Offsets.GetData() + BatchIndex * NumBuckets;
+
+				for (int32 i = First; i < Last; ++i)
+				{
+					const int32 Destination = Cursor[(Keys[i] >> Shift) & (NumBuckets - 1)]++;
+					TempKeys[Destination] = Keys[i];
+					TempOrder[Destination] = OutOrder[i];
+				}
+			});
+
+			Swap(Keys, TempKeys);
+			Swap(OutOrder, TempOrder);
+		}
+	}
+
+	void FSpatialSort::Reorder(const FGaussianSplatBuffer& Splats, const TArray<int32>& Order, FGaussianSplatBuffer& OutSplats)
+	{
+		check(Order.Num() == Splats.Num());
+		check(&Splats != &OutSplats);
+
+		const int32 NumSplats = Order.Num();
+		OutSplats.SetNumUninitialized(NumSplats);
+
+		ParallelFor(NumSplats, [&](int32 i)
+		{
+			const int32 Source = Order[i];
+			OutSplats.Positions[i] = Splats.Positions[Source];
+			OutSplats.Normals[i] = Splats.Normals[Source];
+			OutSplats.SH_DC[i] = Splats.SH_DC[Source];
+			FMemory::Memcpy(OutSplats.GetSHRest(i), Splats.GetSHRest(Source), FGaussianSplatBuffer::NumSHRest * sizeof(float));
+			OutSplats.Opacities[i] = Splats.Opacities[Source];
+			OutSplats.Scales[i] = Splats.Scales[Source];
+			OutSplats.Rotations[i] = Splats.Rotations[Source];
+		});
+	}
+
+	uint64 FSpatialSort::SpreadBits(uint32 Value)
+	{
+		uint64 Bits = Value & 0x1fffff;
+		Bits = (Bits | (Bits << 32)) & 0x001f00000000ffffull;
+		Bits = (Bits | (Bits << 16)) & 0x001f0000ff0000ffull;
+		Bits = (Bits | (Bits << 8)) & 0x100f00f00f00f00full;
+		Bits = (Bits | (Bits << 4)) & 0x10c30c30c30c30c3ull;
+		Bits = (Bits | (Bits << 2)) & 0x1249249249249249ull;
+		return Bits;
+	}
+
+	uint64 FSpatialSort::EncodeMorton(uint32 X, uint32 Y, uint32 Z)
+	{
+		return (SpreadBits(X) << 2) | (SpreadBits(Y) << 1) | SpreadBits(Z);
+	}
+
+	uint64 FSpatialSort::EncodeHilbert(uint32 X, uint32 Y, uint32 Z)
+	{
+		// Skilling's transform ("Programming the Hilbert curve", 2004): converts the
+		// coordinates in place so that interleaving their bits yields the Hilbert index
+		uint32 Axes[3] = { X, Y, Z };
+		const uint32 HighBit = 1u << (BitsPerAxis - 1);
+
+		// Inverse undo excess work
+		for (uint32 Q = HighBit; Q > 1; Q >>= 1)
+		{
+			const uint32 P = Q - 1;
+			for (int32 i = 0; i < 3; ++i)
+			{
+				if (Axes[i] & Q)
+				{
+					Axes[0] ^= P;
+				}
+				else
+				{
+					const uint32 T = (Axes[0] ^ Axes[i]) & P;
+					Axes[0] ^= T;
+					Axes[i] ^= T;
+				}
+			}
+		}
+
+		// Gray encode
+		Axes[1] ^= Axes[0];
+		Axes[2] ^= Axes[1];
+
+		uint32 T = 0;
+		for (uint32 Q = HighBit; Q > 1; Q >>= 1)
+		{
+			if (Axes[2] & Q)
+			{
+				T ^= Q - 1;
+			}
+		}
+
+		Axes[0] ^= T;
+		Axes[1] ^= T;
+		Axes[2] ^= T;
+
+		return EncodeMorton(Axes[0], Axes[1], Axes[2]);
+	}
+}
@@ -0,0 +1,518 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SplatChunkFile.h"
+#include "FCM/PlyWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+#include <atomic>
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace UE5_3DGS
+{
+	// FSplatChunkWriter
+
+	bool FSplatChunkWriter::WriteChunkFile(
+		const FString& FilePath,
+		const FGaussianSplatBuffer& Splats,
+		const FSplatChunkConfig& Config,
+		TArray<int32>* OutPermutation)
+	{
+		static_assert(sizeof(FFileHeader) == 24, "Chunk file header must be 24 bytes");
+		static_assert(sizeof(FChunkRecord) == 48, "Chunk record must be 48 bytes");
+		static_assert(sizeof(FFileTail) == 16, "Chunk file tail must be 16 bytes");
+
+		if (Splats.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Empty splat buffer, nothing to write"));
+			return false;
+		}
+
+		if (Config.SplatsPerChunk < 1)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Splats per chunk must be positive (got %d)"), Config.SplatsPerChunk);
+			return false;
+		}
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open chunk file for writing: %s"), *FilePath);
+			return false;
+		}
+
+		TArray<int32> Order;
+		FSpatialSort::ComputeOrder(Splats.Positions, Config.SpatialOrder, Order);
+
+		const int32 NumSplats = Splats.Num();
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumSplats, Config.SplatsPerChunk);
+
+		FFileHeader Header;
+		Header.Magic = FileMagic;
+		Header.Version = FileVersion;
+		Header.SplatsPerChunk = Config.SplatsPerChunk;
+		Header.BytesPerSplat = FPlyWriter::BytesPerGaussianSplat;
+		Header.NumSplats = NumSplats;
+		Writer->Serialize(&Header, sizeof(Header));
+
+		TArray<FChunkRecord> Records;
+		Records.SetNumZeroed(NumChunks);
+
+		// A bounded wave of chunks is encoded in parallel, then written in order
+		const int32 ChunksPerWave = FMath::Max(1, 2 * (FTaskGraphInterface::Get().GetNumWorkerThreads() + 1));
+		TArray<TArray<uint8>> WaveBuffers;
+		WaveBuffers.SetNum(FMath::Min(ChunksPerWave, NumChunks));
+
+		uint64 Offset = sizeof(FFileHeader);
+
+		for (int32 WaveStart = 0; WaveStart < NumChunks && !Writer->IsError(); WaveStart += ChunksPerWave)
+		{
+			const int32 WaveCount = FMath::Min(ChunksPerWave, NumChunks - WaveStart);
+
+			ParallelFor(WaveCount, [&](int32 WaveIndex)
+			{
+				const int32 ChunkIndex = WaveStart + WaveIndex;
+				const int32 First = ChunkIndex * Config.SplatsPerChunk;
+				const int32 Count = FMath::Min(Config.SplatsPerChunk, NumSplats - First);
+				const int64 RawBytes = static_cast<int64>(Count) * FPlyWriter::BytesPerGaussianSplat;
+
+				TArray<float> Rows;
+				Rows.SetNumUninitialized(Count * FPlyWriter::NumGaussianProperties);
+
+				FBox3f Bounds(ForceInit);
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const int32 Source = Order[First + i];
+					FPlyWriter::GatherGaussianRow(Splats, Source, Rows.GetData() + static_cast<int64>(i) * FPlyWriter::NumGaussianProperties);
+
+					// 3-sigma extent along the largest axis
+					const FVector3f& Position = Splats.Positions[Source];
+					if (FMath::IsFinite(Position.X) && FMath::IsFinite(Position.Y) && FMath::IsFinite(Position.Z))
+					{
+						const float Radius = 3.0f * FMath::Exp(FMath::Min(Splats.Scales[Source].GetMax(), 20.0f));
+						Bounds += FBox3f(Position - FVector3f(Radius), Position + FVector3f(Radius));
+					}
+				}
+
+				FChunkRecord& Record = Records[ChunkIndex];
+				if (Bounds.IsValid)
+				{
+					FMemory::Memcpy(Record.BoundsMin, &Bounds.Min, sizeof(Record.BoundsMin));
+					FMemory::Memcpy(Record.BoundsMax, &Bounds.Max, sizeof(Record.BoundsMax));
+				}
+				else
+				{
+					// No finite splat: an inverted box never intersects a region
+					for (int32 Axis = 0; Axis < 3; ++Axis)
+					{
+						Record.BoundsMin[Axis] = TNumericLimits<float>::Max();
+						Record.BoundsMax[Axis] = TNumericLimits<float>::Lowest();
+					}
+				}
+				Record.NumSplats = Count;
+
+				TArray<uint8>& Stored = WaveBuffers[WaveIndex];
+				const uint8* RawData = reinterpret_cast<const uint8*>(Rows.GetData());
+				bool bDeflated = false;
+
+				if (Config.bCompress)
+				{
+					TArray<uint8> Shuffled;
+					Shuffled.SetNumUninitialized(RawBytes);
+					ShuffleBytes(RawData, RawBytes / 4, Shuffled.GetData());
+
+					uLongf CompressedBytes = compressBound(static_cast<uLong>(RawBytes));
+					Stored.SetNumUninitialized(CompressedBytes);
+					if (compress2(Stored.GetData(), &CompressedBytes, Shuffled.GetData(), static_cast<uLong>(RawBytes), FMath::Clamp(Config.CompressionLevel, 1, 9)) == Z_OK &&
+						static_cast<int64>(CompressedBytes) < RawBytes)
+					{
+						Stored.SetNum(CompressedBytes);
+						bDeflated = true;
+					}
+				}
+
+				if (!bDeflated)
+				{
+					Stored.SetNumUninitialized(RawBytes);
+					FMemory::Memcpy(Stored.GetData(), RawData, RawBytes);
+				}
+
+				Record.StoredBytes = Stored.Num();
+				Record.Flags = bDeflated ? ChunkFlag_Deflated : 0;
+				Record.Checksum = crc32(0L, Stored.GetData(), Stored.Num());
+			});
+
+			for (int32 WaveIndex = 0; WaveIndex < WaveCount; ++WaveIndex)
+			{
+				FChunkRecord& Record = Records[WaveStart + WaveIndex];
+				Record.Offset = Offset;
+				Offset += Record.StoredBytes;
+				Writer->Serialize(WaveBuffers[WaveIndex].GetData(), WaveBuffers[WaveIndex].Num());
+			}
+		}
+
+		// Footer index and tail
+		FFileTail Tail;
+		Tail.IndexOffset = Offset;
+		Tail.NumChunks = NumChunks;
+		Tail.Magic = FileMagic;
+
+		Writer->Serialize(Records.GetData(), static_cast<int64>(Records.Num()) * sizeof(FChunkRecord));
+		Writer->Serialize(&Tail, sizeof(Tail));
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write chunk file: %s"), *FilePath);
+			return false;
+		}
+
+		if (OutPermutation)
+		{
+			*OutPermutation = MoveTemp(Order);
+		}
+
+		return true;
+	}
+
+	void FSplatChunkWriter::ShuffleBytes(const uint8* Source, int64 NumWords, uint8* Dest)
+	{
+		for (int64 Word = 0; Word < NumWords; ++Word)
+		{
+			Dest[Word] = Source[Word * 4 + 0];
+			Dest[NumWords + Word] = Source[Word * 4 + 1];
+			Dest[2 * NumWords + Word] = Source[Word * 4 + 2];
+			Dest[3 * NumWords + Word] = Source[Word * 4 + 3];
+		}
+	}
+
+	void FSplatChunkWriter::UnshuffleBytes(const uint8* Source, int64 NumWords, uint8* Dest)
+	{
+		for (int64 Word = 0; Word < NumWords; ++Word)
+		{
+			Dest[Word * 4 + 0] = Source[Word];
+			Dest[Word * 4 + 1] = Source[NumWords + Word];
+			Dest[Word * 4 + 2] = Source[2 * NumWords + Word];
+			Dest[Word * 4 + 3] = Source[3 * NumWords + Word];
+		}
+	}
+
+	// FSplatChunkReader
+
+	FSplatChunkReader::FSplatChunkReader() = default;
+
+	FSplatChunkReader::~FSplatChunkReader()
+	{
+		Close();
+	}
+
+	void FSplatChunkReader::Close()
+	{
+		// Region must be released before the file handle
+		MappedRegion.Reset();
+		MappedHandle.Reset();
+		MappedData = nullptr;
+		FileHandle.Reset();
+		Chunks.Reset();
+		NumSplats = 0;
+		Path.Reset();
+	}
+
+	bool FSplatChunkReader::Open(const FString& FilePath)
+	{
+		using FFileHeader = FSplatChunkWriter::FFileHeader;
+		using FChunkRecord = FSplatChunkWriter::FChunkRecord;
+		using FFileTail = FSplatChunkWriter::FFileTail;
+
+		Close();
+		Path = FilePath;
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		int64 FileSize = 0;
+
+		MappedHandle.Reset(PlatformFile.OpenMapped(*FilePath));
+		if (MappedHandle)
+		{
+			FileSize = MappedHandle->GetFileSize();
+			MappedRegion.Reset(MappedHandle->MapRegion(0, FileSize));
+			MappedData = MappedRegion ? MappedRegion->GetMappedPtr() : nullptr;
+		}
+
+		if (!MappedData)
+		{
+			MappedRegion.Reset();
+			MappedHandle.Reset();
+			FileHandle.Reset(PlatformFile.OpenRead(*FilePath));
+			if (!FileHandle)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to open chunk file: %s"), *FilePath);
+				return false;
+			}
+			FileSize = FileHandle->Size();
+		}
+
+		// Reads a byte range through whichever access path is open
+		auto ReadRange = [this, FileSize](int64 Offset, int64 Bytes, void* Dest)
+		{
+			if (Offset < 0 || Bytes < 0 || Offset + Bytes > FileSize)
+			{
+				return false;
+			}
+			if (MappedData)
+			{
+				FMemory::Memcpy(Dest, MappedData + Offset, Bytes);
+				return true;
+			}
+			return FileHandle->Seek(Offset) && FileHandle->Read(static_cast<uint8*>(Dest), Bytes);
+		};
+
+		FFileHeader Header;
+		FFileTail Tail;
+		if (!ReadRange(0, sizeof(Header), &Header) ||
+			!ReadRange(FileSize - static_cast<int64>(sizeof(Tail)), sizeof(Tail), &Tail) ||
+			Header.Magic != FSplatChunkWriter::FileMagic ||
+			Tail.Magic != FSplatChunkWriter::FileMagic ||
+			Header.Version != FSplatChunkWriter::FileVersion ||
+			Header.BytesPerSplat != FPlyWriter::BytesPerGaussianSplat ||
+			Header.SplatsPerChunk == 0 ||
+			Header.NumSplats > static_cast<uint64>(MAX_int32))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Not a valid chunk file: %s"), *FilePath);
+			Close();
+			return false;
+		}
+
+		// Validate the index extent against the header and file size before allocating for it
+		const int64 ExpectedChunks = FMath::DivideAndRoundUp<int64>(static_cast<int64>(Header.NumSplats), Header.SplatsPerChunk);
+		const int64 IndexBytes = static_cast<int64>(Tail.NumChunks) * sizeof(FChunkRecord);
+
+		if (Tail.NumChunks > static_cast<uint32>(MAX_int32) ||
+			static_cast<int64>(Tail.NumChunks) != ExpectedChunks ||
+			IndexBytes > FileSize - static_cast<int64>(sizeof(Header) + sizeof(Tail)) ||
+			Tail.IndexOffset < sizeof(Header) ||
+			Tail.IndexOffset > static_cast<uint64>(FileSize) ||
+			static_cast<int64>(Tail.IndexOffset) + IndexBytes + static_cast<int64>(sizeof(Tail)) != FileSize)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Chunk file index is corrupt: %s"), *FilePath);
+			Close();
+			return false;
+		}
+
+		TArray<FChunkRecord> Records;
+		Records.SetNumUninitialized(static_cast<int32>(Tail.NumChunks));
+
+		if (!ReadRange(Tail.IndexOffset, IndexBytes, Records.GetData()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to read chunk file index: %s"), *FilePath);
+			Close();
+			return false;
+		}
+
+		Chunks.SetNum(Records.Num());
+		int64 SplatCount = 0;
+
+		for (int32 ChunkIndex = 0; ChunkIndex < Records.Num(); ++ChunkIndex)
+		{
+			const FChunkRecord& Record = Records[ChunkIndex];
+			const bool bDeflated = (Record.Flags & FSplatChunkWriter::ChunkFlag_Deflated) != 0;
+			const int64 RawBytes = static_cast<int64>(Record.NumSplats) * Header.BytesPerSplat;
+
+			if (Record.NumSplats == 0 || Record.NumSplats > Header.SplatsPerChunk ||
+				Record.Offset < sizeof(Header) || Record.Offset > Tail.IndexOffset || Record.StoredBytes > Tail.IndexOffset - Record.Offset ||
+				(!bDeflated && Record.StoredBytes != RawBytes))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Chunk %d of %s is corrupt"), ChunkIndex, *FilePath);
+				Close();
+				return false;
+			}
+
+			FSplatChunkInfo& Chunk = Chunks[ChunkIndex];
+			Chunk.Bounds.Min = FVector3f(Record.BoundsMin[0], Record.BoundsMin[1], Record.BoundsMin[2]);
+			Chunk.Bounds.Max = FVector3f(Record.BoundsMax[0], Record.BoundsMax[1], Record.BoundsMax[2]);
+			Chunk.Bounds.IsValid = Chunk.Bounds.Min.X <= Chunk.Bounds.Max.X;
+			Chunk.Offset = static_cast<int64>(Record.Offset);
+			Chunk.StoredBytes = static_cast<int32>(Record.StoredBytes);
+			Chunk.NumSplats = static_cast<int32>(Record.NumSplats);
+			Chunk.FirstSplat = static_cast<int32>(SplatCount);
+			Chunk.bCompressed = bDeflated;
+			Chunk.Checksum = Record.Checksum;
+
+			SplatCount += Record.NumSplats;
+		}
+
+		if (SplatCount != static_cast<int64>(Header.NumSplats))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Chunk file splat count mismatch: %s"), *FilePath);
+			Close();
+			return false;
+		}
+
+		NumSplats = SplatCount;
+		return true;
+	}
+
+	void FSplatChunkReader::FindChunks(const FBox3f& Region, TArray<int32>& OutChunkIds) const
+	{
+		OutChunkIds.Reset();
+		for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+		{
+			if (Chunks[ChunkIndex].Bounds.IsValid && Chunks[ChunkIndex].Bounds.Intersect(Region))
+			{
+				OutChunkIds.Add(ChunkIndex);
+			}
+		}
+	}
+
+	bool FSplatChunkReader::ReadChunks(const TArray<int32>& ChunkIds, FGaussianSplatBuffer& OutSplats) const
+	{
+		OutSplats.Empty();
+
+		TArray<int32> FirstIndices;
+		FirstIndices.SetNumUninitialized(ChunkIds.Num());
+		int64 TotalSplats = 0;
+
+		for (int32 i = 0; i < ChunkIds.Num(); ++i)
+		{
+			if (!Chunks.IsValidIndex(ChunkIds[i]))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Invalid chunk ID %d (file has %d chunks)"), ChunkIds[i], Chunks.Num());
+				return false;
+			}
+			FirstIndices[i] = static_cast<int32>(TotalSplats);
+			TotalSplats += Chunks[ChunkIds[i]].NumSplats;
+		}
+
+		if (TotalSplats > MAX_int32)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Too many splats requested: %lld"), TotalSplats);
+			return false;
+		}
+
+		OutSplats.SetNumUninitialized(static_cast<int32>(TotalSplats));
+
+		std::atomic<bool> bFailed(false);
+		ParallelFor(ChunkIds.Num(), [&](int32 i)
+		{
+			if (!bFailed.load(std::memory_order_relaxed) && !DecodeChunk(Chunks[ChunkIds[i]], OutSplats, FirstIndices[i]))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to decode chunk %d of %s"), ChunkIds[i], *Path);
+				bFailed = true;
+			}
+		});
+
+		if (bFailed)
+		{
+			OutSplats.Empty();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FSplatChunkReader::ReadRegion(const FBox3f& Region, FGaussianSplatBuffer& OutSplats, bool bClipToRegion) const
+	{
+		TArray<int32> ChunkIds;
+		FindChunks(Region, ChunkIds);
+
+		if (!ReadChunks(ChunkIds, OutSplats))
+		{
+			return false;
+		}
+
+		if (bClipToRegion)
+		{
+			int32 NumKept = 0;
+			for (int32 i = 0; i < OutSplats.Num(); ++i)
+			{
+				if (!Region.IsInsideOrOn(OutSplats.Positions[i]))
+				{
+					continue;
+				}
+
+				if (NumKept != i)
+				{
+					OutSplats.Positions[NumKept] = OutSplats.Positions[i];
+					OutSplats.Normals[NumKept] = OutSplats.Normals[i];
+					OutSplats.SH_DC[NumKept] = OutSplats.SH_DC[i];
+					FMemory::Memcpy(OutSplats.GetSHRest(NumKept), OutSplats.GetSHRest(i), FGaussianSplatBuffer::NumSHRest * sizeof(float));
+					OutSplats.Opacities[NumKept] = OutSplats.Opacities[i];
+					OutSplats.Scales[NumKept] = OutSplats.Scales[i];
+					OutSplats.Rotations[NumKept] = OutSplats.Rotations[i];
+				}
+				++NumKept;
+			}
+			OutSplats.SetNumUninitialized(NumKept);
+		}
+
+		return true;
+	}
+
+	const uint8* FSplatChunkReader::GetStoredBytes(const FSplatChunkInfo& Chunk, TArray<uint8>& Scratch) const
+	{
+		if (MappedData)
+		{
+			return MappedData + Chunk.Offset;
+		}
+
+		if (!FileHandle)
+		{
+			return nullptr;
+		}
+
+		Scratch.SetNumUninitialized(Chunk.StoredBytes);
+
+		FScopeLock Lock(&FileLock);
+		if (!FileHandle->Seek(Chunk.Offset) || !FileHandle->Read(Scratch.GetData(), Chunk.StoredBytes))
+		{
+			return nullptr;
+		}
+		return Scratch.GetData();
+	}
+
+	bool FSplatChunkReader::DecodeChunk(const FSplatChunkInfo& Chunk, FGaussianSplatBuffer& OutSplats, int32 FirstIndex) const
+	{
+		TArray<uint8> Scratch;
+		const uint8* Stored = GetStoredBytes(Chunk, Scratch);
+		if (!Stored || crc32(0L, Stored, Chunk.StoredBytes) != Chunk.Checksum)
+		{
+			return false;
+		}
+
+		const int64 RawBytes = static_cast<int64>(Chunk.NumSplats) * FPlyWriter::BytesPerGaussianSplat;
+		TArray<float> Rows;
+		const float* RowData = reinterpret_cast<const float*>(Stored);
+
+		if (Chunk.bCompressed)
+		{
+			TArray<uint8> Shuffled;
+			Shuffled.SetNumUninitialized(RawBytes);
+			uLongf InflatedBytes = static_cast<uLongf>(RawBytes);
+			if (uncompress(Shuffled.GetData(), &InflatedBytes, Stored, Chunk.StoredBytes) != Z_OK || static_cast<int64>(InflatedBytes) != RawBytes)
+			{
+				return false;
+			}
+
+			Rows.SetNumUninitialized(Chunk.NumSplats * FPlyWriter::NumGaussianProperties);
+			FSplatChunkWriter::UnshuffleBytes(Shuffled.GetData(), RawBytes / 4, reinterpret_cast<uint8*>(Rows.GetData()));
+			RowData = Rows.GetData();
+		}
+		else if (!IsAligned(Stored, alignof(float)))
+		{
+			Rows.SetNumUninitialized(Chunk.NumSplats * FPlyWriter::NumGaussianProperties);
+			FMemory::Memcpy(Rows.GetData(), Stored, RawBytes);
+			RowData = Rows.GetData();
+		}
+
+		for (int32 i = 0; i < Chunk.NumSplats; ++i)
+		{
+			FPlyWriter::ScatterGaussianRow(OutSplats, FirstIndex + i, RowData + static_cast<int64>(i) * FPlyWriter::NumGaussianProperties);
+		}
+
+		return true;
+	}
+}
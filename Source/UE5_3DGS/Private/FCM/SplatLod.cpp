@@ -0,0 +1,633 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SplatLod.h"
+#include "FCM/GaussianCovariance.h"
+#include "FCM/PlyWriter.h"
+#include "FCM/SpatialSort.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/ParallelFor.h"
+
+namespace UE5_3DGS
+{
+	bool FSplatLodBuilder::Build(const FGaussianSplatBuffer& Splats, const FSplatLodConfig& Config, FSplatLodTree& OutTree)
+	{
+		OutTree = FSplatLodTree();
+
+		if (Splats.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No splats to build an LOD tree from"));
+			return false;
+		}
+
+		if (Config.MaxSplatsPerLeaf < 1 || Config.MaxSplatsPerNode < 1)
+		{
+			UE_LOG(LogTemp, Error, TEXT("LOD node capacities must be positive"));
+			return false;
+		}
+
+		// Morton order makes every octree cell a contiguous key range
+		TArray<uint64> Keys;
+		TArray<int32> Order;
+		FSpatialSort::ComputeKeys(Splats.Positions, ESpatialCurve::Morton, Keys);
+		FSpatialSort::RadixSort(Keys, Order);
+
+		int32 NumValid = Keys.Num();
+		while (NumValid > 0 && Keys[NumValid - 1] == MAX_uint64)
+		{
+			--NumValid;
+		}
+
+		if (NumValid == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("No splat has a finite position"));
+			return false;
+		}
+
+		if (NumValid < Splats.Num())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Dropped %d splats with non-finite positions from the LOD tree"), Splats.Num() - NumValid);
+		}
+
+		// Root cube matching the key quantization of FSpatialSort
+		FBox3f SceneBounds(ForceInit);
+		for (int32 i = 0; i < NumValid; ++i)
+		{
+			SceneBounds += Splats.Positions[Order[i]];
+		}
+
+		const float Extent = (SceneBounds.Max - SceneBounds.Min).GetMax();
+		const float RootSize = (Extent > 0.0f) ?
+			Extent * static_cast<float>(1u << FSpatialSort::BitsPerAxis) / static_cast<float>((1u << FSpatialSort::BitsPerAxis) - 1) :
+			1.0f;
+		const int32 MaxDepth = FMath::Clamp(Config.MaxDepth, 0, FSpatialSort::BitsPerAxis);
+
+		// Top-down partition into nodes; breadth-first, so children are contiguous and depths ascend
+		TArray<FSplatLodNode>& Nodes = OutTree.Nodes;
+		TArray<int32> RangeFirst;
+		TArray<int32> RangeLast;
+
+		FSplatLodNode Root;
+		Root.Bounds = FBox3f(SceneBounds.Min, SceneBounds.Min + FVector3f(RootSize));
+		Nodes.Add(Root);
+		RangeFirst.Add(0);
+		RangeLast.Add(NumValid);
+
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			const int32 First = RangeFirst[NodeIndex];
+			const int32 Last = RangeLast[NodeIndex];
+			const int32 Depth = Nodes[NodeIndex].Depth;
+
+			if (Last - First <= Config.MaxSplatsPerLeaf || Depth >= MaxDepth)
+			{
+				continue;
+			}
+
+			// Octant bits of this depth: x, y, z from high to low
+			const int32 Shift = 3 * (FSpatialSort::BitsPerAxis - 1 - Depth);
+			const FVector3f ParentMin = Nodes[NodeIndex].Bounds.Min;
+			const float ChildSize = Nodes[NodeIndex].Bounds.GetSize().X * 0.5f;
+
+			Nodes[NodeIndex].FirstChild = Nodes.Num();
+
+			for (int32 ChildFirst = First; ChildFirst < Last; )
+			{
+				const uint64 Octant = (Keys[ChildFirst] >> Shift) & 7;
+
+				// Keys are sorted, so octants ascend within the range
+				int32 Low = ChildFirst;
+				int32 High = Last;
+				while (Low < High)
+				{
+					const int32 Mid = Low + (High - Low) / 2;
+					if (((Keys[Mid] >> Shift) & 7) <= Octant)
+					{
+						Low = Mid + 1;
+					}
+					else
+					{
+						High = Mid;
+					}
+				}
+
+				const FVector3f ChildMin = ParentMin + ChildSize * FVector3f(static_cast<float>((Octant >> 2) & 1), static_cast<float>((Octant >> 1) & 1), static_cast<float>(Octant & 1));
+
+				FSplatLodNode Child;
+				Child.Bounds = FBox3f(ChildMin, ChildMin + FVector3f(ChildSize));
+				Child.Parent = NodeIndex;
+				Child.Depth = Depth + 1;
+				Nodes.Add(Child);
+				RangeFirst.Add(ChildFirst);
+				RangeLast.Add(Low);
+
+				++Nodes[NodeIndex].NumChildren;
+				ChildFirst = Low;
+			}
+		}
+
+		// Bottom-up: every node of a level depends only on the level below, so levels run in parallel
+		TArray<FGaussianSplatBuffer> NodeSplats;
+		NodeSplats.SetNum(Nodes.Num());
+
+		for (int32 LevelLast = Nodes.Num(); LevelLast > 0; )
+		{
+			const int32 Depth = Nodes[LevelLast - 1].Depth;
+			int32 LevelFirst = LevelLast;
+			while (LevelFirst > 0 && Nodes[LevelFirst - 1].Depth == Depth)
+			{
+				--LevelFirst;
+			}
+
+			ParallelFor(LevelLast - LevelFirst, [&](int32 LevelIndex)
+			{
+				const int32 NodeIndex = LevelFirst + LevelIndex;
+				FSplatLodNode& Node = Nodes[NodeIndex];
+
+				if (Node.IsLeaf())
+				{
+					const int32 First = RangeFirst[NodeIndex];
+					const int32 Count = RangeLast[NodeIndex] - First;
+					NodeSplats[NodeIndex].SetNumUninitialized(Count);
+					for (int32 i = 0; i < Count; ++i)
+					{
+						CopySplat(Splats, Order[First + i], NodeSplats[NodeIndex], i);
+					}
+					return;
+				}
+
+				int32 NumChildSplats = 0;
+				for (int32 Child = Node.FirstChild; Child < Node.FirstChild + Node.NumChildren; ++Child)
+				{
+					NumChildSplats += NodeSplats[Child].Num();
+				}
+
+				FGaussianSplatBuffer ChildSplats;
+				ChildSplats.SetNumUninitialized(NumChildSplats);
+				int32 Cursor = 0;
+				for (int32 Child = Node.FirstChild; Child < Node.FirstChild + Node.NumChildren; ++Child)
+				{
+					for (int32 i = 0; i < NodeSplats[Child].Num(); ++i)
+					{
+						CopySplat(NodeSplats[Child], i, ChildSplats, Cursor++);
+					}
+				}
+
+				Node.GeometricError = ReduceNode(ChildSplats, Node.Bounds, Config.MaxSplatsPerNode, NodeSplats[NodeIndex]);
+			});
+
+			LevelLast = LevelFirst;
+		}
+
+		// Concatenate node splats
+		int32 TotalSplats = 0;
+		int32 MaxTreeDepth = 0;
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			Nodes[NodeIndex].FirstSplat = TotalSplats;
+			Nodes[NodeIndex].NumSplats = NodeSplats[NodeIndex].Num();
+			TotalSplats += Nodes[NodeIndex].NumSplats;
+			MaxTreeDepth = FMath::Max(MaxTreeDepth, Nodes[NodeIndex].Depth);
+		}
+
+		OutTree.Splats.SetNumUninitialized(TotalSplats);
+		ParallelFor(Nodes.Num(), [&](int32 NodeIndex)
+		{
+			const FSplatLodNode& Node = Nodes[NodeIndex];
+			for (int32 i = 0; i < Node.NumSplats; ++i)
+			{
+				CopySplat(NodeSplats[NodeIndex], i, OutTree.Splats, Node.FirstSplat + i);
+			}
+		});
+
+		UE_LOG(LogTemp, Log, TEXT("Built splat LOD tree: %d nodes, depth %d, %d source splats, %d root splats, %d stored"),
+			Nodes.Num(), MaxTreeDepth, NumValid, Nodes[0].NumSplats, TotalSplats);
+
+		return true;
+	}
+
+	float FSplatLodBuilder::ReduceNode(const FGaussianSplatBuffer& ChildSplats, const FBox3f& Bounds, int32 MaxSplats, FGaussianSplatBuffer& OutSplats)
+	{
+		const int32 NumChildSplats = ChildSplats.Num();
+		if (NumChildSplats <= MaxSplats)
+		{
+			OutSplats = ChildSplats;
+			return 0.0f;
+		}
+
+		// Largest power-of-two grid with at most MaxSplats cells, so the result fits
+		int32 GridLevel = 0;
+		while (GridLevel < 7 && (int64(1) << (3 * (GridLevel + 1))) <= MaxSplats)
+		{
+			++GridLevel;
+		}
+
+		const int32 GridSize = 1 << GridLevel;
+		const int32 NumCells = GridSize * GridSize * GridSize;
+		const float CellSize = Bounds.GetSize().X / GridSize;
+
+		TArray<int32> CellOfSplat;
+		CellOfSplat.SetNumUninitialized(NumChildSplats);
+		for (int32 i = 0; i < NumChildSplats; ++i)
+		{
+			const FVector3f Cell = (ChildSplats.Positions[i] - Bounds.Min) / CellSize;
+			const int32 X = FMath::Clamp(FMath::FloorToInt(Cell.X), 0, GridSize - 1);
+			const int32 Y = FMath::Clamp(FMath::FloorToInt(Cell.Y), 0, GridSize - 1);
+			const int32 Z = FMath::Clamp(FMath::FloorToInt(Cell.Z), 0, GridSize - 1);
+			CellOfSplat[i] = (X * GridSize + Y) * GridSize + Z;
+		}
+
+		// Group splats by cell (counting sort)
+		TArray<int32> CellOffsets;
+		CellOffsets.SetNumZeroed(NumCells + 1);
+		for (int32 Cell : CellOfSplat)
+		{
+			++CellOffsets[Cell + 1];
+		}
+
+		int32 NumOccupied = 0;
+		for (int32 Cell = 0; Cell < NumCells; ++Cell)
+		{
+			NumOccupied += (CellOffsets[Cell + 1] > 0) ? 1 : 0;
+			CellOffsets[Cell + 1] += CellOffsets[Cell];
+		}
+
+		TArray<int32> Members;
+		Members.SetNumUninitialized(NumChildSplats);
+		{
+			TArray<int32> Cursor(CellOffsets.GetData(), NumCells);
+			for (int32 i = 0; i < NumChildSplats; ++i)
+			{
+				Members[Cursor[CellOfSplat[i]]++] = i;
+			}
+		}
+
+		OutSplats.SetNumUninitialized(NumOccupied);
+		int32 OutIndex = 0;
+		for (int32 Cell = 0; Cell < NumCells; ++Cell)
+		{
+			const int32 Count = CellOffsets[Cell + 1] - CellOffsets[Cell];
+			if (Count > 0)
+			{
+				MergeSplats(ChildSplats, Members.GetData() + CellOffsets[Cell], Count, OutSplats, OutIndex++);
+			}
+		}
+
+		return CellSize;
+	}
+
+	void FSplatLodBuilder::MergeSplats(
+		const FGaussianSplatBuffer& Splats,
+		const int32* Indices,
+		int32 Count,
+		FGaussianSplatBuffer& OutSplats,
+		int32 OutIndex)
+	{
+		check(Count > 0);
+
+		if (Count == 1)
+		{
+			CopySplat(Splats, Indices[0], OutSplats, OutIndex);
+			return;
+		}
+
+		// Weight = opacity * footprint (sqrt det of the covariance, i.e. the product of the scales)
+		auto GetWeight = [&Splats](int32 Index)
+		{
+			const FVector3f& LogScale = Splats.Scales[Index];
+			return static_cast<double>(Splats.Opacities[Index]) * FMath::Exp(static_cast<double>(LogScale.X + LogScale.Y + LogScale.Z));
+		};
+
+		double TotalWeight = 0.0;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			TotalWeight += GetWeight(Indices[i]);
+		}
+
+		// Fully transparent clusters: average uniformly, stay transparent
+		const bool bUniform = !(TotalWeight > UE_DOUBLE_SMALL_NUMBER);
+		if (bUniform)
+		{
+			TotalWeight = Count;
+		}
+
+		FVector3d Mean = FVector3d::ZeroVector;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const double Weight = bUniform ? 1.0 : GetWeight(Indices[i]);
+			Mean += Weight * FVector3d(Splats.Positions[Indices[i]]);
+		}
+		Mean /= TotalWeight;
+
+		// Second moments: child covariances plus the spread of child means
+		FGaussianCovariance Covariance;
+		FVector3d Normal = FVector3d::ZeroVector;
+		FVector3d DC = FVector3d::ZeroVector;
+		double Rest[FGaussianSplatBuffer::NumSHRest] = {};
+
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const int32 Index = Indices[i];
+			const double Weight = bUniform ? 1.0 : GetWeight(Index);
+
+			Covariance.AddScaled(FGaussianCovariance::FromScaleRotation(Splats.Scales[Index], Splats.Rotations[Index]), Weight);
+			Covariance.AddOuterProduct(FVector3d(Splats.Positions[Index]) - Mean, Weight);
+
+			Normal += Weight * FVector3d(Splats.Normals[Index]);
+			DC += Weight * FVector3d(Splats.SH_DC[Index]);
+
+			const float* SourceRest = Splats.GetSHRest(Index);
+			for (int32 k = 0; k < FGaussianSplatBuffer::NumSHRest; ++k)
+			{
+				Rest[k] += Weight * SourceRest[k];
+			}
+		}
+
+		const double InvWeight = 1.0 / TotalWeight;
+		Covariance.Scale(InvWeight);
+
+		FVector3f LogScale;
+		FQuat4f Rotation;
+		Covariance.ToScaleRotation(LogScale, Rotation);
+
+		OutSplats.Positions[OutIndex] = FVector3f(Mean);
+		OutSplats.Normals[OutIndex] = FVector3f(Normal.GetSafeNormal(UE_DOUBLE_SMALL_NUMBER, FVector3d::UpVector));
+		OutSplats.SH_DC[OutIndex] = FVector3f(DC * InvWeight);
+
+		float* OutRest = OutSplats.GetSHRest(OutIndex);
+		for (int32 k = 0; k < FGaussianSplatBuffer::NumSHRest; ++k)
+		{
+			OutRest[k] = static_cast<float>(Rest[k] * InvWeight);
+		}
+
+		// Keep the total weight: opacity * footprint of the merged splat equals the children's sum
+		const double Footprint = FMath::Exp(static_cast<double>(LogScale.X + LogScale.Y + LogScale.Z));
+		OutSplats.Opacities[OutIndex] = bUniform ? 0.0f : static_cast<float>(FMath::Clamp(TotalWeight / Footprint, 0.0, 1.0));
+		OutSplats.Scales[OutIndex] = LogScale;
+		OutSplats.Rotations[OutIndex] = Rotation;
+	}
+
+	void FSplatLodBuilder::CopySplat(const FGaussianSplatBuffer& Source, int32 SourceIndex, FGaussianSplatBuffer& Dest, int32 DestIndex)
+	{
+		Dest.Positions[DestIndex] = Source.Positions[SourceIndex];
+		Dest.Normals[DestIndex] = Source.Normals[SourceIndex];
+		Dest.SH_DC[DestIndex] = Source.SH_DC[SourceIndex];
+		FMemory::Memcpy(Dest.GetSHRest(DestIndex), Source.GetSHRest(SourceIndex), FGaussianSplatBuffer::NumSHRest * sizeof(float));
+		Dest.Opacities[DestIndex] = Source.Opacities[SourceIndex];
+		Dest.Scales[DestIndex] = Source.Scales[SourceIndex];
+		Dest.Rotations[DestIndex] = Source.Rotations[SourceIndex];
+	}
+
+	int64 FSplatLodBuilder::SelectCut(const TArray<FSplatLodNode>& Nodes, int64 SplatBudget, TArray<int32>& OutNodes)
+	{
+		OutNodes.Reset();
+		if (Nodes.Num() == 0)
+		{
+			return 0;
+		}
+
+		auto LargerError = [&Nodes](int32 A, int32 B)
+		{
+			return Nodes[A].GeometricError > Nodes[B].GeometricError;
+		};
+
+		TArray<int32> Candidates;
+		Candidates.HeapPush(0, LargerError);
+		int64 TotalSplats = Nodes[0].NumSplats;
+
+		while (Candidates.Num() > 0)
+		{
+			int32 NodeIndex;
+			Candidates.HeapPop(NodeIndex, LargerError);
+			const FSplatLodNode& Node = Nodes[NodeIndex];
+
+			int64 ChildSplats = 0;
+			for (int32 Child = Node.FirstChild; Child < Node.FirstChild + Node.NumChildren; ++Child)
+			{
+				ChildSplats += Nodes[Child].NumSplats;
+			}
+
+			if (Node.IsLeaf() || TotalSplats - Node.NumSplats + ChildSplats > SplatBudget)
+			{
+				OutNodes.Add(NodeIndex);
+				continue;
+			}
+
+			TotalSplats += ChildSplats - Node.NumSplats;
+			for (int32 Child = Node.FirstChild; Child < Node.FirstChild + Node.NumChildren; ++Child)
+			{
+				Candidates.HeapPush(Child, LargerError);
+			}
+		}
+
+		OutNodes.Sort();
+		return TotalSplats;
+	}
+
+	bool FSplatLodBuilder::WriteLodFile(const FString& FilePath, const FSplatLodTree& Tree)
+	{
+		static_assert(sizeof(FFileHeader) == 24, "LOD file header must be 24 bytes");
+		static_assert(sizeof(FNodeRecord) == 56, "LOD node record must be 56 bytes");
+
+		if (Tree.Nodes.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Empty LOD tree, nothing to write"));
+			return false;
+		}
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+		if (!Writer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open LOD file for writing: %s"), *FilePath);
+			return false;
+		}
+
+		FFileHeader Header;
+		Header.Magic = FileMagic;
+		Header.Version = FileVersion;
+		Header.NumNodes = Tree.Nodes.Num();
+		Header.BytesPerSplat = FPlyWriter::BytesPerGaussianSplat;
+		Header.NumSplats = Tree.Splats.Num();
+		Writer->Serialize(&Header, sizeof(Header));
+
+		// Node table; splat rows follow it in node order
+		const uint64 DataStart = sizeof(FFileHeader) + static_cast<uint64>(Tree.Nodes.Num()) * sizeof(FNodeRecord);
+
+		TArray<FNodeRecord> Records;
+		Records.SetNumUninitialized(Tree.Nodes.Num());
+		for (int32 NodeIndex = 0; NodeIndex < Tree.Nodes.Num(); ++NodeIndex)
+		{
+			const FSplatLodNode& Node = Tree.Nodes[NodeIndex];
+			FNodeRecord& Record = Records[NodeIndex];
+			FMemory::Memcpy(Record.BoundsMin, &Node.Bounds.Min, sizeof(Record.BoundsMin));
+			FMemory::Memcpy(Record.BoundsMax, &Node.Bounds.Max, sizeof(Record.BoundsMax));
+			Record.Parent = Node.Parent;
+			Record.FirstChild = Node.FirstChild;
+			Record.NumChildren = Node.NumChildren;
+			Record.Depth = Node.Depth;
+			Record.GeometricError = Node.GeometricError;
+			Record.NumSplats = Node.NumSplats;
+			Record.DataOffset = DataStart + static_cast<uint64>(Node.FirstSplat) * FPlyWriter::BytesPerGaussianSplat;
+		}
+		Writer->Serialize(Records.GetData(), static_cast<int64>(Records.Num()) * sizeof(FNodeRecord));
+
+		// Splat rows, gathered in parallel one chunk at a time
+		const int32 NumSplats = Tree.Splats.Num();
+		TArray<float> ChunkBuffer;
+		ChunkBuffer.SetNumUninitialized(FMath::Min(NumSplats, FPlyWriter::BinaryWriteChunkSplats) * FPlyWriter::NumGaussianProperties);
+
+		for (int32 ChunkStart = 0; ChunkStart < NumSplats && !Writer->IsError(); ChunkStart += FPlyWriter::BinaryWriteChunkSplats)
+		{
+			const int32 ChunkCount = FMath::Min(FPlyWriter::BinaryWriteChunkSplats, NumSplats - ChunkStart);
+			float* ChunkData = ChunkBuffer.GetData();
+
+			ParallelFor(ChunkCount, [&](int32 i)
+			{
+				FPlyWriter::GatherGaussianRow(Tree.Splats, ChunkStart + i, ChunkData + static_cast<int64>(i) * FPlyWriter::NumGaussianProperties);
+			});
+
+			Writer->Serialize(ChunkData, static_cast<int64>(ChunkCount) * FPlyWriter::BytesPerGaussianSplat);
+		}
+
+		if (!Writer->Close())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write LOD file: %s"), *FilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FSplatLodBuilder::ReadLodIndex(const FString& FilePath, TArray<FSplatLodNode>& OutNodes)
+	{
+		OutNodes.Reset();
+
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		if (!Handle)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open LOD file: %s"), *FilePath);
+			return false;
+		}
+
+		const int64 FileSize = Handle->Size();
+
+		FFileHeader Header;
+		if (!Handle->Read(reinterpret_cast<uint8*>(&Header), sizeof(Header)) ||
+			Header.Magic != FileMagic ||
+			Header.Version != FileVersion ||
+			Header.BytesPerSplat != FPlyWriter::BytesPerGaussianSplat)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Not a valid LOD file: %s"), *FilePath);
+			return false;
+		}
+
+		const int64 TableBytes = static_cast<int64>(Header.NumNodes) * sizeof(FNodeRecord);
+		if (Header.NumNodes == 0 || static_cast<int64>(sizeof(Header)) + TableBytes > FileSize)
+		{
+			UE_LOG(LogTemp, Error, TEXT("LOD file node table is truncated: %s"), *FilePath);
+			return false;
+		}
+
+		TArray<FNodeRecord> Records;
+		Records.SetNumUninitialized(Header.NumNodes);
+		if (!Handle->Read(reinterpret_cast<uint8*>(Records.GetData()), TableBytes))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to read LOD node table: %s"), *FilePath);
+			return false;
+		}
+
+		const int64 DataStart = static_cast<int64>(sizeof(Header)) + TableBytes;
+		OutNodes.SetNum(Records.Num());
+
+		for (int32 NodeIndex = 0; NodeIndex < Records.Num(); ++NodeIndex)
+		{
+			const FNodeRecord& Record = Records[NodeIndex];
+			const int64 DataEnd = static_cast<int64>(Record.DataOffset) + static_cast<int64>(Record.NumSplats) * Header.BytesPerSplat;
+			const bool bChildrenValid = Record.NumChildren == 0 ||
+				(Record.FirstChild > NodeIndex && Record.NumChildren <= 8 && Record.FirstChild + Record.NumChildren <= Records.Num());
+
+			if (Record.NumSplats < 0 || static_cast<int64>(Record.DataOffset) < DataStart || DataEnd > FileSize || !bChildrenValid)
+			{
+				UE_LOG(LogTemp, Error, TEXT("LOD file node %d is corrupt: %s"), NodeIndex, *FilePath);
+				OutNodes.Reset();
+				return false;
+			}
+
+			FSplatLodNode& Node = OutNodes[NodeIndex];
+			Node.Bounds = FBox3f(FVector3f(Record.BoundsMin[0], Record.BoundsMin[1], Record.BoundsMin[2]),
+				FVector3f(Record.BoundsMax[0], Record.BoundsMax[1], Record.BoundsMax[2]));
+			Node.Parent = Record.Parent;
+			Node.FirstChild = Record.FirstChild;
+			Node.NumChildren = Record.NumChildren;
+			Node.Depth = Record.Depth;
+			Node.GeometricError = Record.GeometricError;
+			Node.NumSplats = Record.NumSplats;
+			Node.FirstSplat = static_cast<int32>((static_cast<int64>(Record.DataOffset) - DataStart) / Header.BytesPerSplat);
+			Node.DataOffset = static_cast<int64>(Record.DataOffset);
+		}
+
+		return true;
+	}
+
+	bool FSplatLodBuilder::ReadLodNodes(
+		const FString& FilePath,
+		const TArray<FSplatLodNode>& Nodes,
+		const TArray<int32>& NodeIndices,
+		FGaussianSplatBuffer& OutSplats)
+	{
+		OutSplats.Empty();
+
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		if (!Handle)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open LOD file: %s"), *FilePath);
+			return false;
+		}
+
+		int64 TotalSplats = 0;
+		for (int32 NodeIndex : NodeIndices)
+		{
+			if (!Nodes.IsValidIndex(NodeIndex))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Invalid LOD node index %d"), NodeIndex);
+				return false;
+			}
+			TotalSplats += Nodes[NodeIndex].NumSplats;
+		}
+
+		if (TotalSplats > MAX_int32)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Too many splats requested from LOD file: %lld"), TotalSplats);
+			return false;
+		}
+
+		OutSplats.SetNumUninitialized(static_cast<int32>(TotalSplats));
+
+		TArray<float> Rows;
+		int32 Cursor = 0;
+
+		// Each node is one seek and one contiguous read
+		for (int32 NodeIndex : NodeIndices)
+		{
+			const FSplatLodNode& Node = Nodes[NodeIndex];
+			Rows.SetNumUninitialized(Node.NumSplats * FPlyWriter::NumGaussianProperties);
+
+			if (!Handle->Seek(Node.DataOffset) ||
+				!Handle->Read(reinterpret_cast<uint8*>(Rows.GetData()), static_cast<int64>(Node.NumSplats) * FPlyWriter::BytesPerGaussianSplat))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to read LOD node %d: %s"), NodeIndex, *FilePath);
+				OutSplats.Empty();
+				return false;
+			}
+
+			const int32 NodeFirst = Cursor;
+			ParallelFor(Node.NumSplats, [&](int32 i)
+			{
+				FPlyWriter::ScatterGaussianRow(OutSplats, NodeFirst + i, Rows.GetData() + static_cast<int64>(i) * FPlyWriter::NumGaussianProperties);
+			});
+			Cursor += Node.NumSplats;
+		}
+
+		return true;
+	}
+}
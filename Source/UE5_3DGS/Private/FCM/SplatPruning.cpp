@@ -0,0 +1,300 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SplatPruning.h"
+#include "FCM/SpatialSort.h"
+#include "FCM/SplatLod.h"
+#include "Async/ParallelFor.h"
+
+namespace UE5_3DGS
+{
+	void FSplatPruneStats::Log() const
+	{
+		UE_LOG(LogTemp, Log, TEXT("Pruned %d -> %d splats: %d invalid, %d transparent, %d too small, %d merged"),
+			NumInput, NumOutput, NumInvalid, NumTransparent, NumTooSmall, NumMerged);
+	}
+
+	bool FSplatPruner::Prune(
+		const FGaussianSplatBuffer& Splats,
+		const FSplatPruneConfig& Config,
+		FGaussianSplatBuffer& OutSplats,
+		FSplatPruneStats& OutStats,
+		TArray<int32>* OutSourceIndices)
+	{
+		OutStats = FSplatPruneStats();
+		OutSplats.Empty();
+
+		const int32 NumSplats = Splats.Num();
+		OutStats.NumInput = NumSplats;
+
+		if (NumSplats == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No splats to prune"));
+			return false;
+		}
+
+		if (Config.MinProjectedRadius > 0.0f && (Config.FocalLengthPixels <= 0.0f || (Config.ViewPositions.Num() == 0 && Config.ReferenceDistance <= 0.0f)))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Projected size pruning needs a positive focal length and viewing distance"));
+			return false;
+		}
+
+		// Threshold tests
+		TArray<EPruneReason> Reasons;
+		Reasons.SetNumUninitialized(NumSplats);
+
+		const bool bCheckSize = Config.MinProjectedRadius > 0.0f;
+
+		ParallelFor(NumSplats, [&](int32 i)
+		{
+			const FVector3f& Position = Splats.Positions[i];
+			const FVector3f& LogScale = Splats.Scales[i];
+
+			if (!FMath::IsFinite(Position.X) || !FMath::IsFinite(Position.Y) || !FMath::IsFinite(Position.Z) ||
+				!FMath::IsFinite(LogScale.X) || !FMath::IsFinite(LogScale.Y) || !FMath::IsFinite(LogScale.Z))
+			{
+				Reasons[i] = EPruneReason::Invalid;
+				return;
+			}
+
+			// Written as a negation so NaN opacity is pruned as well
+			if (!(Splats.Opacities[i] >= Config.MinOpacity))
+			{
+				Reasons[i] = EPruneReason::Transparent;
+				return;
+			}
+
+			if (bCheckSize)
+			{
+				float Distance = Config.ReferenceDistance;
+				if (Config.ViewPositions.Num() > 0)
+				{
+					float MinDistanceSquared = TNumericLimits<float>::Max();
+					for (const FVector3f& View : Config.ViewPositions)
+					{
+						MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector3f::DistSquared(View, Position));
+					}
+					Distance = FMath::Sqrt(MinDistanceSquared);
+				}
+
+				const float Radius = 3.0f * FMath::Exp(LogScale.GetMax());
+				if (Config.FocalLengthPixels * Radius < Config.MinProjectedRadius * Distance)
+				{
+					Reasons[i] = EPruneReason::TooSmall;
+					return;
+				}
+			}
+
+			Reasons[i] = EPruneReason::Keep;
+		});
+
+		for (EPruneReason Reason : Reasons)
+		{
+			OutStats.NumInvalid += (Reason == EPruneReason::Invalid) ? 1 : 0;
+			OutStats.NumTransparent += (Reason == EPruneReason::Transparent) ? 1 : 0;
+			OutStats.NumTooSmall += (Reason == EPruneReason::TooSmall) ? 1 : 0;
+		}
+
+		// Deduplication: representative of each kept splat
+		TArray<int32> Representative;
+		if (Config.MergeDistance > 0.0f)
+		{
+			FindDuplicates(Splats, Reasons, Config, Representative);
+		}
+		else
+		{
+			Representative.SetNumUninitialized(NumSplats);
+			for (int32 i = 0; i < NumSplats; ++i)
+			{
+				Representative[i] = i;
+			}
+		}
+
+		// Output slot of each representative, in source order; members grouped by counting sort
+		TArray<int32> OutputIndex;
+		OutputIndex.Init(INDEX_NONE, NumSplats);
+		int32 NumOutput = 0;
+		for (int32 i = 0; i < NumSplats; ++i)
+		{
+			if (Reasons[i] == EPruneReason::Keep && Representative[i] == i)
+			{
+				OutputIndex[i] = NumOutput++;
+			}
+		}
+
+		TArray<int32> MemberOffsets;
+		MemberOffsets.SetNumZeroed(NumOutput + 1);
+		for (int32 i = 0; i < NumSplats; ++i)
+		{
+			if (Reasons[i] == EPruneReason::Keep)
+			{
+				MemberOffsets[OutputIndex[Representative[i]] + 1]++;
+			}
+		}
+		for (int32 i = 0; i < NumOutput; ++i)
+		{
+			MemberOffsets[i + 1] += MemberOffsets[i];
+		}
+
+		TArray<int32> Members;
+		Members.SetNumUninitialized(MemberOffsets[NumOutput]);
+		{
+			TArray<int32> Cursor(MemberOffsets.GetData(), NumOutput);
+			for (int32 i = 0; i < NumSplats; ++i)
+			{
+				if (Reasons[i] == EPruneReason::Keep)
+				{
+					Members[Cursor[OutputIndex[Representative[i]]]++] = i;
+				}
+			}
+		}
+
+		OutStats.NumMerged = Members.Num() - NumOutput;
+		OutStats.NumOutput = NumOutput;
+
+		OutSplats.SetNumUninitialized(NumOutput);
+		ParallelFor(NumOutput, [&](int32 Index)
+		{
+			const int32 First = MemberOffsets[Index];
+			FSplatLodBuilder::MergeSplats(Splats, Members.GetData() + First, MemberOffsets[Index + 1] - First, OutSplats, Index);
+		});
+
+		if (OutSourceIndices)
+		{
+			OutSourceIndices->SetNumUninitialized(NumOutput);
+			for (int32 Index = 0; Index < NumOutput; ++Index)
+			{
+				(*OutSourceIndices)[Index] = Members[MemberOffsets[Index]];
+			}
+		}
+
+		OutStats.Log();
+		return true;
+	}
+
+	void FSplatPruner::FindDuplicates(
+		const FGaussianSplatBuffer& Splats,
+		const TArray<EPruneReason>& Reasons,
+		const FSplatPruneConfig& Config,
+		TArray<int32>& OutRepresentative)
+	{
+		const int32 NumSplats = Splats.Num();
+		const float InvCellSize = 1.0f / Config.MergeDistance;
+		const float MergeDistanceSquared = Config.MergeDistance * Config.MergeDistance;
+
+		auto GetCell = [InvCellSize](const FVector3f& Position)
+		{
+			// Far cells are clamped onto the key range; that only adds candidates, distances are still checked
+			constexpr float CellLimit = (1 << 20) - 2;
+			return FIntVector(
+				FMath::FloorToInt32(FMath::Clamp(Position.X * InvCellSize, -CellLimit, CellLimit)),
+				FMath::FloorToInt32(FMath::Clamp(Position.Y * InvCellSize, -CellLimit, CellLimit)),
+				FMath::FloorToInt32(FMath::Clamp(Position.Z * InvCellSize, -CellLimit, CellLimit)));
+		};
+
+		// Sort splats by cell; pruned splats get the largest key and sort last
+		TArray<uint64> Keys;
+		Keys.SetNumUninitialized(NumSplats);
+		ParallelFor(NumSplats, [&](int32 i)
+		{
+			Keys[i] = (Reasons[i] == EPruneReason::Keep) ? GetCellKey(GetCell(Splats.Positions[i])) : MAX_uint64;
+		});
+
+		TArray<int32> Order;
+		FSpatialSort::RadixSort(Keys, Order);
+
+		// First sorted position of each occupied cell
+		TMap<uint64, int32> CellStarts;
+		for (int32 s = 0; s < NumSplats && Keys[s] != MAX_uint64; ++s)
+		{
+			if (s == 0 || Keys[s] != Keys[s - 1])
+			{
+				CellStarts.Add(Keys[s], s);
+			}
+		}
+
+		// Calls Visit(Other) for every lower-index coincident splat in the 27 surrounding cells, stopping when it returns true
+		auto ForEachLowerMatch = [&](int32 i, auto&& Visit)
+		{
+			const FVector3f& Position = Splats.Positions[i];
+			const FVector3f& LogScale = Splats.Scales[i];
+			const FIntVector Cell = GetCell(Position);
+
+			for (int32 dz = -1; dz <= 1; ++dz)
+			{
+				for (int32 dy = -1; dy <= 1; ++dy)
+				{
+					for (int32 dx = -1; dx <= 1; ++dx)
+					{
+						const uint64 Key = GetCellKey(Cell + FIntVector(dx, dy, dz));
+						const int32* Start = CellStarts.Find(Key);
+						if (!Start)
+						{
+							continue;
+						}
+
+						for (int32 s = *Start; s < NumSplats && Keys[s] == Key; ++s)
+						{
+							const int32 Other = Order[s];
+							if (Other >= i)
+							{
+								continue;
+							}
+
+							const FVector3f ScaleDelta = (Splats.Scales[Other] - LogScale).GetAbs();
+							if (FVector3f::DistSquared(Splats.Positions[Other], Position) <= MergeDistanceSquared &&
+								ScaleDelta.GetMax() <= Config.MergeMaxLogScaleDifference &&
+								Visit(Other))
+							{
+								return;
+							}
+						}
+					}
+				}
+			}
+		};
+
+		// Splats with no lower-index match always lead their own cluster; find them in parallel
+		OutRepresentative.SetNumUninitialized(NumSplats);
+		ParallelFor(NumSplats, [&](int32 i)
+		{
+			bool bHasMatch = false;
+			if (Reasons[i] == EPruneReason::Keep)
+			{
+				ForEachLowerMatch(i, [&bHasMatch](int32) { bHasMatch = true; return true; });
+			}
+			OutRepresentative[i] = bHasMatch ? INDEX_NONE : i;
+		});
+
+		// Greedy leader clustering in index order: a splat joins the lowest-index leader within
+		// MergeDistance, or leads a new cluster. Members never chain, so clusters stay within
+		// MergeDistance of their leader however densely a surface is sampled.
+		for (int32 i = 0; i < NumSplats; ++i)
+		{
+			if (OutRepresentative[i] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			int32 Leader = i;
+			ForEachLowerMatch(i, [&](int32 Other)
+			{
+				if (OutRepresentative[Other] == Other && Other < Leader)
+				{
+					Leader = Other;
+				}
+				return false;
+			});
+			OutRepresentative[i] = Leader;
+		}
+	}
+
+	uint64 FSplatPruner::GetCellKey(const FIntVector& Cell)
+	{
+		// 21 bits per axis with a bias keeps negative cells ordered and the key below MAX_uint64
+		constexpr int32 Bias = 1 << 20;
+		constexpr uint64 Mask = (1ull << 21) - 1;
+		return ((static_cast<uint64>(Cell.X + Bias) & Mask) << 42) |
+			((static_cast<uint64>(Cell.Y + Bias) & Mask) << 21) |
+			(static_cast<uint64>(Cell.Z + Bias) & Mask);
+	}
+}
@@ -0,0 +1,245 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SplatStatistics.h"
+#include "FCM/PlyWriter.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace UE5_3DGS
+{
+	void FSplatAttributeStats::Init(double InHistogramMin, double InHistogramMax, int32 NumBins)
+	{
+		*this = FSplatAttributeStats();
+		HistogramMin = InHistogramMin;
+		HistogramMax = InHistogramMax;
+		Bins.SetNumZeroed(FMath::Max(1, NumBins));
+	}
+
+	void FSplatAttributeStats::Add(double Value)
+	{
+		if (!FMath::IsFinite(Value))
+		{
+			return;
+		}
+
+		Min = FMath::Min(Min, Value);
+		Max = FMath::Max(Max, Value);
+		Sum += Value;
+		++Count;
+
+		// Out-of-range values land in the edge bins
+		const double Range = HistogramMax - HistogramMin;
+		const double Position = (Range > 0.0) ? (Value - HistogramMin) / Range * Bins.Num() : 0.0;
+		Bins[FMath::Clamp(static_cast<int32>(FMath::FloorToDouble(FMath::Clamp(Position, -1.0, static_cast<double>(Bins.Num())))), 0, Bins.Num() - 1)]++;
+	}
+
+	void FSplatAttributeStats::Merge(const FSplatAttributeStats& Other)
+	{
+		check(Bins.Num() == Other.Bins.Num());
+
+		Min = FMath::Min(Min, Other.Min);
+		Max = FMath::Max(Max, Other.Max);
+		Sum += Other.Sum;
+		Count += Other.Count;
+		for (int32 i = 0; i < Bins.Num(); ++i)
+		{
+			Bins[i] += Other.Bins[i];
+		}
+	}
+
+	bool FSplatStatistics::Compute(const FGaussianSplatBuffer& Splats, const FSplatStatisticsConfig& Config, FSplatStatistics& OutStatistics)
+	{
+		OutStatistics = FSplatStatistics();
+
+		const int32 NumSplats = Splats.Num();
+		if (NumSplats == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No splats to compute statistics for"));
+			return false;
+		}
+
+		if (Config.NumBins < 1 || !(Config.LogScaleMax > Config.LogScaleMin) || !(Config.SHEnergyMax > 0.0f))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Invalid splat statistics settings"));
+			return false;
+		}
+
+		FSplatStatistics Empty;
+		Empty.Opacity.Init(0.0, 1.0, Config.NumBins);
+		Empty.LogScale.Init(Config.LogScaleMin, Config.LogScaleMax, Config.NumBins);
+		Empty.SHEnergy.Init(0.0, Config.SHEnergyMax, Config.NumBins);
+
+		// One partial report per batch, merged in batch order so results are deterministic
+		constexpr int32 SplatsPerBatch = 65536;
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumSplats, SplatsPerBatch);
+
+		TArray<FSplatStatistics> Partials;
+		Partials.Init(Empty, NumBatches);
+
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * SplatsPerBatch;
+			const int32 Last = FMath::Min(First + SplatsPerBatch, NumSplats);
+			FSplatStatistics& Partial = Partials[BatchIndex];
+			Partial.NumSplats = Last - First;
+
+			float Row[FPlyWriter::NumGaussianProperties];
+			for (int32 i = First; i < Last; ++i)
+			{
+				// Every attribute value of the splat, for the NaN / Inf checks
+				FPlyWriter::GatherGaussianRow(Splats, i, Row);
+
+				bool bHasNaN = false;
+				bool bHasInf = false;
+				for (float Value : Row)
+				{
+					bHasNaN |= FMath::IsNaN(Value);
+					bHasInf |= !FMath::IsFinite(Value) && !FMath::IsNaN(Value);
+				}
+				Partial.NumWithNaN += bHasNaN ? 1 : 0;
+				Partial.NumWithInf += bHasInf ? 1 : 0;
+
+				const FVector3f& Position = Splats.Positions[i];
+				if (FMath::IsFinite(Position.X) && FMath::IsFinite(Position.Y) && FMath::IsFinite(Position.Z))
+				{
+					const FVector3d Position64(Position);
+					Partial.Bounds += Position64;
+					Partial.Centroid += Position64;
+				}
+				else
+				{
+					Partial.NumInvalidPositions++;
+				}
+
+				const float Opacity = Splats.Opacities[i];
+				Partial.Opacity.Add(Opacity);
+				Partial.NumOpacityOutOfRange += (Opacity < 0.0f || Opacity > 1.0f) ? 1 : 0;
+
+				const FVector3f& Scale = Splats.Scales[i];
+				Partial.LogScale.Add(Scale.X);
+				Partial.LogScale.Add(Scale.Y);
+				Partial.LogScale.Add(Scale.Z);
+
+				const float* Rest = Splats.GetSHRest(i);
+				double Energy = 0.0;
+				for (int32 k = 0; k < FGaussianSplatBuffer::NumSHRest; ++k)
+				{
+					Energy += static_cast<double>(Rest[k]) * Rest[k];
+				}
+				Partial.SHEnergy.Add(FMath::Sqrt(Energy / FGaussianSplatBuffer::NumSHRest));
+
+				// Negated so NaN rotations count as non-unit
+				const float Length = Splats.Rotations[i].Size();
+				Partial.NumNonUnitQuaternions += !(FMath::Abs(Length - 1.0f) <= Config.QuaternionTolerance) ? 1 : 0;
+			}
+		});
+
+		OutStatistics = MoveTemp(Empty);
+		for (const FSplatStatistics& Partial : Partials)
+		{
+			OutStatistics.Merge(Partial);
+		}
+
+		const int64 NumFinitePositions = OutStatistics.NumSplats - OutStatistics.NumInvalidPositions;
+		OutStatistics.Centroid = (NumFinitePositions > 0) ? OutStatistics.Centroid / static_cast<double>(NumFinitePositions) : FVector3d::ZeroVector;
+
+		return true;
+	}
+
+	void FSplatStatistics::Merge(const FSplatStatistics& Other)
+	{
+		NumSplats += Other.NumSplats;
+		Bounds += Other.Bounds;
+		Centroid += Other.Centroid;
+		Opacity.Merge(Other.Opacity);
+		LogScale.Merge(Other.LogScale);
+		SHEnergy.Merge(Other.SHEnergy);
+		NumWithNaN += Other.NumWithNaN;
+		NumWithInf += Other.NumWithInf;
+		NumInvalidPositions += Other.NumInvalidPositions;
+		NumOpacityOutOfRange += Other.NumOpacityOutOfRange;
+		NumNonUnitQuaternions += Other.NumNonUnitQuaternions;
+	}
+
+	TSharedRef<FJsonObject> FSplatStatistics::ToJsonObject() const
+	{
+		auto MakeVector = [](const FVector3d& V)
+		{
+			return TArray<TSharedPtr<FJsonValue>>{
+				MakeShared<FJsonValueNumber>(V.X),
+				MakeShared<FJsonValueNumber>(V.Y),
+				MakeShared<FJsonValueNumber>(V.Z)
+			};
+		};
+
+		auto MakeAttribute = [](const FSplatAttributeStats& Stats)
+		{
+			const bool bHasValues = Stats.Count > 0;
+
+			TSharedPtr<FJsonObject> Attribute = MakeShared<FJsonObject>();
+			Attribute->SetNumberField(TEXT("count"), static_cast<double>(Stats.Count));
+			Attribute->SetNumberField(TEXT("min"), bHasValues ? Stats.Min : 0.0);
+			Attribute->SetNumberField(TEXT("max"), bHasValues ? Stats.Max : 0.0);
+			Attribute->SetNumberField(TEXT("mean"), Stats.GetMean());
+
+			TArray<TSharedPtr<FJsonValue>> Bins;
+			for (int64 Bin : Stats.Bins)
+			{
+				Bins.Add(MakeShared<FJsonValueNumber>(static_cast<double>(Bin)));
+			}
+
+			TSharedPtr<FJsonObject> Histogram = MakeShared<FJsonObject>();
+			Histogram->SetNumberField(TEXT("min"), Stats.HistogramMin);
+			Histogram->SetNumberField(TEXT("max"), Stats.HistogramMax);
+			Histogram->SetArrayField(TEXT("bins"), Bins);
+			Attribute->SetObjectField(TEXT("histogram"), Histogram);
+
+			return Attribute;
+		};
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("splats"), NumSplats);
+		Root->SetBoolField(TEXT("valid"), IsValid());
+
+		TSharedPtr<FJsonObject> BoundsObject = MakeShared<FJsonObject>();
+		BoundsObject->SetArrayField(TEXT("min"), MakeVector(Bounds.IsValid ? Bounds.Min : FVector3d::ZeroVector));
+		BoundsObject->SetArrayField(TEXT("max"), MakeVector(Bounds.IsValid ? Bounds.Max : FVector3d::ZeroVector));
+		Root->SetObjectField(TEXT("bounds"), BoundsObject);
+		Root->SetArrayField(TEXT("centroid"), MakeVector(Centroid));
+
+		Root->SetObjectField(TEXT("opacity"), MakeAttribute(Opacity));
+		Root->SetObjectField(TEXT("logScale"), MakeAttribute(LogScale));
+		Root->SetObjectField(TEXT("shEnergy"), MakeAttribute(SHEnergy));
+
+		TSharedPtr<FJsonObject> Issues = MakeShared<FJsonObject>();
+		Issues->SetNumberField(TEXT("nan"), static_cast<double>(NumWithNaN));
+		Issues->SetNumberField(TEXT("inf"), static_cast<double>(NumWithInf));
+		Issues->SetNumberField(TEXT("invalidPositions"), static_cast<double>(NumInvalidPositions));
+		Issues->SetNumberField(TEXT("opacityOutOfRange"), static_cast<double>(NumOpacityOutOfRange));
+		Issues->SetNumberField(TEXT("nonUnitQuaternions"), static_cast<double>(NumNonUnitQuaternions));
+		Root->SetObjectField(TEXT("issues"), Issues);
+
+		return Root;
+	}
+
+	FString FSplatStatistics::ToJson() const
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(ToJsonObject(), Writer);
+		return Json;
+	}
+
+	bool FSplatStatistics::SaveJson(const FString& FilePath) const
+	{
+		if (!FFileHelper::SaveStringToFile(ToJson(), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write splat statistics: %s"), *FilePath);
+			return false;
+		}
+		return true;
+	}
+}
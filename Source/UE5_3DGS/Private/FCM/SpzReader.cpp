@@ -0,0 +1,456 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SpzReader.h"
+#include "FCM/PlyWriter.h"
+#include "FCM/SHCodebook.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/ParallelFor.h"
+
+#include <atomic>
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace UE5_3DGS
+{
+	bool FSpzReader::ReadSpz(const FString& FilePath, FGaussianSplatBuffer& OutSplats, const FSectionCallback& OnSectionDecoded)
+	{
+		OutSplats.Empty();
+
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		if (!Handle)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to open SPZ file: %s"), *FilePath);
+			return false;
+		}
+
+		int64 Remaining = Handle->Size();
+		const bool bDecoded = DecodeStream([&Handle, &Remaining](uint8* Buffer, int64 MaxBytes) -> int64
+		{
+			const int64 BytesToRead = FMath::Min(MaxBytes, Remaining);
+			if (BytesToRead > 0 && !Handle->Read(Buffer, BytesToRead))
+			{
+				return -1;
+			}
+			Remaining -= BytesToRead;
+			return BytesToRead;
+		}, OutSplats, OnSectionDecoded);
+
+		if (!bDecoded)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to decode SPZ file: %s"), *FilePath);
+			return false;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("Read %d gaussian splats from %s"), OutSplats.Num(), *FilePath);
+		return true;
+	}
+
+	bool FSpzReader::ReadSpz(const FString& FilePath, TArray<FGaussianSplat>& OutSplats)
+	{
+		OutSplats.Empty();
+
+		FGaussianSplatBuffer Buffer;
+		if (!ReadSpz(FilePath, Buffer))
+		{
+			return false;
+		}
+
+		Buffer.ToSplats(OutSplats);
+		return true;
+	}
+
+	bool FSpzReader::DecodeSpz(const uint8* Data, int64 Size, FGaussianSplatBuffer& OutSplats, const FSectionCallback& OnSectionDecoded)
+	{
+		int64 Offset = 0;
+		return DecodeStream([Data, Size, &Offset](uint8* Buffer, int64 MaxBytes) -> int64
+		{
+			const int64 BytesToCopy = FMath::Min(MaxBytes, Size - Offset);
+			FMemory::Memcpy(Buffer, Data + Offset, BytesToCopy);
+			Offset += BytesToCopy;
+			return BytesToCopy;
+		}, OutSplats, OnSectionDecoded);
+	}
+
+	bool FSpzReader::DecodeStream(FByteSource Source, FGaussianSplatBuffer& OutSplats, const FSectionCallback& OnSectionDecoded)
+	{
+		OutSplats.Empty();
+
+		z_stream Stream;
+		FMemory::Memzero(Stream);
+		if (inflateInit2(&Stream, 16 + MAX_WBITS) != Z_OK)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to initialize gzip decompression"));
+			return false;
+		}
+
+		TArray<uint8> Input;
+		TArray<uint8> Staging;
+		Input.SetNumUninitialized(InputChunkBytes);
+		Staging.SetNumUninitialized(StagingBytes);
+
+		FDecodeState State;
+		bool bHasHeader = false;
+		bool bInputEnded = false;
+		int64 StagedBytes = 0;
+		int32 Section = 0;
+		int32 SplatCursor = 0;
+		bool bSuccess = false;
+
+		for (;;)
+		{
+			if (Stream.avail_in == 0 && !bInputEnded)
+			{
+				const int64 BytesRead = Source(Input.GetData(), Input.Num());
+				if (BytesRead < 0)
+				{
+					UE_LOG(LogTemp, Error, TEXT("Failed to read SPZ data"));
+					break;
+				}
+				bInputEnded = BytesRead == 0;
+				Stream.next_in = Input.GetData();
+				Stream.avail_in = static_cast<uInt>(BytesRead);
+			}
+
+			Stream.next_out = Staging.GetData() + StagedBytes;
+			Stream.avail_out = static_cast<uInt>(Staging.Num() - StagedBytes);
+
+			const int32 Result = inflate(&Stream, Z_NO_FLUSH);
+			if (Result != Z_OK && Result != Z_STREAM_END && Result != Z_BUF_ERROR)
+			{
+				UE_LOG(LogTemp, Error, TEXT("SPZ data is corrupt (zlib error %d)"), Result);
+				break;
+			}
+
+			const int64 NewBytes = (Staging.Num() - StagedBytes) - Stream.avail_out;
+			StagedBytes += NewBytes;
+
+			// Dequantize every complete record staged so far
+			int64 Consumed = 0;
+			if (!bHasHeader && StagedBytes >= static_cast<int64>(sizeof(FSpzHeader)))
+			{
+				FMemory::Memcpy(&State.Header, Staging.GetData(), sizeof(FSpzHeader));
+				if (!BeginDecode(State.Header, OutSplats))
+				{
+					break;
+				}
+				bHasHeader = true;
+				Consumed = sizeof(FSpzHeader);
+			}
+
+			bool bCorrupt = false;
+			while (bHasHeader && Section < static_cast<int32>(ESpzSection::Count))
+			{
+				const ESpzSection CurrentSection = static_cast<ESpzSection>(Section);
+
+				// The codebook column starts with its entry count
+				if (CurrentSection == ESpzSection::SHCodebook && State.HasCodebook() && State.NumCodebookEntries == INDEX_NONE)
+				{
+					if (StagedBytes - Consumed < static_cast<int64>(sizeof(uint32)))
+					{
+						break;
+					}
+
+					uint32 EntryCount;
+					FMemory::Memcpy(&EntryCount, Staging.GetData() + Consumed, sizeof(uint32));
+					Consumed += sizeof(uint32);
+
+					if (EntryCount == 0 || EntryCount > FSHCodebook::MaxEntries)
+					{
+						UE_LOG(LogTemp, Error, TEXT("Invalid SPZ SH codebook size %u"), EntryCount);
+						bCorrupt = true;
+						break;
+					}
+
+					State.NumCodebookEntries = static_cast<int32>(EntryCount);
+					State.Codebook.SetNumZeroed(EntryCount * FGaussianSplatBuffer::NumSHRest);
+				}
+
+				const int32 RecordBytes = GetSectionBytes(CurrentSection, State);
+				const int32 NumRecords = GetSectionCount(CurrentSection, State, OutSplats.Num());
+
+				const int32 Count = RecordBytes > 0
+					? static_cast<int32>(FMath::Min<int64>((StagedBytes - Consumed) / RecordBytes, NumRecords - SplatCursor))
+					: NumRecords - SplatCursor;
+
+				if (Count > 0 && RecordBytes > 0)
+				{
+					if (!DecodeSection(CurrentSection, State, Staging.GetData() + Consumed, SplatCursor, Count, OutSplats))
+					{
+						UE_LOG(LogTemp, Error, TEXT("SPZ SH codebook index out of range"));
+						bCorrupt = true;
+						break;
+					}
+					Consumed += static_cast<int64>(Count) * RecordBytes;
+				}
+				SplatCursor += Count;
+
+				if (SplatCursor < NumRecords)
+				{
+					break;
+				}
+
+				if (OnSectionDecoded && RecordBytes > 0 && CurrentSection != ESpzSection::SHCodebook)
+				{
+					OnSectionDecoded(CurrentSection, OutSplats);
+				}
+				++Section;
+				SplatCursor = 0;
+			}
+
+			if (bCorrupt)
+			{
+				break;
+			}
+
+			// Keep the partial record for the next round
+			StagedBytes -= Consumed;
+			if (Consumed > 0 && StagedBytes > 0)
+			{
+				FMemory::Memmove(Staging.GetData(), Staging.GetData() + Consumed, StagedBytes);
+			}
+
+			if (Section == static_cast<int32>(ESpzSection::Count))
+			{
+				bSuccess = true;
+				break;
+			}
+
+			const bool bStalled = Result == Z_BUF_ERROR && Stream.avail_in == 0 && bInputEnded;
+			if (Result == Z_STREAM_END || bStalled)
+			{
+				UE_LOG(LogTemp, Error, TEXT("SPZ data ended before all attributes were read"));
+				break;
+			}
+		}
+
+		inflateEnd(&Stream);
+
+		if (!bSuccess)
+		{
+			OutSplats.Empty();
+		}
+
+		return bSuccess;
+	}
+
+	bool FSpzReader::BeginDecode(const FSpzHeader& Header, FGaussianSplatBuffer& OutSplats)
+	{
+		if (Header.Magic != SpzFormat::Magic)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Not an SPZ file (bad magic 0x%08x)"), Header.Magic);
+			return false;
+		}
+
+		if (Header.Version < SpzFormat::MinVersion || Header.Version > SpzFormat::Version)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Unsupported SPZ version %u"), Header.Version);
+			return false;
+		}
+
+		const bool bCodebookWithoutSH = (Header.Flags & SpzFlag_SHCodebook) && Header.SHDegree == 0;
+		if (Header.NumPoints > static_cast<uint32>(MAX_int32) || Header.SHDegree > 3 || Header.FractionalBits > 23 || bCodebookWithoutSH)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Invalid SPZ header (%u points, SH degree %u)"), Header.NumPoints, Header.SHDegree);
+			return false;
+		}
+
+		const int32 NumSplats = static_cast<int32>(Header.NumPoints);
+		OutSplats.SetNumUninitialized(NumSplats);
+
+		// Attributes SPZ does not carry keep the FGaussianSplat defaults
+		FMemory::Memzero(OutSplats.SH_Rest.GetData(), OutSplats.SH_Rest.Num() * sizeof(float));
+		for (FVector3f& Normal : OutSplats.Normals)
+		{
+			Normal = FVector3f::UpVector;
+		}
+
+		return true;
+	}
+
+	int32 FSpzReader::GetSectionBytes(ESpzSection Section, const FDecodeState& State)
+	{
+		using namespace SpzFormat;
+
+		const int32 SHBytes = GetNumSHCoeffs(State.Header.SHDegree) * 3;
+
+		switch (Section)
+		{
+		case ESpzSection::Positions:
+			return PositionBytes;
+		case ESpzSection::Alphas:
+			return AlphaBytes;
+		case ESpzSection::Colors:
+			return ColorBytes;
+		case ESpzSection::Scales:
+			return ScaleBytes;
+		case ESpzSection::Rotations:
+			return GetRotationBytes(State.Header.Version);
+		case ESpzSection::SHCodebook:
+			return State.HasCodebook() ? SHBytes : 0;
+		case ESpzSection::SH:
+			return State.HasCodebook() ? static_cast<int32>(sizeof(uint16)) : SHBytes;
+		default:
+			return 0;
+		}
+	}
+
+	int32 FSpzReader::GetSectionCount(ESpzSection Section, const FDecodeState& State, int32 NumSplats)
+	{
+		if (Section == ESpzSection::SHCodebook)
+		{
+			return FMath::Max(State.NumCodebookEntries, 0);
+		}
+		return NumSplats;
+	}
+
+	bool FSpzReader::DecodeSection(
+		ESpzSection Section,
+		FDecodeState& State,
+		const uint8* Data,
+		int32 First,
+		int32 Count,
+		FGaussianSplatBuffer& OutSplats)
+	{
+		using namespace SpzFormat;
+
+		const FSpzHeader& Header = State.Header;
+
+		// SPZ (right, up, back) to PLY (right, down, forward): flip Y and Z
+		const FVector3f AxisFlip(1.0f, -1.0f, -1.0f);
+		const float PositionScale = 1.0f / static_cast<float>(1 << Header.FractionalBits);
+		const int32 NumSHCoeffs = GetNumSHCoeffs(Header.SHDegree);
+		const int32 RecordBytes = GetSectionBytes(Section, State);
+		constexpr int32 RestCoeffsPerChannel = FGaussianSplatBuffer::NumSHRest / 3;
+
+		// SPZ interleaves channels per coefficient; SH_Rest is channel-major (15 per channel)
+		auto UnpackSH = [NumSHCoeffs](const uint8* Record, float* OutRest)
+		{
+			for (int32 Coeff = 0; Coeff < NumSHCoeffs; ++Coeff)
+			{
+				const float Flip = GetSHAxisFlip(Coeff);
+				for (int32 Channel = 0; Channel < 3; ++Channel)
+				{
+					OutRest[Channel * RestCoeffsPerChannel + Coeff] = (Record[Coeff * 3 + Channel] - 128.0f) / 128.0f * Flip;
+				}
+			}
+		};
+
+		std::atomic<bool> bValid(true);
+
+		constexpr int32 RecordsPerBatch = 4096;
+		ParallelFor(FMath::DivideAndRoundUp(Count, RecordsPerBatch), [&](int32 BatchIndex)
+		{
+			const int32 BatchFirst = BatchIndex * RecordsPerBatch;
+			const int32 BatchLast = FMath::Min(BatchFirst + RecordsPerBatch, Count);
+
+			for (int32 Local = BatchFirst; Local < BatchLast; ++Local)
+			{
+				const uint8* Record = Data + static_cast<int64>(Local) * RecordBytes;
+				const int32 i = First + Local;
+
+				switch (Section)
+				{
+				case ESpzSection::Positions:
+				{
+					FVector3f Position;
+					for (int32 Axis = 0; Axis < 3; ++Axis)
+					{
+						const uint8* In = Record + Axis * 3;
+						int32 Fixed = In[0] | (In[1] << 8) | (In[2] << 16);
+						Fixed = (Fixed & 0x800000) ? (Fixed | ~0xffffff) : Fixed;
+						Position[Axis] = Fixed * PositionScale;
+					}
+					OutSplats.Positions[i] = Position * AxisFlip;
+					break;
+				}
+				case ESpzSection::Alphas:
+					OutSplats.Opacities[i] = Record[0] / 255.0f;
+					break;
+				case ESpzSection::Colors:
+					OutSplats.SH_DC[i] = FVector3f(
+						(Record[0] / 255.0f - 0.5f) / ColorScale,
+						(Record[1] / 255.0f - 0.5f) / ColorScale,
+						(Record[2] / 255.0f - 0.5f) / ColorScale);
+					break;
+				case ESpzSection::Scales:
+					OutSplats.Scales[i] = FVector3f(Record[0], Record[1], Record[2]) / 16.0f - 10.0f;
+					break;
+				case ESpzSection::Rotations:
+				{
+					FQuat4f Q;
+					if (Header.Version >= 3)
+					{
+						uint32 Packed;
+						FMemory::Memcpy(&Packed, Record, sizeof(uint32));
+						Q = UnpackRotation(Packed);
+					}
+					else
+					{
+						// Version 2: x, y, z in 8 bits each, w >= 0 reconstructed
+						const FVector3f XYZ = FVector3f(Record[0], Record[1], Record[2]) / 127.5f - 1.0f;
+						Q = FQuat4f(XYZ.X, XYZ.Y, XYZ.Z, FMath::Sqrt(FMath::Max(0.0f, 1.0f - XYZ.SizeSquared())));
+					}
+					OutSplats.Rotations[i] = FQuat4f(Q.X, -Q.Y, -Q.Z, Q.W);
+					break;
+				}
+				case ESpzSection::SHCodebook:
+					UnpackSH(Record, State.Codebook.GetData() + static_cast<int64>(i) * FGaussianSplatBuffer::NumSHRest);
+					break;
+				case ESpzSection::SH:
+					if (State.HasCodebook())
+					{
+						uint16 Entry;
+						FMemory::Memcpy(&Entry, Record, sizeof(uint16));
+						if (Entry >= State.NumCodebookEntries)
+						{
+							bValid = false;
+							break;
+						}
+						FMemory::Memcpy(OutSplats.GetSHRest(i), State.Codebook.GetData() + static_cast<int64>(Entry) * FGaussianSplatBuffer::NumSHRest,
+							FGaussianSplatBuffer::NumSHRest * sizeof(float));
+					}
+					else
+					{
+						UnpackSH(Record, OutSplats.GetSHRest(i));
+					}
+					break;
+				default:
+					break;
+				}
+			}
+		});
+
+		return bValid;
+	}
+
+	FQuat4f FSpzReader::UnpackRotation(uint32 Packed)
+	{
+		constexpr uint32 MagnitudeMask = (1u << 9) - 1;
+		const int32 Largest = static_cast<int32>(Packed >> 30);
+
+		float Components[4];
+		float SumSquares = 0.0f;
+
+		// Components were packed in ascending order, so the last one is in the low bits
+		for (int32 i = 3; i >= 0; --i)
+		{
+			if (i == Largest)
+			{
+				continue;
+			}
+
+			const uint32 Magnitude = Packed & MagnitudeMask;
+			const bool bNegative = (Packed >> 9) & 1;
+			Packed >>= 10;
+
+			Components[i] = UE_INV_SQRT_2 * static_cast<float>(Magnitude) / MagnitudeMask;
+			Components[i] = bNegative ? -Components[i] : Components[i];
+			SumSquares += Components[i] * Components[i];
+		}
+
+		Components[Largest] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - SumSquares));
+		return FQuat4f(Components[0], Components[1], Components[2], Components[3]);
+	}
+}
@@ -0,0 +1,317 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#include "FCM/SpzWriter.h"
+#include "FCM/PlyWriter.h"
+#include "FCM/SHCodebook.h"
+#include "Misc/FileHelper.h"
+#include "Async/ParallelFor.h"
+
+#include <atomic>
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace UE5_3DGS
+{
+	bool FSpzWriter::WriteSpz(const FString& FilePath, const FGaussianSplatBuffer& Splats, const FSpzConfig& Config)
+	{
+		TArray<uint8> Data;
+		if (!EncodeSpz(Splats, Config, Data))
+		{
+			return false;
+		}
+
+		if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write SPZ file: %s"), *FilePath);
+			return false;
+		}
+
+		const int64 PlySize = static_cast<int64>(Splats.Num()) * FPlyWriter::BytesPerGaussianSplat;
+		UE_LOG(LogTemp, Log, TEXT("Wrote %d splats to %s (%.1f%% of PLY size)"),
+			Splats.Num(), *FilePath, PlySize > 0 ? 100.0 * Data.Num() / PlySize : 0.0);
+
+		return true;
+	}
+
+	bool FSpzWriter::WriteSpz(const FString& FilePath, const TArray<FGaussianSplat>& Splats, const FSpzConfig& Config)
+	{
+		return WriteSpz(FilePath, FGaussianSplatBuffer::FromSplats(Splats), Config);
+	}
+
+	bool FSpzWriter::EncodeSpz(const FGaussianSplatBuffer& Splats, const FSpzConfig& Config, TArray<uint8>& OutData)
+	{
+		OutData.Reset();
+
+		if (Splats.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No splats to encode as SPZ"));
+			return false;
+		}
+
+		if (Config.FractionalBits < 0 || Config.FractionalBits > 23 ||
+			Config.SH1Bits < 1 || Config.SH1Bits > 8 ||
+			Config.SHRestBits < 1 || Config.SHRestBits > 8)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Invalid SPZ quantization settings"));
+			return false;
+		}
+
+		if (Config.SHCodebook && (Config.SHCodebook->Indices.Num() != Splats.Num() || Config.SHCodebook->NumEntries() == 0))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SH codebook does not match the splat buffer"));
+			return false;
+		}
+
+		TArray<uint8> Payload;
+		PackSplats(Splats, Config, Payload);
+
+		return CompressGzip(Payload.GetData(), Payload.Num(), Config.CompressionLevel, OutData);
+	}
+
+	void FSpzWriter::PackSplats(const FGaussianSplatBuffer& Splats, const FSpzConfig& Config, TArray<uint8>& OutPayload)
+	{
+		using namespace SpzFormat;
+
+		const int32 NumSplats = Splats.Num();
+		const int32 SHDegree = FMath::Clamp(Config.SHDegree, 0, 3);
+		const int32 NumSHCoeffs = GetNumSHCoeffs(SHDegree);
+		const int32 RotationBytes = GetRotationBytes(Version);
+		const FSHCodebook* Codebook = (NumSHCoeffs > 0) ? Config.SHCodebook : nullptr;
+		const int32 NumEntries = Codebook ? Codebook->NumEntries() : 0;
+		const int32 EntryBytes = NumSHCoeffs * 3;
+		const int32 SHBytes = Codebook ? sizeof(uint16) : EntryBytes;
+
+		FSpzHeader Header;
+		Header.Magic = Magic;
+		Header.Version = Version;
+		Header.NumPoints = static_cast<uint32>(NumSplats);
+		Header.SHDegree = static_cast<uint8>(SHDegree);
+		Header.FractionalBits = static_cast<uint8>(Config.FractionalBits);
+		Header.Flags = (Config.bAntialiased ? SpzFlag_Antialiased : SpzFlag_None) | (Codebook ? SpzFlag_SHCodebook : SpzFlag_None);
+
+		// Column offsets within the payload
+		const int64 N = NumSplats;
+		const int64 PositionsOffset = sizeof(FSpzHeader);
+		const int64 AlphasOffset = PositionsOffset + N * PositionBytes;
+		const int64 ColorsOffset = AlphasOffset + N * AlphaBytes;
+		const int64 ScalesOffset = ColorsOffset + N * ColorBytes;
+		const int64 RotationsOffset = ScalesOffset + N * ScaleBytes;
+		const int64 CodebookOffset = RotationsOffset + N * RotationBytes;
+		const int64 SHOffset = CodebookOffset + (Codebook ? sizeof(uint32) + static_cast<int64>(NumEntries) * EntryBytes : 0);
+
+		OutPayload.SetNumUninitialized(SHOffset + N * SHBytes);
+		FMemory::Memcpy(OutPayload.GetData(), &Header, sizeof(FSpzHeader));
+
+		uint8* Positions = OutPayload.GetData() + PositionsOffset;
+		uint8* Alphas = OutPayload.GetData() + AlphasOffset;
+		uint8* Colors = OutPayload.GetData() + ColorsOffset;
+		uint8* Scales = OutPayload.GetData() + ScalesOffset;
+		uint8* Rotations = OutPayload.GetData() + RotationsOffset;
+		uint8* SH = OutPayload.GetData() + SHOffset;
+
+		// Codebook entries are written like per-splat SH but without bucketing
+		auto PackSH = [NumSHCoeffs](const float* Rest, int32 SH1Bucket, int32 SHRestBucket, uint8* OutSH)
+		{
+			constexpr int32 RestCoeffsPerChannel = FGaussianSplatBuffer::NumSHRest / 3;
+
+			// SH_Rest is channel-major (15 per channel); SPZ interleaves channels per coefficient
+			for (int32 Coeff = 0; Coeff < NumSHCoeffs; ++Coeff)
+			{
+				const int32 Bucket = Coeff < 3 ? SH1Bucket : SHRestBucket;
+				const float Flip = GetSHAxisFlip(Coeff);
+				for (int32 Channel = 0; Channel < 3; ++Channel)
+				{
+					OutSH[Coeff * 3 + Channel] = QuantizeSH(Rest[Channel * RestCoeffsPerChannel + Coeff] * Flip, Bucket);
+				}
+			}
+		};
+
+		if (Codebook)
+		{
+			const uint32 EntryCount = static_cast<uint32>(NumEntries);
+			FMemory::Memcpy(OutPayload.GetData() + CodebookOffset, &EntryCount, sizeof(uint32));
+
+			uint8* Entries = OutPayload.GetData() + CodebookOffset + sizeof(uint32);
+			ParallelFor(NumEntries, [&](int32 Entry)
+			{
+				PackSH(Codebook->GetEntry(Entry), 1, 1, Entries + static_cast<int64>(Entry) * EntryBytes);
+			});
+		}
+
+		const float PositionScale = static_cast<float>(1 << Config.FractionalBits);
+		const int32 SH1Bucket = 1 << (8 - Config.SH1Bits);
+		const int32 SHRestBucket = 1 << (8 - Config.SHRestBits);
+
+		// PLY (right, down, forward) to SPZ (right, up, back): flip Y and Z
+		const FVector3f AxisFlip(1.0f, -1.0f, -1.0f);
+
+		constexpr int32 SplatsPerBatch = 4096;
+		ParallelFor(FMath::DivideAndRoundUp(NumSplats, SplatsPerBatch), [&](int32 BatchIndex)
+		{
+			const int32 First = BatchIndex * SplatsPerBatch;
+			const int32 Last = FMath::Min(First + SplatsPerBatch, NumSplats);
+
+			for (int32 i = First; i < Last; ++i)
+			{
+				const FVector3f Position = Splats.Positions[i] * AxisFlip;
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					const int32 Fixed = FMath::Clamp(FMath::RoundToInt(Position[Axis] * PositionScale), -(1 << 23), (1 << 23) - 1);
+					uint8* Out = Positions + static_cast<int64>(i) * PositionBytes + Axis * 3;
+					Out[0] = static_cast<uint8>(Fixed & 0xff);
+					Out[1] = static_cast<uint8>((Fixed >> 8) & 0xff);
+					Out[2] = static_cast<uint8>((Fixed >> 16) & 0xff);
+				}
+
+				Alphas[i] = ToUInt8(Splats.Opacities[i] * 255.0f);
+
+				for (int32 Channel = 0; Channel < 3; ++Channel)
+				{
+					Colors[static_cast<int64>(i) * 3 + Channel] = ToUInt8(Splats.SH_DC[i][Channel] * (ColorScale * 255.0f) + 0.5f * 255.0f);
+					Scales[static_cast<int64>(i) * 3 + Channel] = ToUInt8((Splats.Scales[i][Channel] + 10.0f) * 16.0f);
+				}
+
+				const FQuat4f& Q = Splats.Rotations[i];
+				const uint32 PackedRotation = PackRotation(FQuat4f(Q.X, -Q.Y, -Q.Z, Q.W));
+				FMemory::Memcpy(Rotations + static_cast<int64>(i) * RotationBytes, &PackedRotation, sizeof(uint32));
+
+				if (Codebook)
+				{
+					FMemory::Memcpy(SH + static_cast<int64>(i) * SHBytes, &Codebook->Indices[i], sizeof(uint16));
+				}
+				else
+				{
+					PackSH(Splats.GetSHRest(i), SH1Bucket, SHRestBucket, SH + static_cast<int64>(i) * SHBytes);
+				}
+			}
+		});
+	}
+
+	bool FSpzWriter::CompressGzip(const uint8* Data, int64 Size, int32 Level, TArray<uint8>& OutCompressed)
+	{
+		OutCompressed.Reset();
+
+		constexpr int32 WindowBytes = 32768;
+		const int32 NumBlocks = FMath::Max(1, static_cast<int32>(FMath::DivideAndRoundUp<int64>(Size, GzipBlockBytes)));
+		const int32 CompressionLevel = FMath::Clamp(Level, 1, 9);
+
+		TArray<TArray<uint8>> Blocks;
+		TArray<uint32> BlockCrcs;
+		Blocks.SetNum(NumBlocks);
+		BlockCrcs.SetNumZeroed(NumBlocks);
+		std::atomic<bool> bFailed(false);
+
+		ParallelFor(NumBlocks, [&](int32 BlockIndex)
+		{
+			const int64 Start = static_cast<int64>(BlockIndex) * GzipBlockBytes;
+			const uInt BlockSize = static_cast<uInt>(FMath::Min<int64>(GzipBlockBytes, Size - Start));
+			const bool bLastBlock = BlockIndex == NumBlocks - 1;
+
+			BlockCrcs[BlockIndex] = crc32(0L, Data + Start, BlockSize);
+
+			z_stream Stream;
+			FMemory::Memzero(Stream);
+			if (deflateInit2(&Stream, CompressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			{
+				bFailed = true;
+				return;
+			}
+
+			// Prime with the tail of the previous block so matches can span block boundaries
+			if (Start > 0)
+			{
+				const int64 DictionaryBytes = FMath::Min<int64>(WindowBytes, Start);
+				deflateSetDictionary(&Stream, Data + Start - DictionaryBytes, static_cast<uInt>(DictionaryBytes));
+			}
+
+			TArray<uint8>& Block = Blocks[BlockIndex];
+			Block.SetNumUninitialized(deflateBound(&Stream, BlockSize) + 16);
+
+			Stream.next_in = const_cast<Bytef*>(Data + Start);
+			Stream.avail_in = BlockSize;
+			Stream.next_out = Block.GetData();
+			Stream.avail_out = Block.Num();
+
+			// Sync flush ends each block on a byte boundary so the raw streams concatenate
+			const int32 Result = deflate(&Stream, bLastBlock ? Z_FINISH : Z_SYNC_FLUSH);
+			if ((bLastBlock && Result != Z_STREAM_END) || (!bLastBlock && Result != Z_OK) || Stream.avail_in != 0)
+			{
+				bFailed = true;
+			}
+
+			Block.SetNum(Block.Num() - Stream.avail_out);
+			deflateEnd(&Stream);
+		});
+
+		if (bFailed)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Gzip compression failed"));
+			return false;
+		}
+
+		int64 CompressedSize = 0;
+		uLong Crc = crc32(0L, Z_NULL, 0);
+		for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+		{
+			const int64 Start = static_cast<int64>(BlockIndex) * GzipBlockBytes;
+			Crc = crc32_combine(Crc, BlockCrcs[BlockIndex], static_cast<z_off_t>(FMath::Min<int64>(GzipBlockBytes, Size - Start)));
+			CompressedSize += Blocks[BlockIndex].Num();
+		}
+
+		// Gzip member: header (deflate, no name, unknown OS), blocks, CRC32 and size mod 2^32
+		static const uint8 GzipHeader[10] = { 0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff };
+		const uint32 Trailer[2] = { static_cast<uint32>(Crc), static_cast<uint32>(Size & 0xffffffff) };
+
+		OutCompressed.Reserve(sizeof(GzipHeader) + CompressedSize + sizeof(Trailer));
+		OutCompressed.Append(GzipHeader, sizeof(GzipHeader));
+		for (const TArray<uint8>& Block : Blocks)
+		{
+			OutCompressed.Append(Block);
+		}
+		OutCompressed.Append(reinterpret_cast<const uint8*>(Trailer), sizeof(Trailer));
+
+		return true;
+	}
+
+	uint32 FSpzWriter::PackRotation(const FQuat4f& Rotation)
+	{
+		const FQuat4f Q = Rotation.GetNormalized();
+		const float Components[4] = { Q.X, Q.Y, Q.Z, Q.W };
+
+		int32 Largest = 0;
+		for (int32 i = 1; i < 4; ++i)
+		{
+			if (FMath::Abs(Components[i]) > FMath::Abs(Components[Largest]))
+			{
+				Largest = i;
+			}
+		}
+
+		// q and -q are the same rotation; store the others relative to a positive largest component
+		const bool bNegate = Components[Largest] < 0.0f;
+		constexpr int32 MagnitudeMask = (1 << 9) - 1;
+
+		uint32 Packed = static_cast<uint32>(Largest);
+		for (int32 i = 0; i < 4; ++i)
+		{
+			if (i != Largest)
+			{
+				const uint32 SignBit = (Components[i] < 0.0f) != bNegate ? 1 : 0;
+				const uint32 Magnitude = static_cast<uint32>(FMath::Min(
+					FMath::FloorToInt(MagnitudeMask * (FMath::Abs(Components[i]) / UE_INV_SQRT_2) + 0.5f), MagnitudeMask));
+				Packed = (Packed << 10) | (SignBit << 9) | Magnitude;
+			}
+		}
+
+		return Packed;
+	}
+
+	uint8 FSpzWriter::QuantizeSH(float Value, int32 BucketSize)
+	{
+		int32 Quantized = FMath::RoundToInt(Value * 128.0f) + 128;
+		Quantized = (Quantized + BucketSize / 2) / BucketSize * BucketSize;
+		return static_cast<uint8>(FMath::Clamp(Quantized, 0, 255));
+	}
+}
@@ -4,6 +4,8 @@
 #include "FCM/CoordinateConverter.h"
 #include "FCM/ColmapWriter.h"
 #include "FCM/PlyWriter.h"
+#include "FCM/NormalEstimation.h"
+#include "FCM/PointCloudFilter.h"
 #include "DEM/DepthExtractor.h"
 
 #include "Components/SceneCaptureComponent2D.h"
@@ -338,7 +340,7 @@ void UCaptureOrchestrator::ProcessNextFrame()
 
 		if (DepthResult.IsValid())
 		{
-			FString DepthFilename = FString::Printf(TEXT("depth_%05d"), CurrentViewpointIndex);
+			FString DepthFilename = FString::Printf(TEXT("depth_%05d%s"), CurrentViewpointIndex, UE5_3DGS::FDepthExtractor::GetFileExtension(ActiveConfig.DepthConfig.Format));
 			FString DepthPath = ActiveConfig.OutputDirectory / TEXT("depth") / DepthFilename;
 
 			if (UE5_3DGS::FDepthExtractor::SaveDepthToFile(DepthResult, DepthPath, ActiveConfig.DepthConfig))
@@ -401,6 +403,10 @@ bool UCaptureOrchestrator::ExportPointCloud()
 
 	TArray<UE5_3DGS::FPointCloudPoint> Points;
 
+	// Camera markers carry their view direction as normal; they bypass the
+	// filtering and normal estimation below and are appended before writing
+	TArray<UE5_3DGS::FPointCloudPoint> CameraMarkers;
+
 	// For each viewpoint, add a point at the focus location
 	// This is a placeholder - real implementation would use depth maps
 
@@ -411,7 +417,7 @@ bool UCaptureOrchestrator::ExportPointCloud()
 		CamPoint.Position = UE5_3DGS::FCoordinateConverter::ConvertPositionToColmap(VP.Position);
 		CamPoint.Normal = UE5_3DGS::FCoordinateConverter::ConvertDirectionToColmap(VP.Rotation.Vector());
 		CamPoint.Color = FColor::Red;
-		Points.Add(CamPoint);
+		CameraMarkers.Add(CamPoint);
 
 		// Add focus point
 		UE5_3DGS::FPointCloudPoint FocusPoint;
@@ -421,6 +427,48 @@ bool UCaptureOrchestrator::ExportPointCloud()
 		Points.Add(FocusPoint);
 	}
 
+	// Stray points at depth silhouettes would train into floaters
+	if (ActiveConfig.bRemoveOutliers)
+	{
+		TArray<UE5_3DGS::FPointCloudPoint> Filtered;
+		UE5_3DGS::FOutlierRemovalStats OutlierStats;
+		if (UE5_3DGS::FPointCloudFilter::RemoveOutliers(Points, UE5_3DGS::FOutlierRemovalConfig(), Filtered, OutlierStats))
+		{
+			Points = MoveTemp(Filtered);
+		}
+	}
+
+	// Merge redundant points so the init cloud stays within the budget trainers load quickly
+	const bool bOverBudget = ActiveConfig.MaxPointCloudPoints > 0 && Points.Num() > ActiveConfig.MaxPointCloudPoints;
+	if (ActiveConfig.PointCloudVoxelSize > 0.0f || bOverBudget)
+	{
+		UE5_3DGS::FVoxelDownsampleConfig VoxelConfig;
+		VoxelConfig.TargetPoints = ActiveConfig.MaxPointCloudPoints;
+		if (ActiveConfig.PointCloudVoxelSize > 0.0f)
+		{
+			VoxelConfig.VoxelSize = ActiveConfig.PointCloudVoxelSize;
+		}
+
+		TArray<UE5_3DGS::FPointCloudPoint> Downsampled;
+		if (UE5_3DGS::FPointCloudFilter::VoxelDownsample(Points, VoxelConfig, Downsampled))
+		{
+			Points = MoveTemp(Downsampled);
+		}
+	}
+
+	// Surface normals from neighbourhood plane fits, facing the nearest camera
+	if (ActiveConfig.bEstimateNormals)
+	{
+		UE5_3DGS::FNormalEstimationConfig NormalConfig;
+		for (const FCameraViewpoint& VP : Viewpoints)
+		{
+			NormalConfig.ViewPositions.Add(FVector3f(UE5_3DGS::FCoordinateConverter::ConvertPositionToColmap(VP.Position)));
+		}
+		UE5_3DGS::FNormalEstimator::EstimateNormals(Points, NormalConfig);
+	}
+
+	Points.Append(CameraMarkers);
+
 	// Write PLY
 	FString PlyPath = ActiveConfig.OutputDirectory / TEXT("sparse") / TEXT("0") / TEXT("points3D.ply");
 	return UE5_3DGS::FPlyWriter::WritePointCloud(PlyPath, Points, true);
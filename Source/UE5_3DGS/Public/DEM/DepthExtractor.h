@@ -22,7 +22,10 @@ enum class EDepthFormat : uint8
 	NPY UMETA(DisplayName = "NumPy NPY"),
 
 	/** Raw binary float32 */
-	RawFloat32 UMETA(DisplayName = "Raw Float32")
+	RawFloat32 UMETA(DisplayName = "Raw Float32"),
+
+	/** 16-bit half float EXR (linear meters) */
+	EXR16 UMETA(DisplayName = "EXR 16-bit")
 };
 
 /**
@@ -193,6 +196,14 @@ namespace UE5_3DGS
 			const FDepthExtractionConfig& Config
 		);
 
+		/**
+		 * File extension written for a depth format
+		 *
+		 * @param Format Export format
+		 * @return Extension including the leading dot
+		 */
+		static const TCHAR* GetFileExtension(EDepthFormat Format);
+
 		/**
 		 * Save depth as 16-bit PNG
 		 * Depth normalized to 0-65535 range based on near/far planes
@@ -207,16 +218,18 @@ namespace UE5_3DGS
 		);
 
 		/**
-		 * Save depth as 32-bit EXR
-		 * Linear depth in meters
+		 * Save depth as a single-channel ZIP-compressed EXR
+		 * Linear depth in meters, stored in the "Y" channel
 		 *
 		 * @param Result Depth data
 		 * @param FilePath Output path
+		 * @param bHalf Store 16-bit half floats instead of 32-bit floats
 		 * @return True if successful
 		 */
 		static bool SaveDepthAsEXR(
 			const FDepthExtractionResult& Result,
-			const FString& FilePath
+			const FString& FilePath,
+			bool bHalf = false
 		);
 
 		/**
@@ -0,0 +1,84 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * Sample type of an EXR channel (values are the EXR pixel type codes)
+	 */
+	enum class EExrPixelType : uint8
+	{
+		Half = 1,
+		Float = 2
+	};
+
+	/**
+	 * EXR output settings
+	 */
+	struct UNREALTOGAUSSIAN_API FExrWriteConfig
+	{
+		/** Stored sample type */
+		EExrPixelType PixelType = EExrPixelType::Float;
+
+		/** ZIP-compress 16-line blocks (otherwise single uncompressed lines) */
+		bool bCompress = true;
+
+		/** zlib compression level (1-9) */
+		int32 CompressionLevel = 4;
+
+		/** Channel name; "Y" is read as a grayscale image by generic EXR loaders */
+		FString ChannelName = TEXT("Y");
+	};
+
+	/**
+	 * Minimal OpenEXR writer for single-channel scanline images
+	 *
+	 * Writes a single-part scanline file with INCREASING_Y line order. With
+	 * compression the image is cut into 16-line ZIP blocks: each block's bytes
+	 * are split into even and odd halves, delta-encoded and deflated, exactly
+	 * as the OpenEXR ZIP compressor does, so any OpenEXR reader decodes them.
+	 * Blocks are encoded in parallel and written in order after the offset
+	 * table. Blocks that do not shrink are stored raw, which the format allows.
+	 */
+	class UNREALTOGAUSSIAN_API FExrWriter
+	{
+	public:
+		/** Scanlines per block for ZIP compression */
+		static constexpr int32 ZipLinesPerBlock = 16;
+
+		/**
+		 * Write a single-channel EXR image
+		 *
+		 * @param FilePath Output file path
+		 * @param Pixels Width * Height samples, row-major from the top row
+		 * @param Width Image width
+		 * @param Height Image height
+		 * @param Config Sample type and compression settings
+		 * @return True if successful
+		 */
+		static bool WriteSingleChannel(
+			const FString& FilePath,
+			const float* Pixels,
+			int32 Width,
+			int32 Height,
+			const FExrWriteConfig& Config = FExrWriteConfig()
+		);
+
+	private:
+		/** EXR compression attribute values */
+		static constexpr uint8 Compression_None = 0;
+		static constexpr uint8 Compression_Zip = 3;
+
+		/** Serialize the magic number, version and header attributes */
+		static void WriteHeader(TArray<uint8>& Out, int32 Width, int32 Height, const FExrWriteConfig& Config);
+
+		/** Append one header attribute */
+		static void WriteAttribute(TArray<uint8>& Out, const char* Name, const char* Type, const void* Value, int32 Size);
+
+		/** Split bytes into even and odd halves, then delta-encode (the OpenEXR ZIP predictor) */
+		static void PredictBytes(const uint8* Source, int32 NumBytes, uint8* Dest);
+	};
+}
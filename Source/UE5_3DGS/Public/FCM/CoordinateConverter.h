@@ -19,6 +19,8 @@
  */
 namespace UE5_3DGS
 {
+	struct FGaussianSplatBuffer;
+
 	/**
 	 * Coordinate conversion constants and utilities
 	 */
@@ -129,6 +131,86 @@ namespace UE5_3DGS
 		static const FMatrix InverseAxisSwapMatrix;
 	};
 
+	/**
+	 * Similarity transform of splat sets: p' = Scale * Q * p + Translation
+	 *
+	 * Q is orthogonal and may be a reflection, which covers handedness changes
+	 * such as COLMAP <-> UE5. It is stored as the images of the unit axes.
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatTransform
+	{
+		/** Images of the X, Y and Z axes under Q (orthonormal) */
+		FVector3d AxisX = FVector3d(1.0, 0.0, 0.0);
+		FVector3d AxisY = FVector3d(0.0, 1.0, 0.0);
+		FVector3d AxisZ = FVector3d(0.0, 0.0, 1.0);
+
+		/** Uniform scale (positive) */
+		double Scale = 1.0;
+
+		FVector3d Translation = FVector3d::ZeroVector;
+
+		/**
+		 * Build from an engine transform
+		 * Scale3D must be uniform in magnitude; negative components mirror their axis.
+		 */
+		static FSplatTransform FromTransform(const FTransform& Transform);
+
+		/** COLMAP/PLY (meters, right-handed Y-down) to UE5 (centimeters, left-handed Z-up) */
+		static FSplatTransform ColmapToUE5();
+
+		/** UE5 to COLMAP/PLY, inverse of ColmapToUE5 */
+		static FSplatTransform UE5ToColmap();
+
+		/** Transform applying First, then Second */
+		static FSplatTransform Compose(const FSplatTransform& First, const FSplatTransform& Second);
+
+		/** Inverse transform */
+		FSplatTransform Inverse() const;
+
+		/** Apply Q only */
+		FVector3d TransformVector(const FVector3d& V) const { return V.X * AxisX + V.Y * AxisY + V.Z * AxisZ; }
+
+		/** Apply the full transform to a point */
+		FVector3d TransformPosition(const FVector3d& P) const { return Scale * TransformVector(P) + Translation; }
+
+		/** Whether Q is a reflection (changes handedness) */
+		bool IsMirrored() const { return FVector3d::DotProduct(FVector3d::CrossProduct(AxisX, AxisY), AxisZ) < 0.0; }
+	};
+
+	/**
+	 * Rotation of real SH coefficients (bands 1-3) by an orthogonal matrix
+	 *
+	 * Rotating a splat by Q turns its color function c(d) into c(Q^T d). Each
+	 * band is closed under rotation, so the new coefficients are a linear map
+	 * of the old ones within each band (the Wigner D matrix in the 3DGS real SH
+	 * basis). The 3x3, 5x5 and 7x7 matrices are fitted once per transform by
+	 * evaluating the basis at fixed sphere directions (exact, as both sides lie
+	 * in the band), then applied to every splat.
+	 */
+	struct UNREALTOGAUSSIAN_API FSHRotation
+	{
+		/** Higher-order coefficients per channel (bands 1-3) */
+		static constexpr int32 NumCoeffs = 15;
+
+		/** Build the band matrices for the orthogonal part of a transform */
+		explicit FSHRotation(const FSplatTransform& Transform);
+
+		/** Rotate one splat's SH_Rest (channel-major, NumCoeffs per channel) in place */
+		void Apply(float* Rest) const;
+
+		/** Evaluate the 3DGS real SH basis of bands 1-3 for a unit direction */
+		static void EvaluateBasis(const FVector3d& Direction, double* OutBasis);
+
+	private:
+		/** Band matrices, row-major: new coefficient i of band l = sum_j M[i][j] * old j */
+		float Band1[3 * 3];
+		float Band2[5 * 5];
+		float Band3[7 * 7];
+
+		/** Sphere directions used to fit the band matrices */
+		static constexpr int32 NumFitDirections = 64;
+	};
+
 	/**
 	 * Specialized converter for Gaussian Splatting PLY format
 	 * Handles the specific coordinate conventions used in 3DGS training
@@ -162,5 +244,16 @@ namespace UE5_3DGS
 		 * @return Scale in meters for PLY format
 		 */
 		static FVector ConvertScaleToPLY(const FVector& UE5Scale);
+
+		/**
+		 * Apply a similarity transform to every splat in parallel
+		 * Positions, normals, rotations, log-scales and SH bands 1-3 are transformed;
+		 * mirrored transforms keep rotations proper by flipping the splat's local axes.
+		 *
+		 * @param Splats Splat buffer, transformed in place
+		 * @param Transform Similarity transform
+		 * @return True if successful
+		 */
+		static bool TransformSplats(FGaussianSplatBuffer& Splats, const FSplatTransform& Transform);
 	};
 }
@@ -0,0 +1,124 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/SpatialSort.h"
+
+class IFileHandle;
+
+namespace UE5_3DGS
+{
+	/**
+	 * Out-of-core sort settings
+	 */
+	struct UNREALTOGAUSSIAN_API FExternalSortConfig
+	{
+		/** Space-filling curve used as the sort key */
+		ESpatialCurve Curve = ESpatialCurve::Hilbert;
+
+		/** Upper bound on the buffers held at any time */
+		int64 MemoryBudgetBytes = 1ll << 30;
+
+		/** Directory for run files (empty uses the output file's directory) */
+		FString TempDirectory;
+	};
+
+	/**
+	 * What an out-of-core sort did
+	 */
+	struct UNREALTOGAUSSIAN_API FExternalSortStats
+	{
+		int64 NumRows = 0;
+
+		/** Sorted runs spilled to disk (1 when the file fit in the budget) */
+		int32 NumRuns = 0;
+
+		/** Merge passes, including the final one */
+		int32 NumMergePasses = 0;
+	};
+
+	/**
+	 * External-memory spatial sort of binary PLY files
+	 *
+	 * The input is streamed three times at most: once for the position bounds
+	 * (the curve grid must be global), once to cut it into runs that fit the
+	 * memory budget, each keyed, radix sorted and gathered in parallel and
+	 * spilled with its keys, and once more through a k-way merge into the
+	 * output. When there are more runs than the budget gives read buffers for,
+	 * intermediate merge passes combine them first. Ties keep input order, so
+	 * the result matches an in-memory FSpatialSort of the whole file.
+	 *
+	 * Rows are moved as opaque records, so any single-element binary
+	 * little-endian layout with float x/y/z works (point clouds and 3DGS files
+	 * alike); the header is copied unchanged.
+	 */
+	class UNREALTOGAUSSIAN_API FExternalSort
+	{
+	public:
+		/** Smallest read buffer of a merge input */
+		static constexpr int64 MinMergeBufferBytes = 64 * 1024;
+
+		/** Largest number of runs merged at once */
+		static constexpr int32 MaxMergeFanIn = 64;
+
+		/** Smallest accepted memory budget */
+		static constexpr int64 MinMemoryBudgetBytes = 4 * MinMergeBufferBytes;
+
+		/**
+		 * Spatially sort the vertices of a PLY file
+		 *
+		 * @param InputPath Source PLY file
+		 * @param OutputPath Sorted PLY file (must differ from InputPath)
+		 * @param Config Curve, memory budget and temp directory
+		 * @param OutStats Optional run and pass counts
+		 * @return True if successful
+		 */
+		static bool SortPlyFile(
+			const FString& InputPath,
+			const FString& OutputPath,
+			const FExternalSortConfig& Config = FExternalSortConfig(),
+			FExternalSortStats* OutStats = nullptr
+		);
+
+	private:
+		/** Spilled run: rows of (key, record), sorted by key */
+		struct FRunFile
+		{
+			FString Path;
+			int64 NumRows = 0;
+		};
+
+		/**
+		 * Bounds of the finite positions of every row, read in budget-sized blocks
+		 *
+		 * @param Input File handle positioned anywhere
+		 * @param DataOffset Offset of the first row
+		 * @param NumRows Rows to scan
+		 * @param Stride Bytes per row
+		 * @param PositionOffset Offset of x within a row (y and z follow)
+		 * @param BlockRows Rows per read
+		 * @param OutBounds Bounds
+		 * @return True if every read succeeded
+		 */
+		static bool ScanBounds(IFileHandle& Input, int64 DataOffset, int64 NumRows, int32 Stride, int32 PositionOffset, int32 BlockRows, FBox3f& OutBounds);
+
+		/** Copy the x/y/z floats of NumRows packed rows */
+		static void ExtractPositions(const uint8* Rows, int32 NumRows, int32 Stride, int32 PositionOffset, TArray<FVector3f>& OutPositions);
+
+		/**
+		 * Merge sorted runs into one stream
+		 *
+		 * @param Runs Runs to merge, in input order (ties go to the earlier run)
+		 * @param Stride Bytes per record, excluding the key
+		 * @param BudgetBytes Memory for the read and write buffers
+		 * @param Output Destination, positioned where rows go
+		 * @param bWriteKeys Keep keys in the output (intermediate runs)
+		 * @return True if successful
+		 */
+		static bool MergeRuns(const TArray<FRunFile>& Runs, int32 Stride, int64 BudgetBytes, IFileHandle& Output, bool bWriteKeys);
+
+		/** New run file path in a directory */
+		static FString MakeRunPath(const FString& Directory);
+	};
+}
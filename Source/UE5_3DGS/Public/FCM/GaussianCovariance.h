@@ -0,0 +1,56 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * Symmetric 3x3 matrix for gaussian covariances and point scatter
+	 *
+	 * A splat with log-space scale s and rotation R has covariance
+	 * R * diag(exp(2s)) * R^T; the eigen decomposition recovers s and R.
+	 */
+	struct UNREALTOGAUSSIAN_API FGaussianCovariance
+	{
+		double XX = 0.0;
+		double XY = 0.0;
+		double XZ = 0.0;
+		double YY = 0.0;
+		double YZ = 0.0;
+		double ZZ = 0.0;
+
+		/** Covariance of a splat from its log-space scale and (x, y, z, w) rotation */
+		static FGaussianCovariance FromScaleRotation(const FVector3f& LogScale, const FQuat4f& Rotation);
+
+		/** Add Weight * V * V^T */
+		void AddOuterProduct(const FVector3d& V, double Weight);
+
+		/** Add Weight * Other */
+		void AddScaled(const FGaussianCovariance& Other, double Weight);
+
+		/** Multiply every element */
+		void Scale(double Factor);
+
+		/** Determinant */
+		double Determinant() const;
+
+		/**
+		 * Eigen decomposition by cyclic Jacobi rotations
+		 *
+		 * @param OutValues Eigenvalues
+		 * @param OutVectors Unit eigenvectors matching OutValues, forming a right-handed basis
+		 */
+		void Eigen(FVector3d& OutValues, FVector3d OutVectors[3]) const;
+
+		/**
+		 * Decompose into a splat's log-space scale and rotation
+		 *
+		 * @param OutLogScale Log of the standard deviation along each axis
+		 * @param OutRotation Rotation whose X/Y/Z axes are the principal axes
+		 * @param MinVariance Variance floor for flat or degenerate covariances
+		 */
+		void ToScaleRotation(FVector3f& OutLogScale, FQuat4f& OutRotation, double MinVariance = 1e-12) const;
+	};
+}
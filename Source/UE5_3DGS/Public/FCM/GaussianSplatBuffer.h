@@ -0,0 +1,89 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE5_3DGS
+{
+	struct FGaussianSplat;
+
+	/**
+	 * Structure-of-arrays container for gaussian splats
+	 *
+	 * Stores each attribute in its own contiguous array so that a whole scene
+	 * costs a constant number of allocations and every per-attribute pass
+	 * (writing, validation, sorting, quantization) walks linear memory.
+	 *
+	 * Attribute conventions match FGaussianSplat and the 3DGS PLY layout:
+	 * - SH_Rest holds NumSHRest floats per splat in f_rest_0..f_rest_44 order
+	 * - Rotations are stored as (x, y, z, w)
+	 * - Scales are log-space
+	 */
+	struct UNREALTOGAUSSIAN_API FGaussianSplatBuffer
+	{
+		/** Higher-order SH coefficients per splat (order 3) */
+		static constexpr int32 NumSHRest = 45;
+
+		/** Positions (meters, COLMAP coordinates) */
+		TArray<FVector3f> Positions;
+
+		/** Surface normals */
+		TArray<FVector3f> Normals;
+
+		/** DC spherical harmonics coefficients */
+		TArray<FVector3f> SH_DC;
+
+		/** Higher-order SH coefficients, NumSHRest per splat (64-bit sized so large scenes do not overflow int32) */
+		TArray64<float> SH_Rest;
+
+		/** Opacity (0-1) */
+		TArray<float> Opacities;
+
+		/** Log-space ellipsoid scales */
+		TArray<FVector3f> Scales;
+
+		/** Rotation quaternions */
+		TArray<FQuat4f> Rotations;
+
+		/** Number of splats */
+		int32 Num() const { return Positions.Num(); }
+
+		/** Whether the buffer holds no splats */
+		bool IsEmpty() const { return Positions.Num() == 0; }
+
+		/** Resize all attribute arrays, initializing new splats with FGaussianSplat defaults */
+		void SetNum(int32 NumSplats);
+
+		/** Resize all attribute arrays without initializing new splats */
+		void SetNumUninitialized(int32 NumSplats);
+
+		/** Reserve capacity in all attribute arrays */
+		void Reserve(int32 NumSplats);
+
+		/** Remove all splats */
+		void Empty();
+
+		/** Append one splat */
+		int32 Add(const FGaussianSplat& Splat);
+
+		/** Higher-order SH coefficients of one splat (NumSHRest floats) */
+		float* GetSHRest(int32 Index) { return SH_Rest.GetData() + static_cast<int64>(Index) * NumSHRest; }
+		const float* GetSHRest(int32 Index) const { return SH_Rest.GetData() + static_cast<int64>(Index) * NumSHRest; }
+
+		/** Read one splat as an AoS struct */
+		FGaussianSplat GetSplat(int32 Index) const;
+
+		/** Overwrite one splat from an AoS struct */
+		void SetSplat(int32 Index, const FGaussianSplat& Splat);
+
+		/** Total heap memory used by the attribute arrays */
+		SIZE_T GetAllocatedSize() const;
+
+		/** Convert from an array of AoS splats */
+		static FGaussianSplatBuffer FromSplats(const TArray<FGaussianSplat>& Splats);
+
+		/** Convert to an array of AoS splats */
+		void ToSplats(TArray<FGaussianSplat>& OutSplats) const;
+	};
+}
@@ -0,0 +1,113 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+
+class FJsonObject;
+
+namespace UE5_3DGS
+{
+	/**
+	 * glTF export settings
+	 */
+	struct UNREALTOGAUSSIAN_API FGltfConfig
+	{
+		/** SH degree to store (0 = DC only, 3 = full) */
+		int32 SHDegree = 3;
+
+		/**
+		 * Quantize attributes with KHR_mesh_quantization
+		 * Positions become 16-bit integers dequantized by the node transform and
+		 * rotations become normalized 16-bit; SH stays float32.
+		 */
+		bool bQuantize = false;
+	};
+
+	/**
+	 * glTF 2.0 binary (.glb) writer using KHR_gaussian_splatting (ADR-007)
+	 *
+	 * Splats are written as a single POINTS primitive whose attributes follow
+	 * the KHR_gaussian_splatting draft: POSITION, COLOR_0 (RGB from DC, alpha =
+	 * opacity), KHR_gaussian_splatting:ROTATION, :SCALE (linear), :OPACITY and
+	 * :SH_DEGREE_l_COEF_n. Viewers without the extension still show points.
+	 *
+	 * Every accessor's size is known up front, so the JSON chunk is written
+	 * first and the binary chunk is streamed attribute by attribute from the
+	 * splat buffer in fixed-size blocks packed in parallel.
+	 *
+	 * Data is written in the glTF frame (right, up, back); the PLY/COLMAP
+	 * frame used elsewhere in the plugin is (right, down, forward).
+	 */
+	class UNREALTOGAUSSIAN_API FGltfWriter
+	{
+	public:
+		/** Splats packed per streamed block */
+		static constexpr int32 BlockSplats = 65536;
+
+		/**
+		 * Write gaussian splats to a .glb file
+		 *
+		 * @param FilePath Output file path
+		 * @param Splats Gaussian splat buffer (PLY/COLMAP coordinates)
+		 * @param Config Attribute and quantization settings
+		 * @return True if successful
+		 */
+		static bool WriteGlb(
+			const FString& FilePath,
+			const FGaussianSplatBuffer& Splats,
+			const FGltfConfig& Config = FGltfConfig()
+		);
+
+	private:
+		/** Packs the elements of Count splats starting at First into Out (Stride bytes each) */
+		using FAttributePacker = TFunction<void(int32 First, int32 Count, uint8* Out)>;
+
+		/** One vertex attribute: accessor description and packer */
+		struct FAttribute
+		{
+			FString Semantic;
+			int32 ComponentType = 0;
+			int32 ComponentBytes = 0;
+			int32 NumComponents = 0;
+			bool bNormalized = false;
+
+			/** Element stride, padded to 4 bytes as glTF requires for vertex attributes */
+			int32 Stride = 0;
+
+			/** Accessor bounds (POSITION only) */
+			TArray<double> Min;
+			TArray<double> Max;
+
+			FAttributePacker Pack;
+		};
+
+		/** Node transform that dequantizes positions */
+		struct FDequantization
+		{
+			FVector3d Translation = FVector3d::ZeroVector;
+			double Scale = 1.0;
+		};
+
+		/** Describe the attributes to write */
+		static void BuildAttributes(
+			const FGaussianSplatBuffer& Splats,
+			const FGltfConfig& Config,
+			TArray<FAttribute>& OutAttributes,
+			FDequantization& OutDequantization
+		);
+
+		/** Build the glTF JSON document */
+		static TSharedRef<FJsonObject> BuildDocument(
+			int32 NumSplats,
+			const FGltfConfig& Config,
+			const TArray<FAttribute>& Attributes,
+			const FDequantization& Dequantization,
+			int64 BinaryBytes
+		);
+
+		/** glTF type name for a component count */
+		static const TCHAR* GetAccessorType(int32 NumComponents);
+	};
+}
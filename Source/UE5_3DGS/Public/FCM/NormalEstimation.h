@@ -0,0 +1,69 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE5_3DGS
+{
+	class FPointKdTree;
+	struct FPointCloudPoint;
+
+	/**
+	 * Normal estimation settings
+	 */
+	struct UNREALTOGAUSSIAN_API FNormalEstimationConfig
+	{
+		/** Neighbours fitted per point (the point itself is included in the fit) */
+		int32 NumNeighbors = 16;
+
+		/** Capture positions (point coordinates); each normal is flipped to face the nearest one */
+		TArray<FVector3f> ViewPositions;
+	};
+
+	/**
+	 * PCA normal estimation for point clouds
+	 *
+	 * Each point's neighbourhood (K nearest from a shared FPointKdTree) is
+	 * reduced to its scatter matrix; the eigenvector of the smallest eigenvalue
+	 * is the normal of the best-fit plane. The sign is ambiguous, so normals are
+	 * oriented towards the nearest capture position, found through a second
+	 * k-d tree over the views. Points run in parallel batches.
+	 */
+	class UNREALTOGAUSSIAN_API FNormalEstimator
+	{
+	public:
+		/**
+		 * Estimate normals with an existing spatial index
+		 * Points whose neighbourhood is degenerate (too few or coincident neighbours) keep their normal.
+		 *
+		 * @param Positions Point positions
+		 * @param Tree K-d tree built over Positions
+		 * @param Config Neighbourhood size and view positions
+		 * @param InOutNormals One normal per position, overwritten where estimated
+		 * @param OutNumEstimated Optional number of normals estimated
+		 * @return True if successful
+		 */
+		static bool EstimateNormals(
+			const TArray<FVector3f>& Positions,
+			const FPointKdTree& Tree,
+			const FNormalEstimationConfig& Config,
+			TArray<FVector3f>& InOutNormals,
+			int32* OutNumEstimated = nullptr
+		);
+
+		/**
+		 * Estimate the normals of a point cloud in place (builds its own index)
+		 *
+		 * @param Points Point cloud; Normal is overwritten where estimated
+		 * @param Config Neighbourhood size and view positions
+		 * @param OutNumEstimated Optional number of normals estimated
+		 * @return True if successful
+		 */
+		static bool EstimateNormals(
+			TArray<FPointCloudPoint>& Points,
+			const FNormalEstimationConfig& Config,
+			int32* OutNumEstimated = nullptr
+		);
+	};
+}
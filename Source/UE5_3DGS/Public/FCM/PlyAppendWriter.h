@@ -0,0 +1,136 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/PlyWriter.h"
+
+class IFileHandle;
+
+namespace UE5_3DGS
+{
+	/**
+	 * Row layout of an append-mode PLY file
+	 */
+	enum class EPlyAppendLayout : uint8
+	{
+		/** x, y, z, nx, ny, nz (float) + red, green, blue (uchar), 27 bytes per point */
+		PointCloud,
+
+		/** Full 3DGS layout, FPlyWriter::BytesPerGaussianSplat bytes per splat */
+		GaussianSplat
+	};
+
+	/**
+	 * Incremental binary PLY writer
+	 *
+	 * Writes the header with a fixed-width, zero-padded vertex count, appends
+	 * batches of rows as they are produced, and patches the count in place on
+	 * Close. Nothing but the current block of packed rows is held in memory, so
+	 * the output size is bounded by disk space only.
+	 *
+	 * Every CheckpointVertices rows the data is flushed to disk and then the
+	 * count is patched, in that order, so the file on disk is always a valid PLY
+	 * holding at least every checkpointed row. Recover() extends the count of
+	 * an interrupted file to all complete rows.
+	 */
+	class UNREALTOGAUSSIAN_API FPlyAppendWriter
+	{
+	public:
+		/** Width of the zero-padded vertex count field */
+		static constexpr int32 CountDigits = 10;
+
+		/** Largest vertex count the header parser accepts (fits the 10-digit field) */
+		static constexpr int64 MaxVertices = MAX_int32;
+
+		/** Bytes per point of the point cloud layout */
+		static constexpr int32 BytesPerPoint = 27;
+
+		/** Rows packed per write */
+		static constexpr int32 RowsPerBlock = 65536;
+
+		FPlyAppendWriter();
+
+		/** Finalizes the file if it is still open */
+		~FPlyAppendWriter();
+
+		/**
+		 * Create the file and write its header
+		 *
+		 * @param FilePath Output file path
+		 * @param Layout Row layout
+		 * @param CheckpointVertices Rows between checkpoints (0 checkpoints only on Flush and Close)
+		 * @return True if successful
+		 */
+		bool Open(const FString& FilePath, EPlyAppendLayout Layout, int64 CheckpointVertices = 1 << 20);
+
+		/**
+		 * Append points (point cloud layout)
+		 *
+		 * @param Points Points to append
+		 * @param NumPoints Number of points
+		 * @return True if successful
+		 */
+		bool Append(const FPointCloudPoint* Points, int32 NumPoints);
+
+		bool Append(const TArray<FPointCloudPoint>& Points) { return Append(Points.GetData(), Points.Num()); }
+
+		/**
+		 * Append splats (gaussian layout)
+		 *
+		 * @param Splats Splats to append
+		 * @return True if successful
+		 */
+		bool Append(const FGaussianSplatBuffer& Splats);
+
+		/** Flush appended rows to disk and patch the count (a checkpoint) */
+		bool Flush();
+
+		/**
+		 * Checkpoint and close the file
+		 *
+		 * @return True if every write succeeded
+		 */
+		bool Close();
+
+		bool IsOpen() const { return FileHandle.IsValid(); }
+
+		/** Rows appended so far */
+		int64 GetNumVertices() const { return NumVertices; }
+
+		/**
+		 * Repair the vertex count of an interrupted file
+		 * Sets the count to the number of complete rows on disk; a trailing partial
+		 * row is left in place and ignored by readers. Only files written by this
+		 * class (fixed-width count, single binary element) can be recovered.
+		 *
+		 * @param FilePath PLY file path
+		 * @param OutNumVertices Optional recovered row count
+		 * @return True if the file now has a valid count
+		 */
+		static bool Recover(const FString& FilePath, int64* OutNumVertices = nullptr);
+
+	private:
+		/** Pack and write NumRows rows in blocks of RowsPerBlock */
+		bool AppendRows(int32 NumRows, TFunctionRef<void(int32 RowIndex, uint8* OutRow)> PackRow);
+
+		/** Overwrite the count field, then restore the write position */
+		bool WriteCount(int64 Count);
+
+		/** Byte offset of the count digits in a header ("element vertex <digits>\n"), INDEX_NONE if absent */
+		static int64 FindCountOffset(const ANSICHAR* Header, int64 HeaderLength);
+
+		FString Path;
+		TUniquePtr<IFileHandle> FileHandle;
+		EPlyAppendLayout Layout = EPlyAppendLayout::PointCloud;
+		int32 BytesPerRow = 0;
+		int64 CountOffset = 0;
+		int64 NumVertices = 0;
+		int64 CheckpointInterval = 0;
+		int64 NumSinceCheckpoint = 0;
+		bool bError = false;
+
+		/** Packed rows of the current block, reused across appends */
+		TArray<uint8> Block;
+	};
+}
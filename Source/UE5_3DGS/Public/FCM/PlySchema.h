@@ -0,0 +1,272 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ByteSwap.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * PLY data section encoding
+	 */
+	enum class EPlyFormat : uint8
+	{
+		Ascii,
+		BinaryLittleEndian,
+		BinaryBigEndian
+	};
+
+	/**
+	 * PLY scalar property types
+	 */
+	enum class EPlyPropertyType : uint8
+	{
+		Int8,
+		UInt8,
+		Int16,
+		UInt16,
+		Int32,
+		UInt32,
+		Float32,
+		Float64
+	};
+
+	/**
+	 * Single property of a PLY element
+	 */
+	struct UNREALTOGAUSSIAN_API FPlyProperty
+	{
+		/** Property name (e.g. "x", "f_dc_0") */
+		FString Name;
+
+		/** Scalar type (item type for list properties) */
+		EPlyPropertyType Type = EPlyPropertyType::Float32;
+
+		/** Whether this is a variable-length list property */
+		bool bIsList = false;
+
+		/** Type of the list length prefix (list properties only) */
+		EPlyPropertyType ListCountType = EPlyPropertyType::UInt8;
+
+		/** Byte offset within a binary element record (INDEX_NONE after a list property) */
+		int32 Offset = INDEX_NONE;
+	};
+
+	/**
+	 * PLY element declaration (e.g. "element vertex 1000")
+	 */
+	struct UNREALTOGAUSSIAN_API FPlyElement
+	{
+		/** Element name */
+		FString Name;
+
+		/** Number of records */
+		int64 Count = 0;
+
+		/** Properties in declaration order */
+		TArray<FPlyProperty> Properties;
+
+		/** Bytes per binary record, or INDEX_NONE if the element contains list properties */
+		int32 Stride = 0;
+
+		/** Whether records have a fixed binary size */
+		bool HasFixedStride() const { return Stride != INDEX_NONE; }
+
+		/** Find a property by name, INDEX_NONE if absent */
+		int32 FindProperty(const FString& PropertyName) const;
+	};
+
+	/**
+	 * Parsed PLY header
+	 */
+	struct UNREALTOGAUSSIAN_API FPlySchema
+	{
+		/** Data section encoding */
+		EPlyFormat Format = EPlyFormat::Ascii;
+
+		/** Elements in file order */
+		TArray<FPlyElement> Elements;
+
+		/** Byte offset of the data section (first byte after "end_header") */
+		int64 DataOffset = 0;
+
+		/** Whether the data section is binary */
+		bool IsBinary() const { return Format != EPlyFormat::Ascii; }
+
+		/** Find an element by name, INDEX_NONE if absent */
+		int32 FindElement(const FString& ElementName) const;
+
+		/**
+		 * Byte offset of an element's first record in a binary file
+		 * Only valid when all preceding elements have a fixed stride.
+		 *
+		 * @param ElementIndex Index into Elements
+		 * @return Absolute byte offset, or INDEX_NONE if it cannot be computed
+		 */
+		int64 GetBinaryElementOffset(int32 ElementIndex) const;
+
+		/**
+		 * Locate rows of an ASCII data section
+		 * Line boundaries are found in parallel chunks and merged with a prefix sum.
+		 *
+		 * @param Data Start of the file
+		 * @param Size File size in bytes
+		 * @param FirstRow Index of the first wanted line after the header
+		 * @param NumRows Number of rows wanted
+		 * @param OutRowStarts Byte offset of each row found
+		 * @return Number of rows found (less than NumRows if the file is truncated)
+		 */
+		int32 FindAsciiRows(const uint8* Data, int64 Size, int64 FirstRow, int32 NumRows, TArray<int64>& OutRowStarts) const;
+
+		/**
+		 * Parse a PLY header from raw file bytes
+		 *
+		 * @param Data Start of the file
+		 * @param Size Number of bytes available
+		 * @param OutSchema Parsed schema
+		 * @return True if a complete, well-formed header was found
+		 */
+		static bool Parse(const uint8* Data, int64 Size, FPlySchema& OutSchema);
+
+		/** Size of a scalar property type in bytes */
+		static int32 GetTypeSize(EPlyPropertyType Type);
+
+		/** Parse a PLY type name ("float", "uchar", "float32", ...) */
+		static bool ParseTypeName(const FString& TypeName, EPlyPropertyType& OutType);
+	};
+
+	/**
+	 * One step of a compiled decode plan
+	 */
+	struct FPlyDecodeOp
+	{
+		/** Byte offset within a binary record, or column index within an ASCII row */
+		int32 Offset = 0;
+
+		/** Destination slot chosen by the caller */
+		int32 Target = 0;
+
+		/** Stored scalar type */
+		EPlyPropertyType Type = EPlyPropertyType::Float32;
+	};
+
+	/**
+	 * Compiled decoder for the records of one PLY element
+	 *
+	 * The header is resolved once into a flat list of (offset, type, target slot)
+	 * operations. Decoding a record then runs that list with no name lookups;
+	 * properties the caller does not map are skipped by the record stride.
+	 * Any scalar type and either byte order are converted to double on the fly.
+	 */
+	struct UNREALTOGAUSSIAN_API FPlyDecodePlan
+	{
+		/** Operations in record order */
+		TArray<FPlyDecodeOp> Ops;
+
+		/** Bytes per binary record */
+		int32 Stride = 0;
+
+		/** Whether binary values must be byte-swapped to host order */
+		bool bSwapBytes = false;
+
+		/** Whether the plan decodes ASCII rows (Offset is a column index) */
+		bool bAscii = false;
+
+		/** Number of ASCII columns per row that precede any list property */
+		int32 NumColumns = 0;
+
+		/**
+		 * Compile a decode plan for one element
+		 *
+		 * @param Schema Parsed PLY header
+		 * @param ElementIndex Element to decode
+		 * @param ResolveTarget Maps a property to a destination slot, or INDEX_NONE to skip it
+		 * @param OutPlan Compiled plan
+		 * @return False if a mapped property cannot be located (e.g. it follows a list property)
+		 */
+		static bool Compile(
+			const FPlySchema& Schema,
+			int32 ElementIndex,
+			TFunctionRef<int32(const FPlyProperty& Property)> ResolveTarget,
+			FPlyDecodePlan& OutPlan
+		);
+
+		/** Whether the plan maps any property to Target */
+		bool HasTarget(int32 Target) const;
+
+		/** Decode one binary record into OutSlots (only mapped slots are written) */
+		FORCEINLINE void DecodeBinary(const uint8* Record, double* OutSlots) const
+		{
+			for (const FPlyDecodeOp& Op : Ops)
+			{
+				OutSlots[Op.Target] = ReadScalar(Record + Op.Offset, Op.Type, bSwapBytes);
+			}
+		}
+
+		/**
+		 * Decode one ASCII row into OutSlots
+		 * Unmapped columns are skipped; columns missing from a short row keep their slot value.
+		 *
+		 * @param Row First byte of the row
+		 * @param End End of the data (rows stop earlier at their newline)
+		 * @param OutSlots Destination slots
+		 */
+		void DecodeAscii(const uint8* Row, const uint8* End, double* OutSlots) const;
+
+		/**
+		 * Parse one ASCII number without allocating
+		 *
+		 * @param Cursor First character of the token
+		 * @param End End of the data
+		 * @param OutValue Parsed value
+		 * @return Position after the number, or nullptr if the token is not a number
+		 */
+		static const uint8* ParseAsciiNumber(const uint8* Cursor, const uint8* End, double& OutValue);
+
+		/** Read one binary scalar as double */
+		static FORCEINLINE double ReadScalar(const uint8* Data, EPlyPropertyType Type, bool bSwap)
+		{
+			switch (Type)
+			{
+			case EPlyPropertyType::Int8:
+				return static_cast<int8>(*Data);
+			case EPlyPropertyType::UInt8:
+				return *Data;
+			case EPlyPropertyType::Int16:
+				return static_cast<int16>(LoadBits<uint16>(Data, bSwap));
+			case EPlyPropertyType::UInt16:
+				return LoadBits<uint16>(Data, bSwap);
+			case EPlyPropertyType::Int32:
+				return static_cast<int32>(LoadBits<uint32>(Data, bSwap));
+			case EPlyPropertyType::UInt32:
+				return LoadBits<uint32>(Data, bSwap);
+			case EPlyPropertyType::Float32:
+			{
+				const uint32 Bits = LoadBits<uint32>(Data, bSwap);
+				float Value;
+				FMemory::Memcpy(&Value, &Bits, sizeof(float));
+				return Value;
+			}
+			case EPlyPropertyType::Float64:
+			{
+				const uint64 Bits = LoadBits<uint64>(Data, bSwap);
+				double Value;
+				FMemory::Memcpy(&Value, &Bits, sizeof(double));
+				return Value;
+			}
+			default:
+				return 0.0;
+			}
+		}
+
+	private:
+		template <typename T>
+		static FORCEINLINE T LoadBits(const uint8* Data, bool bSwap)
+		{
+			T Bits;
+			FMemory::Memcpy(&Bits, Data, sizeof(T));
+			return bSwap ? ByteSwap(Bits) : Bits;
+		}
+	};
+}
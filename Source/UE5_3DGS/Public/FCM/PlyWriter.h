@@ -3,13 +3,22 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+#include "FCM/PlySchema.h"
+#include "FCM/SpatialSort.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
 
 namespace UE5_3DGS
 {
+	struct FSHCodebook;
+	struct FSHDegreeReduction;
+
 	/**
 	 * Gaussian splat data for PLY export
 	 *
-	 * PLY format for 3DGS (236 bytes per splat):
+	 * PLY format for 3DGS (248 bytes per splat):
 	 * - Position: x, y, z (float32 x 3 = 12 bytes)
 	 * - Normal: nx, ny, nz (float32 x 3 = 12 bytes)
 	 * - DC SH coefficients: f_dc_0, f_dc_1, f_dc_2 (float32 x 3 = 12 bytes)
@@ -29,8 +38,8 @@ namespace UE5_3DGS
 		/** DC spherical harmonics coefficients (RGB color base) */
 		FVector SH_DC = FVector(0.5f, 0.5f, 0.5f);
 
-		/** Higher-order SH coefficients (45 values for order 3) */
-		TArray<float> SH_Rest;
+		/** Higher-order SH coefficients (45 values for order 3, stored inline) */
+		TArray<float, TFixedAllocator<45>> SH_Rest;
 
 		/** Opacity (0-1) */
 		float Opacity = 1.0f;
@@ -74,17 +83,49 @@ namespace UE5_3DGS
 		FColor Color = FColor::White;
 	};
 
+	/**
+	 * Gaussian splat PLY export settings
+	 */
+	struct UNREALTOGAUSSIAN_API FPlyExportOptions
+	{
+		/** Write binary PLY (smaller, faster) */
+		bool bBinary = true;
+
+		/**
+		 * Order splats along a space-filling curve before writing
+		 * Spatially sorted files compress better and stream with better locality.
+		 */
+		ESpatialCurve SpatialOrder = ESpatialCurve::None;
+	};
+
 	/**
 	 * PLY writer for 3D Gaussian Splatting formats
 	 *
 	 * Supports:
 	 * - Input PLY (point cloud for initialization)
 	 * - Output PLY (full gaussian splats after training)
-	 * - SPZ compressed format (90% size reduction)
+	 *
+	 * SPZ compressed export (~90% size reduction) is provided by FSpzWriter.
 	 */
 	class UNREALTOGAUSSIAN_API FPlyWriter
 	{
 	public:
+		/** Bytes per splat in the binary 3DGS PLY layout written by this class (62 float32 properties) */
+		static constexpr int32 BytesPerGaussianSplat = 248;
+
+		/** Float properties per splat in the standard 3DGS PLY layout */
+		static constexpr int32 NumGaussianProperties = BytesPerGaussianSplat / sizeof(float);
+
+		/** Bytes per vertex in the SH codebook layout (17 float32 properties plus a ushort index) */
+		static constexpr int32 BytesPerCodebookSplat = (NumGaussianProperties - FGaussianSplatBuffer::NumSHRest) * sizeof(float) + sizeof(uint16);
+
+		/** Splats serialized per chunk by the streaming binary writer (~4 MB reusable buffer) */
+		static constexpr int32 BinaryWriteChunkSplats = 16384;
+
+		/** Initial and maximum number of bytes read when probing a PLY header */
+		static constexpr int32 HeaderProbeBytes = 4096;
+		static constexpr int32 MaxHeaderBytes = 1 << 20;
+
 		/**
 		 * Write point cloud PLY for 3DGS training initialization
 		 *
@@ -113,6 +154,73 @@ namespace UE5_3DGS
 			bool bBinary = true
 		);
 
+		/**
+		 * Write full gaussian splats PLY from a structure-of-arrays buffer
+		 *
+		 * @param FilePath Output file path
+		 * @param Splats Gaussian splat buffer
+		 * @param bBinary Write binary PLY
+		 * @return True if successful
+		 */
+		static bool WriteGaussianSplats(
+			const FString& FilePath,
+			const FGaussianSplatBuffer& Splats,
+			bool bBinary = true
+		);
+
+		/**
+		 * Write full gaussian splats PLY with export options
+		 * Splats are written in the requested order without copying the buffer.
+		 *
+		 * @param FilePath Output file path
+		 * @param Splats Gaussian splat buffer
+		 * @param Options Format and ordering settings
+		 * @param OutPermutation Optional source splat index of each written vertex
+		 * @return True if successful
+		 */
+		static bool WriteGaussianSplats(
+			const FString& FilePath,
+			const FGaussianSplatBuffer& Splats,
+			const FPlyExportOptions& Options,
+			TArray<int32>* OutPermutation = nullptr
+		);
+
+		/**
+		 * Write gaussian splats PLY with vector-quantized SH (binary)
+		 * Each vertex stores a ushort "sh_index" in place of f_rest_*; the SH vectors
+		 * are stored once in a trailing "sh_codebook" element. ReadGaussianSplats
+		 * expands them back into SH_Rest.
+		 *
+		 * @param FilePath Output file path
+		 * @param Splats Gaussian splat buffer
+		 * @param Codebook SH codebook built for Splats
+		 * @return True if successful
+		 */
+		static bool WriteGaussianSplats(
+			const FString& FilePath,
+			const FGaussianSplatBuffer& Splats,
+			const FSHCodebook& Codebook
+		);
+
+		/**
+		 * Write gaussian splats PLY bucketed by SH degree (binary)
+		 * Splats are grouped into one element per degree, "vertex_sh0".."vertex_sh3",
+		 * each storing only the f_rest_* of the bands it keeps. ReadGaussianSplats
+		 * reads the buckets back in order with the dropped bands zeroed.
+		 *
+		 * @param FilePath Output file path
+		 * @param Splats Gaussian splat buffer
+		 * @param Reduction Per-splat SH degrees built for Splats
+		 * @param OutPermutation Optional source splat index of each written vertex
+		 * @return True if successful
+		 */
+		static bool WriteGaussianSplats(
+			const FString& FilePath,
+			const FGaussianSplatBuffer& Splats,
+			const FSHDegreeReduction& Reduction,
+			TArray<int32>* OutPermutation = nullptr
+		);
+
 		/**
 		 * Create point cloud from mesh vertices
 		 *
@@ -129,19 +237,38 @@ namespace UE5_3DGS
 
 		/**
 		 * Create initial gaussian splats from point cloud
-		 * Initializes splats with reasonable defaults for training
+		 * Initializes splats with reasonable defaults for training. As in reference 3DGS,
+		 * each splat's isotropic scale is the RMS distance to its nearest neighbours.
 		 *
 		 * @param Points Point cloud data
-		 * @param InitialScale Initial gaussian scale (log-space)
+		 * @param InitialScale Gaussian scale (log-space) used when neighbours are not estimated or not found
+		 * @param NumScaleNeighbors Neighbours averaged for the scale (0 gives every splat InitialScale)
 		 * @return Array of initialized gaussian splats
 		 */
 		static TArray<FGaussianSplat> CreateSplatsFromPointCloud(
 			const TArray<FPointCloudPoint>& Points,
-			float InitialScale = -5.0f
+			float InitialScale = -5.0f,
+			int32 NumScaleNeighbors = 3
+		);
+
+		/**
+		 * Create initial gaussian splats from point cloud into a structure-of-arrays buffer
+		 *
+		 * @param Points Point cloud data
+		 * @param InitialScale Gaussian scale (log-space) used when neighbours are not estimated or not found
+		 * @param NumScaleNeighbors Neighbours averaged for the scale (0 gives every splat InitialScale)
+		 * @return Buffer of initialized gaussian splats
+		 */
+		static FGaussianSplatBuffer CreateSplatBufferFromPointCloud(
+			const TArray<FPointCloudPoint>& Points,
+			float InitialScale = -5.0f,
+			int32 NumScaleNeighbors = 3
 		);
 
 		/**
 		 * Read PLY file (point cloud format)
+		 * Accepts any vertex layout: properties may appear in any order with any scalar type,
+		 * in ASCII or either binary byte order. Unknown properties are skipped.
 		 *
 		 * @param FilePath Input file path
 		 * @param OutPoints Output point cloud
@@ -164,6 +291,20 @@ namespace UE5_3DGS
 			TArray<FGaussianSplat>& OutSplats
 		);
 
+		/**
+		 * Read gaussian splats PLY into a structure-of-arrays buffer
+		 * The file is memory-mapped and decoded straight from the mapped pages.
+		 * Files with fewer SH bands are expanded, missing properties take FGaussianSplat defaults.
+		 *
+		 * @param FilePath Input file path
+		 * @param OutSplats Output splat buffer
+		 * @return True if successful
+		 */
+		static bool ReadGaussianSplats(
+			const FString& FilePath,
+			FGaussianSplatBuffer& OutSplats
+		);
+
 		/**
 		 * Get PLY file statistics
 		 *
@@ -180,6 +321,18 @@ namespace UE5_3DGS
 			bool& OutIsGaussian
 		);
 
+		/**
+		 * Read only the header of a PLY file
+		 * Starts with a small read and grows it until end_header is found, so the
+		 * cost does not depend on the size of the data section. Holds no shared
+		 * state and may be called concurrently on many files.
+		 *
+		 * @param FilePath PLY file path
+		 * @param OutSchema Elements, properties, per-element strides and data offset
+		 * @return True if a complete, well-formed header was read
+		 */
+		static bool ReadPlyHeader(const FString& FilePath, FPlySchema& OutSchema);
+
 		/**
 		 * Estimate memory usage for gaussian splats
 		 *
@@ -200,16 +353,124 @@ namespace UE5_3DGS
 			TArray<FString>& OutWarnings
 		);
 
+		/**
+		 * Validate a splat buffer for training
+		 *
+		 * @param Splats Splat buffer to validate
+		 * @param OutWarnings Output warnings
+		 * @return True if valid
+		 */
+		static bool ValidateSplats(
+			const FGaussianSplatBuffer& Splats,
+			TArray<FString>& OutWarnings
+		);
+
+		/** Fill the NumGaussianProperties floats of one splat in PLY row order */
+		static void GatherGaussianRow(const FGaussianSplatBuffer& Splats, int32 Index, float* OutRow);
+
+		/** Store one PLY row of NumGaussianProperties floats into a splat (inverse of GatherGaussianRow) */
+		static void ScatterGaussianRow(FGaussianSplatBuffer& Splats, int32 Index, const float* Row);
+
 	private:
+		friend class FPlyAppendWriter;
+
 		// PLY format helpers
 		static FString GeneratePointCloudHeader(int32 NumPoints, bool bBinary);
 		static FString GenerateGaussianHeader(int32 NumSplats, bool bBinary);
 
 		static bool WritePointCloudBinary(const FString& FilePath, const TArray<FPointCloudPoint>& Points);
 		static bool WritePointCloudASCII(const FString& FilePath, const TArray<FPointCloudPoint>& Points);
-		static bool WriteGaussianBinary(const FString& FilePath, const TArray<FGaussianSplat>& Splats);
-		static bool WriteGaussianASCII(const FString& FilePath, const TArray<FGaussianSplat>& Splats);
 
-		static bool ParsePlyHeader(const FString& Content, int32& OutNumVertices, bool& OutIsBinary, TArray<FString>& OutProperties);
+		/** Fills the NumGaussianProperties PLY vertex properties of one splat, in header order */
+		using FGaussianRowGatherer = TFunctionRef<void(int32 SplatIndex, float* OutRow)>;
+
+		static bool WriteGaussianBinary(const FString& FilePath, int32 NumSplats, FGaussianRowGatherer GatherRow);
+		static bool WriteGaussianASCII(const FString& FilePath, int32 NumSplats, FGaussianRowGatherer GatherRow);
+
+		/** Formats one row at Cursor (including the newline) and returns the new end of text */
+		using FAsciiRowFormatter = TFunctionRef<ANSICHAR*(int32 RowIndex, ANSICHAR* Cursor)>;
+
+		/**
+		 * Write a PLY file whose rows are formatted in parallel blocks
+		 * Each worker formats a contiguous row range into its own UTF-8 buffer; buffers
+		 * are flushed in order, a bounded number of blocks at a time.
+		 */
+		static bool WriteAsciiPly(const FString& FilePath, const FString& Header, int32 NumRows, int32 MaxRowChars, FAsciiRowFormatter FormatRow);
+
+		/** Append a float in round-trip form (shortest where the standard library supports it) */
+		static ANSICHAR* AppendAsciiFloat(ANSICHAR* Cursor, float Value);
+
+		/** Append an integer */
+		static ANSICHAR* AppendAsciiInt(ANSICHAR* Cursor, int32 Value);
+
+		/** Longest text AppendAsciiFloat can produce */
+		static constexpr int32 MaxAsciiFloatChars = 16;
+
+		static void GatherGaussianRow(const FGaussianSplat& Splat, float* OutRow);
+
+		/** Log-scale per point from the mean squared distance to its nearest neighbours (k-d tree, parallel) */
+		static void EstimateInitialScales(const TArray<FPointCloudPoint>& Points, int32 NumNeighbors, float FallbackScale, TArray<float>& OutLogScales);
+
+		/** Vertex property names of the gaussian layout, in row order */
+		static const TArray<FString>& GetGaussianPropertyNames();
+
+		/** Header for the SH codebook layout */
+		static FString GenerateGaussianCodebookHeader(int32 NumSplats, int32 NumEntries);
+
+		/** Element name prefix of the degree-bucketed layout ("vertex_sh<d>") */
+		static constexpr const TCHAR* DegreeElementPrefix = TEXT("vertex_sh");
+
+		/** Header for the degree-bucketed layout */
+		static FString GenerateGaussianDegreeHeader(const int32* NumPerDegree);
+
+		/** Compile a decode plan mapping vertex properties to gaussian row slots */
+		static bool CompileGaussianPlan(const FPlySchema& Schema, int32 VertexElementIndex, FPlyDecodePlan& OutPlan);
+
+		/** Decode slots for point cloud vertex properties */
+		enum EPointCloudSlot : int32
+		{
+			PointSlot_X, PointSlot_Y, PointSlot_Z,
+			PointSlot_NX, PointSlot_NY, PointSlot_NZ,
+			PointSlot_Red, PointSlot_Green, PointSlot_Blue, PointSlot_Alpha,
+			PointSlot_Count
+		};
+
+		/** Map a vertex property name to a point cloud slot (INDEX_NONE if unused) */
+		static int32 GetPointCloudSlot(const FString& PropertyName);
+
+		/** Build a point from decoded slots, scaling color slots by their source type range */
+		static void ApplyPointCloudSlots(const double* Slots, const double* ColorScales, FPointCloudPoint& OutPoint);
+
+		/** Memory-mapped PLY file with its parsed header */
+		struct FMappedPlyFile
+		{
+			TUniquePtr<IMappedFileHandle> Handle;
+			TUniquePtr<IMappedFileRegion> Region;
+			const uint8* Data = nullptr;
+			int64 Size = 0;
+			FPlySchema Schema;
+
+			~FMappedPlyFile();
+		};
+
+		/** Map a PLY file and parse its header */
+		static bool MapPlyFile(const FString& FilePath, FMappedPlyFile& OutFile);
+
+		/** Decode one gaussian element into OutSplats starting at FirstSplat */
+		static bool DecodeGaussianElement(const FMappedPlyFile& File, int32 ElementIndex, const FString& FilePath, FGaussianSplatBuffer& OutSplats, int32 FirstSplat);
+
+		/** Expand "sh_index" vertices through the "sh_codebook" element into SH_Rest */
+		static bool DecodeSHCodebook(const FMappedPlyFile& File, int32 VertexElementIndex, int32 CodebookElementIndex, FGaussianSplatBuffer& OutSplats);
+
+		// Validation helpers
+		static bool IsValidSplatPosition(const FVector3f& Position);
+		static bool AppendValidationWarnings(
+			int32 NumSplats,
+			int32 InvalidPos,
+			int32 InvalidOpacity,
+			int32 InvalidScale,
+			int32 InvalidRotation,
+			TArray<FString>& OutWarnings
+		);
 	};
 }
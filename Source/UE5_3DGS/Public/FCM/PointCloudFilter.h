@@ -0,0 +1,136 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE5_3DGS
+{
+	struct FPointCloudPoint;
+
+	/**
+	 * Voxel-grid downsampling settings
+	 */
+	struct UNREALTOGAUSSIAN_API FVoxelDownsampleConfig
+	{
+		/** Voxel edge length (point units); the smallest voxel used when a target is set */
+		float VoxelSize = 0.01f;
+
+		/** Largest number of output points (0 keeps VoxelSize as given) */
+		int32 TargetPoints = 0;
+
+		/** Bisection steps of the voxel size search */
+		int32 MaxSearchIterations = 24;
+	};
+
+	/**
+	 * Outlier removal settings
+	 */
+	struct UNREALTOGAUSSIAN_API FOutlierRemovalConfig
+	{
+		/** Neighbours of the statistical test (0 disables it) */
+		int32 NumNeighbors = 16;
+
+		/** Points whose mean neighbour distance exceeds the cloud mean by this many standard deviations are removed */
+		float StdDevMultiplier = 2.0f;
+
+		/** Radius of the radius test (0 disables it) */
+		float Radius = 0.0f;
+
+		/** Points with fewer neighbours within Radius are removed */
+		int32 MinRadiusNeighbors = 4;
+	};
+
+	/**
+	 * What an outlier removal pass removed
+	 */
+	struct UNREALTOGAUSSIAN_API FOutlierRemovalStats
+	{
+		int32 NumInput = 0;
+
+		/** Removed for a non-finite position */
+		int32 NumInvalid = 0;
+
+		/** Removed by the statistical test */
+		int32 NumStatistical = 0;
+
+		/** Removed by the radius test (and not already by the statistical one) */
+		int32 NumRadius = 0;
+
+		int32 NumOutput = 0;
+
+		/** Log a one-line summary */
+		void Log() const;
+	};
+
+	/**
+	 * Point cloud reduction passes run before PLY export
+	 *
+	 * Voxel downsampling keys each point by its voxel's Morton code, radix sorts
+	 * the keys (FSpatialSort) and averages position, color and normal over each
+	 * run of equal keys in parallel, so the output comes out in Z-order. With a
+	 * target point budget the voxel size is found by bisection in log space
+	 * over the key and sort passes alone.
+	 *
+	 * Outlier removal answers both of its tests from one K-nearest query per
+	 * point on a shared FPointKdTree: the statistical test uses the mean
+	 * neighbour distance, and a point passes the radius test exactly when its
+	 * MinRadiusNeighbors-th nearest neighbour lies within Radius.
+	 */
+	class UNREALTOGAUSSIAN_API FPointCloudFilter
+	{
+	public:
+		/** Voxels per axis the keys can address */
+		static constexpr int32 MaxVoxelsPerAxis = (1 << 21) - 1;
+
+		/**
+		 * Replace the points of each occupied voxel by their average
+		 * Non-finite points are dropped.
+		 *
+		 * @param Points Source points
+		 * @param Config Voxel size and optional point budget
+		 * @param OutPoints One point per occupied voxel, in Morton order
+		 * @param OutVoxelSize Optional voxel size used
+		 * @return True if successful
+		 */
+		static bool VoxelDownsample(
+			const TArray<FPointCloudPoint>& Points,
+			const FVoxelDownsampleConfig& Config,
+			TArray<FPointCloudPoint>& OutPoints,
+			float* OutVoxelSize = nullptr
+		);
+
+		/**
+		 * Remove statistical and radius outliers
+		 * Both tests are evaluated on the input cloud; survivors keep their order.
+		 *
+		 * @param Points Source points
+		 * @param Config Test settings
+		 * @param OutPoints Surviving points
+		 * @param OutStats Removal counts
+		 * @return True if successful
+		 */
+		static bool RemoveOutliers(
+			const TArray<FPointCloudPoint>& Points,
+			const FOutlierRemovalConfig& Config,
+			TArray<FPointCloudPoint>& OutPoints,
+			FOutlierRemovalStats& OutStats
+		);
+
+	private:
+		/** Per-point outcome of the outlier tests */
+		enum class EOutlierReason : uint8
+		{
+			Keep,
+			Invalid,
+			Statistical,
+			Radius
+		};
+
+		/** Sorted Morton keys of the voxel of every position */
+		static void ComputeVoxelKeys(const TArray<FVector3f>& Positions, const FVector3f& Origin, float VoxelSize, TArray<uint64>& OutKeys, TArray<int32>& OutOrder);
+
+		/** Number of distinct keys in a sorted array */
+		static int32 CountDistinct(const TArray<uint64>& SortedKeys);
+	};
+}
@@ -0,0 +1,78 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * Static k-d tree over a point set for nearest neighbour queries
+	 *
+	 * The tree is implicit: points are permuted so that every node's median sits
+	 * in the middle of its index range, split along the node's longest axis.
+	 * It is built one level at a time, with the nodes of a level partitioned in
+	 * parallel (nth_element), and stores a copy of the points in tree order so
+	 * queries walk contiguous memory. Queries are read-only and may run
+	 * concurrently from any number of threads.
+	 */
+	class UNREALTOGAUSSIAN_API FPointKdTree
+	{
+	public:
+		/** Ranges of at most this many points are scanned instead of split */
+		static constexpr int32 LeafSize = 12;
+
+		/** Largest K accepted by FindNearest */
+		static constexpr int32 MaxNeighbors = 64;
+
+		/**
+		 * Build the tree (non-finite points are left out)
+		 *
+		 * @param Points Points to index; queries return indices into this array
+		 */
+		void Build(const TArray<FVector3f>& Points);
+
+		/** Number of indexed points */
+		int32 Num() const { return Indices.Num(); }
+
+		/**
+		 * Find the K nearest points to a position
+		 *
+		 * @param Query Query position
+		 * @param K Number of neighbours (at most MaxNeighbors)
+		 * @param OutIndices K point indices, nearest first
+		 * @param OutDistancesSquared K squared distances, ascending
+		 * @param ExcludeIndex Point index to skip (the query point itself)
+		 * @return Number of neighbours found (less than K only for small sets)
+		 */
+		int32 FindNearest(const FVector3f& Query, int32 K, int32* OutIndices, float* OutDistancesSquared, int32 ExcludeIndex = INDEX_NONE) const;
+
+	private:
+		/** Running K-nearest list of one query, sorted by distance */
+		struct FNearestList
+		{
+			int32 K = 0;
+			int32 Num = 0;
+			int32 ExcludeIndex = INDEX_NONE;
+			int32* OutIndices = nullptr;
+			float* OutDistancesSquared = nullptr;
+
+			float GetWorst() const { return Num < K ? TNumericLimits<float>::Max() : OutDistancesSquared[K - 1]; }
+
+			/** Consider a point by source index */
+			void Offer(int32 Index, float DistanceSquared);
+		};
+
+		/** Search the node covering tree slots [Begin, End) */
+		void SearchNearest(int32 Begin, int32 End, const FVector3f& Query, FNearestList& List) const;
+
+		/** Points in tree order */
+		TArray<FVector3f> TreePoints;
+
+		/** Source index of each tree slot */
+		TArray<int32> Indices;
+
+		/** Split axis of the node whose median is at each slot */
+		TArray<uint8> SplitAxes;
+	};
+}
@@ -0,0 +1,103 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * SH codebook training settings
+	 */
+	struct UNREALTOGAUSSIAN_API FSHCodebookConfig
+	{
+		/** Codebook entries (at most 65536 so indices fit in 16 bits; fewer if the training samples hold fewer distinct vectors) */
+		int32 NumEntries = 4096;
+
+		/** Maximum k-means (Lloyd) iterations */
+		int32 MaxIterations = 10;
+
+		/** Splats sampled to train the codebook (0 = train on all splats) */
+		int32 MaxTrainingSamples = 262144;
+
+		/** Stop once an iteration improves the training error by less than this fraction */
+		float ConvergenceThreshold = 1e-3f;
+
+		/** Seed for training sample selection and initialization */
+		int32 Seed = 1337;
+	};
+
+	/**
+	 * Vector-quantized higher-order SH
+	 *
+	 * Replaces the 45 SH_Rest floats of each splat (180 bytes) with a 16-bit
+	 * index into a shared table of SH vectors trained by k-means. Used by the
+	 * PLY codebook extension (FPlyWriter) and by FSpzWriter.
+	 */
+	struct UNREALTOGAUSSIAN_API FSHCodebook
+	{
+		/** Floats per codebook entry (SH_Rest layout, channel-major) */
+		static constexpr int32 Dimension = FGaussianSplatBuffer::NumSHRest;
+
+		/** Largest codebook addressable by 16-bit indices */
+		static constexpr int32 MaxEntries = 65536;
+
+		/** Entry vectors, Dimension floats each */
+		TArray<float> Entries;
+
+		/** Codebook index of each splat */
+		TArray<uint16> Indices;
+
+		/** Mean squared reconstruction error per coefficient, over all splats */
+		double MeanSquaredError = 0.0;
+
+		/** Largest per-splat reconstruction error (L2 norm of the difference) */
+		float MaxError = 0.0f;
+
+		/** Mean squared SH_Rest value, the reference for SignalToNoise */
+		double SignalPower = 0.0;
+
+		/** Number of entries */
+		int32 NumEntries() const { return Entries.Num() / Dimension; }
+
+		/** Entry vector */
+		const float* GetEntry(int32 Index) const { return Entries.GetData() + static_cast<int64>(Index) * Dimension; }
+
+		/** Reconstruction signal-to-noise ratio in dB */
+		double GetSignalToNoiseDb() const;
+
+		/**
+		 * Train a codebook over the SH_Rest vectors of a buffer and assign every splat
+		 *
+		 * @param Splats Splats to quantize
+		 * @param Config Training settings
+		 * @param OutCodebook Trained codebook with per-splat indices and error statistics
+		 * @return True if successful
+		 */
+		static bool Build(const FGaussianSplatBuffer& Splats, const FSHCodebookConfig& Config, FSHCodebook& OutCodebook);
+
+		/** Overwrite SH_Rest of each splat with its codebook entry */
+		void Apply(FGaussianSplatBuffer& Splats) const;
+
+	private:
+		/**
+		 * Assign vectors to their nearest entry
+		 * Entries are searched outward in order of norm from the query's norm; the
+		 * norm difference bounds the distance, so most entries are never visited.
+		 *
+		 * @param Entries Entry vectors
+		 * @param Vectors Query vectors, Dimension floats each
+		 * @param NumVectors Number of queries
+		 * @param OutAssignments Nearest entry per query
+		 * @param OutSquaredErrors Squared distance to the nearest entry per query
+		 */
+		static void AssignNearest(
+			const TArray<float>& Entries,
+			const float* Vectors,
+			int32 NumVectors,
+			TArray<int32>& OutAssignments,
+			TArray<float>& OutSquaredErrors
+		);
+	};
+}
@@ -0,0 +1,82 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * Per-splat SH degree selection settings
+	 */
+	struct UNREALTOGAUSSIAN_API FSHDegreeConfig
+	{
+		/**
+		 * Largest color error allowed by dropping bands
+		 * RMS over all view directions, worst channel, in display units (1/255 is one 8-bit level).
+		 */
+		float MaxColorError = 1.0f / 255.0f;
+
+		/** Scale each splat's error by its opacity (faint splats contribute little color) */
+		bool bWeightByOpacity = true;
+
+		/** Highest degree any splat keeps (0-3) */
+		int32 MaxDegree = 3;
+	};
+
+	/**
+	 * Adaptive per-splat SH degree
+	 *
+	 * Real SH are orthonormal over the sphere, so truncating a splat after
+	 * degree d changes its color by an RMS of sqrt(sum of the dropped squared
+	 * coefficients / 4pi) per channel. Each splat keeps the lowest degree whose
+	 * truncation error stays within the threshold. Splats are then bucketed by
+	 * degree, and each bucket stores only the coefficients it keeps (PLY
+	 * "vertex_sh<d>" elements written by FPlyWriter).
+	 */
+	struct UNREALTOGAUSSIAN_API FSHDegreeReduction
+	{
+		static constexpr int32 MaxDegree = 3;
+
+		/** Selected degree of each splat */
+		TArray<uint8> Degrees;
+
+		/** Splats per degree */
+		int32 NumPerDegree[MaxDegree + 1] = {};
+
+		/** Largest truncation error accepted for any splat */
+		float MaxError = 0.0f;
+
+		/** Higher-order SH coefficients per channel kept at a degree (0, 3, 8, 15) */
+		static constexpr int32 GetCoeffsPerChannel(int32 Degree) { return (Degree + 1) * (Degree + 1) - 1; }
+
+		/** Bytes of higher-order SH stored for all splats at their selected degrees */
+		int64 GetSHRestBytes() const;
+
+		/**
+		 * Select the degree of every splat
+		 *
+		 * @param Splats Splats to analyze
+		 * @param Config Error threshold and degree cap
+		 * @param OutReduction Per-splat degrees with bucket counts
+		 * @return True if successful
+		 */
+		static bool Build(const FGaussianSplatBuffer& Splats, const FSHDegreeConfig& Config, FSHDegreeReduction& OutReduction);
+
+		/** Zero the SH_Rest coefficients above each splat's degree */
+		void Apply(FGaussianSplatBuffer& Splats) const;
+
+		/** Splat indices grouped by ascending degree, source order kept within a degree */
+		void GetBucketOrder(TArray<int32>& OutOrder) const;
+
+	private:
+		/**
+		 * Color error of truncating one splat after each degree
+		 *
+		 * @param Rest SH_Rest coefficients of the splat (channel-major)
+		 * @param OutErrors Error of keeping degrees 0..MaxDegree (OutErrors[MaxDegree] is 0)
+		 */
+		static void ComputeTruncationErrors(const float* Rest, float OutErrors[MaxDegree + 1]);
+	};
+}
@@ -0,0 +1,215 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+#include "FCM/SpatialSort.h"
+#include "HAL/CriticalSection.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace UE5_3DGS
+{
+	/**
+	 * Chunked splat file settings
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatChunkConfig
+	{
+		/** Splats per chunk (the last chunk may hold fewer) */
+		int32 SplatsPerChunk = 4096;
+
+		/** Deflate each chunk (chunks that do not shrink are stored raw) */
+		bool bCompress = true;
+
+		/** zlib compression level (1-9) */
+		int32 CompressionLevel = 6;
+
+		/** Order applied before chunking; spatial orders give compact chunk bounds */
+		ESpatialCurve SpatialOrder = ESpatialCurve::Hilbert;
+	};
+
+	/**
+	 * Index entry of one chunk
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatChunkInfo
+	{
+		/** Bounds of the chunk's splats, grown by three times each splat's largest scale */
+		FBox3f Bounds = FBox3f(ForceInit);
+
+		/** Byte offset of the stored chunk */
+		int64 Offset = 0;
+
+		/** Stored bytes (compressed size for deflated chunks) */
+		int32 StoredBytes = 0;
+
+		/** Splats in the chunk */
+		int32 NumSplats = 0;
+
+		/** Index of the chunk's first splat in file order */
+		int32 FirstSplat = 0;
+
+		/** Whether the chunk is deflated */
+		bool bCompressed = false;
+
+		/** CRC-32 of the stored bytes */
+		uint32 Checksum = 0;
+	};
+
+	/**
+	 * Random-access chunked splat container
+	 *
+	 * Splats are spatially ordered and cut into fixed-size chunks of PLY-layout
+	 * rows. Each chunk may be deflated on its own (byte k of every float is
+	 * grouped into plane k first, so exponent bytes sit together), and a footer
+	 * index records every chunk's bounds, offset and size. Readers fetch chunks
+	 * by ID or region without touching the rest of the file.
+	 *
+	 * File layout (little-endian):
+	 * - Header: magic "SCHK", version, splats per chunk, bytes per splat, total splats
+	 * - Chunks, in file order
+	 * - Index: one record per chunk
+	 * - Tail: index offset, chunk count, magic
+	 */
+	class UNREALTOGAUSSIAN_API FSplatChunkWriter
+	{
+	public:
+		/** "SCHK" */
+		static constexpr uint32 FileMagic = 0x4b484353;
+		static constexpr uint32 FileVersion = 1;
+
+		/**
+		 * Write a chunked splat file
+		 * Chunks are gathered and compressed in parallel, a bounded number at a time.
+		 *
+		 * @param FilePath Output file path
+		 * @param Splats Gaussian splat buffer
+		 * @param Config Chunking and compression settings
+		 * @param OutPermutation Optional source splat index of each splat in file order
+		 * @return True if successful
+		 */
+		static bool WriteChunkFile(
+			const FString& FilePath,
+			const FGaussianSplatBuffer& Splats,
+			const FSplatChunkConfig& Config = FSplatChunkConfig(),
+			TArray<int32>* OutPermutation = nullptr
+		);
+
+	private:
+		friend class FSplatChunkReader;
+
+		/** File header (24 bytes) */
+		struct FFileHeader
+		{
+			uint32 Magic = 0;
+			uint32 Version = 0;
+			uint32 SplatsPerChunk = 0;
+			uint32 BytesPerSplat = 0;
+			uint64 NumSplats = 0;
+		};
+
+		/** Chunk index record (48 bytes) */
+		struct FChunkRecord
+		{
+			float BoundsMin[3];
+			float BoundsMax[3];
+			uint64 Offset;
+			uint32 StoredBytes;
+			uint32 NumSplats;
+			uint32 Flags;
+			uint32 Checksum;
+		};
+
+		/** Footer tail (16 bytes) */
+		struct FFileTail
+		{
+			uint64 IndexOffset = 0;
+			uint32 NumChunks = 0;
+			uint32 Magic = 0;
+		};
+
+		/** FChunkRecord flags */
+		static constexpr uint32 ChunkFlag_Deflated = 1 << 0;
+
+		/** Group byte k of every 4-byte word into plane k */
+		static void ShuffleBytes(const uint8* Source, int64 NumWords, uint8* Dest);
+
+		/** Inverse of ShuffleBytes */
+		static void UnshuffleBytes(const uint8* Source, int64 NumWords, uint8* Dest);
+	};
+
+	/**
+	 * Reader for chunked splat files
+	 *
+	 * Open() maps the file and reads only the tail and index; chunk data is
+	 * paged in when a chunk is requested. When mapping is unavailable, chunks
+	 * are read with positioned reads instead. Requested chunks are decoded in
+	 * parallel.
+	 */
+	class UNREALTOGAUSSIAN_API FSplatChunkReader
+	{
+	public:
+		FSplatChunkReader();
+		~FSplatChunkReader();
+
+		/**
+		 * Open a chunked splat file and load its index
+		 *
+		 * @param FilePath Chunk file path
+		 * @return True if the file and its index are valid
+		 */
+		bool Open(const FString& FilePath);
+
+		/** Release the file */
+		void Close();
+
+		/** Chunk index */
+		const TArray<FSplatChunkInfo>& GetChunks() const { return Chunks; }
+
+		/** Total splats in the file */
+		int64 GetNumSplats() const { return NumSplats; }
+
+		/** Chunks whose bounds intersect a region */
+		void FindChunks(const FBox3f& Region, TArray<int32>& OutChunkIds) const;
+
+		/**
+		 * Read chunks by ID
+		 *
+		 * @param ChunkIds Chunks to read
+		 * @param OutSplats Splats of the chunks, in the given order
+		 * @return True if successful
+		 */
+		bool ReadChunks(const TArray<int32>& ChunkIds, FGaussianSplatBuffer& OutSplats) const;
+
+		/**
+		 * Read the chunks intersecting a region
+		 *
+		 * @param Region Region of interest
+		 * @param OutSplats Splats of the intersecting chunks
+		 * @param bClipToRegion Keep only splats whose centers lie inside Region
+		 * @return True if successful
+		 */
+		bool ReadRegion(const FBox3f& Region, FGaussianSplatBuffer& OutSplats, bool bClipToRegion = false) const;
+
+	private:
+		/** Stored bytes of a chunk: the mapped pages, or a positioned read into Scratch */
+		const uint8* GetStoredBytes(const FSplatChunkInfo& Chunk, TArray<uint8>& Scratch) const;
+
+		/** Decode one chunk into OutSplats starting at FirstIndex */
+		bool DecodeChunk(const FSplatChunkInfo& Chunk, FGaussianSplatBuffer& OutSplats, int32 FirstIndex) const;
+
+		FString Path;
+		TUniquePtr<IMappedFileHandle> MappedHandle;
+		TUniquePtr<IMappedFileRegion> MappedRegion;
+		const uint8* MappedData = nullptr;
+
+		/** Fallback when the file cannot be mapped */
+		TUniquePtr<IFileHandle> FileHandle;
+		mutable FCriticalSection FileLock;
+
+		TArray<FSplatChunkInfo> Chunks;
+		int64 NumSplats = 0;
+	};
+}
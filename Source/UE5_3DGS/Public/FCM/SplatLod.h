@@ -0,0 +1,207 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * Octree LOD build settings
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatLodConfig
+	{
+		/** A node with more source splats than this is split into octants */
+		int32 MaxSplatsPerLeaf = 8192;
+
+		/** Upper bound on the merged splats stored in an interior node */
+		int32 MaxSplatsPerNode = 8192;
+
+		/** Maximum octree depth (at most FSpatialSort::BitsPerAxis) */
+		int32 MaxDepth = 16;
+	};
+
+	/**
+	 * One octree node
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatLodNode
+	{
+		/** Octree cell (cubic) */
+		FBox3f Bounds = FBox3f(ForceInit);
+
+		/** Parent node (INDEX_NONE for the root) */
+		int32 Parent = INDEX_NONE;
+
+		/** First child; children are stored contiguously */
+		int32 FirstChild = INDEX_NONE;
+
+		/** Number of non-empty child octants (0 for leaves) */
+		int32 NumChildren = 0;
+
+		/** Depth below the root */
+		int32 Depth = 0;
+
+		/** First splat of this node in FSplatLodTree::Splats */
+		int32 FirstSplat = 0;
+
+		/** Number of splats stored for this node */
+		int32 NumSplats = 0;
+
+		/** Size of the merge cells used for this node (0 for leaves and unmerged nodes) */
+		float GeometricError = 0.0f;
+
+		/** Byte offset of the node's splat rows in a LOD file (set by ReadLodIndex) */
+		int64 DataOffset = 0;
+
+		bool IsLeaf() const { return NumChildren == 0; }
+	};
+
+	/**
+	 * Octree of splats where every node can stand in for its whole subtree
+	 *
+	 * Leaves hold the source splats; interior nodes hold a reduced set merged
+	 * from their children. A renderer picks a cut through the tree whose
+	 * total splat count fits its budget.
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatLodTree
+	{
+		/** Nodes in breadth-first order, root first */
+		TArray<FSplatLodNode> Nodes;
+
+		/** Splats of all nodes, node by node */
+		FGaussianSplatBuffer Splats;
+	};
+
+	/**
+	 * Octree LOD builder and node-indexed LOD file I/O (ADR-007 LOD streaming)
+	 *
+	 * Splats are ordered by Morton key so every octree cell is a contiguous
+	 * range, then nodes are built bottom-up one level at a time with the nodes
+	 * of each level merged in parallel. Interior nodes cluster their children's
+	 * splats on a grid and replace each cluster by one gaussian matching its
+	 * mean and covariance, with color and opacity weighted by opacity times
+	 * footprint.
+	 *
+	 * LOD file layout (little-endian):
+	 * - Header: magic "SLOD", version, node count, bytes per splat, total splats
+	 * - Node table: bounds, parent, first child, child count, depth, geometric
+	 *   error, splat count and byte offset of the node's splats
+	 * - Splat rows in the 3DGS PLY property order, node by node
+	 */
+	class UNREALTOGAUSSIAN_API FSplatLodBuilder
+	{
+	public:
+		/** "SLOD" */
+		static constexpr uint32 FileMagic = 0x444f4c53;
+		static constexpr uint32 FileVersion = 1;
+
+		/**
+		 * Build an LOD octree
+		 *
+		 * @param Splats Source splats (non-finite positions are dropped)
+		 * @param Config Build settings
+		 * @param OutTree Octree with merged interior nodes
+		 * @return True if successful
+		 */
+		static bool Build(const FGaussianSplatBuffer& Splats, const FSplatLodConfig& Config, FSplatLodTree& OutTree);
+
+		/**
+		 * Write an LOD octree to a node-indexed file
+		 *
+		 * @param FilePath Output file path
+		 * @param Tree Octree to write
+		 * @return True if successful
+		 */
+		static bool WriteLodFile(const FString& FilePath, const FSplatLodTree& Tree);
+
+		/**
+		 * Read the node table of an LOD file without its splats
+		 *
+		 * @param FilePath LOD file path
+		 * @param OutNodes Nodes with DataOffset set
+		 * @return True if successful
+		 */
+		static bool ReadLodIndex(const FString& FilePath, TArray<FSplatLodNode>& OutNodes);
+
+		/**
+		 * Read the splats of a set of nodes from an LOD file
+		 *
+		 * @param FilePath LOD file path
+		 * @param Nodes Node table from ReadLodIndex
+		 * @param NodeIndices Nodes to load (e.g. a cut from SelectCut)
+		 * @param OutSplats Splats of the requested nodes, in the given order
+		 * @return True if successful
+		 */
+		static bool ReadLodNodes(
+			const FString& FilePath,
+			const TArray<FSplatLodNode>& Nodes,
+			const TArray<int32>& NodeIndices,
+			FGaussianSplatBuffer& OutSplats
+		);
+
+		/**
+		 * Choose the finest cut that fits a splat budget
+		 * Starting from the root, nodes with the largest geometric error are
+		 * replaced by their children while the budget allows.
+		 *
+		 * @param Nodes Node table of a tree or LOD file
+		 * @param SplatBudget Maximum splats in the cut
+		 * @param OutNodes Nodes of the cut (together they cover the scene once)
+		 * @return Total splats in the cut
+		 */
+		static int64 SelectCut(const TArray<FSplatLodNode>& Nodes, int64 SplatBudget, TArray<int32>& OutNodes);
+
+		/**
+		 * Merge splats into one gaussian by moment matching
+		 *
+		 * @param Splats Source splats
+		 * @param Indices Splats to merge
+		 * @param Count Number of indices
+		 * @param OutSplats Destination buffer
+		 * @param OutIndex Destination splat
+		 */
+		static void MergeSplats(
+			const FGaussianSplatBuffer& Splats,
+			const int32* Indices,
+			int32 Count,
+			FGaussianSplatBuffer& OutSplats,
+			int32 OutIndex
+		);
+
+	private:
+		/** LOD file header (24 bytes) */
+		struct FFileHeader
+		{
+			uint32 Magic = 0;
+			uint32 Version = 0;
+			uint32 NumNodes = 0;
+			uint32 BytesPerSplat = 0;
+			uint64 NumSplats = 0;
+		};
+
+		/** LOD file node record (56 bytes) */
+		struct FNodeRecord
+		{
+			float BoundsMin[3];
+			float BoundsMax[3];
+			int32 Parent;
+			int32 FirstChild;
+			int32 NumChildren;
+			int32 Depth;
+			float GeometricError;
+			int32 NumSplats;
+			uint64 DataOffset;
+		};
+
+		/**
+		 * Reduce the concatenated splats of a node's children to at most MaxSplats
+		 *
+		 * @return Merge cell size (0 if the splats were kept as they are)
+		 */
+		static float ReduceNode(const FGaussianSplatBuffer& ChildSplats, const FBox3f& Bounds, int32 MaxSplats, FGaussianSplatBuffer& OutSplats);
+
+		/** Copy one splat between buffers */
+		static void CopySplat(const FGaussianSplatBuffer& Source, int32 SourceIndex, FGaussianSplatBuffer& Dest, int32 DestIndex);
+	};
+}
@@ -0,0 +1,125 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * Splat pruning settings
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatPruneConfig
+	{
+		/** Splats with lower (linear) opacity are removed */
+		float MinOpacity = 1.0f / 255.0f;
+
+		/**
+		 * Splats whose projected 3-sigma radius is smaller than this many pixels
+		 * from every view are removed (0 disables the check)
+		 */
+		float MinProjectedRadius = 0.0f;
+
+		/** Focal length in pixels used for the projected size */
+		float FocalLengthPixels = 1000.0f;
+
+		/** View positions (splat coordinates); the nearest one sets each splat's distance */
+		TArray<FVector3f> ViewPositions;
+
+		/** Viewing distance used when no view positions are given */
+		float ReferenceDistance = 1.0f;
+
+		/** Splats closer than this are merged into one (0 disables deduplication) */
+		float MergeDistance = 0.0f;
+
+		/** Largest per-axis log-scale difference between merged splats */
+		float MergeMaxLogScaleDifference = 0.25f;
+	};
+
+	/**
+	 * What a pruning pass removed
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatPruneStats
+	{
+		int32 NumInput = 0;
+
+		/** Removed for non-finite position or scale */
+		int32 NumInvalid = 0;
+
+		/** Removed below MinOpacity */
+		int32 NumTransparent = 0;
+
+		/** Removed below MinProjectedRadius */
+		int32 NumTooSmall = 0;
+
+		/** Removed by merging into a coincident splat */
+		int32 NumMerged = 0;
+
+		int32 NumOutput = 0;
+
+		/** Log a one-line summary */
+		void Log() const;
+	};
+
+	/**
+	 * Splat pruning and deduplication
+	 *
+	 * Each splat is tested against the opacity and projected size thresholds in
+	 * parallel. Survivors are hashed into a grid of MergeDistance cells (cell
+	 * keys sorted with FSpatialSort::RadixSort, cell starts in a hash map), and
+	 * clustered greedily in index order: each splat joins the lowest-index
+	 * cluster leader within MergeDistance among the 27 neighbouring cells, or
+	 * leads a new cluster. Clusters are merged by moment matching
+	 * (FSplatLodBuilder::MergeSplats).
+	 */
+	class UNREALTOGAUSSIAN_API FSplatPruner
+	{
+	public:
+		/**
+		 * Prune and deduplicate splats
+		 *
+		 * @param Splats Source splats
+		 * @param Config Thresholds
+		 * @param OutSplats Surviving and merged splats, in source order
+		 * @param OutStats Removal counts
+		 * @param OutSourceIndices Optional lowest source index of each output splat
+		 * @return True if successful
+		 */
+		static bool Prune(
+			const FGaussianSplatBuffer& Splats,
+			const FSplatPruneConfig& Config,
+			FGaussianSplatBuffer& OutSplats,
+			FSplatPruneStats& OutStats,
+			TArray<int32>* OutSourceIndices = nullptr
+		);
+
+	private:
+		/** Per-splat outcome of the threshold tests */
+		enum class EPruneReason : uint8
+		{
+			Keep,
+			Invalid,
+			Transparent,
+			TooSmall
+		};
+
+		/**
+		 * Assign each kept splat to the lowest-index coincident cluster leader
+		 *
+		 * @param Splats Source splats
+		 * @param Reasons Threshold outcome per splat (only Keep splats are linked)
+		 * @param Config Merge thresholds
+		 * @param OutRepresentative Cluster leader per kept splat (itself for leaders)
+		 */
+		static void FindDuplicates(
+			const FGaussianSplatBuffer& Splats,
+			const TArray<EPruneReason>& Reasons,
+			const FSplatPruneConfig& Config,
+			TArray<int32>& OutRepresentative
+		);
+
+		/** Pack signed cell coordinates into a 63-bit key */
+		static uint64 GetCellKey(const FIntVector& Cell);
+	};
+}
@@ -0,0 +1,126 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+
+class FJsonObject;
+
+namespace UE5_3DGS
+{
+	/**
+	 * Statistics pass settings
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatStatisticsConfig
+	{
+		/** Bins per histogram */
+		int32 NumBins = 32;
+
+		/** Histogram range of log-scale (values outside land in the edge bins) */
+		float LogScaleMin = -20.0f;
+		float LogScaleMax = 10.0f;
+
+		/** Histogram range of SH energy (RMS of the higher-order coefficients) */
+		float SHEnergyMax = 1.0f;
+
+		/** Rotations whose length differs from 1 by more are counted as non-unit */
+		float QuaternionTolerance = 0.01f;
+	};
+
+	/**
+	 * Distribution of one scalar attribute over the finite values seen
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatAttributeStats
+	{
+		double Min = TNumericLimits<double>::Max();
+		double Max = TNumericLimits<double>::Lowest();
+		double Sum = 0.0;
+		int64 Count = 0;
+
+		/** Histogram range and counts */
+		double HistogramMin = 0.0;
+		double HistogramMax = 1.0;
+		TArray<int64> Bins;
+
+		double GetMean() const { return Count > 0 ? Sum / Count : 0.0; }
+
+		/** Set up an empty histogram */
+		void Init(double InHistogramMin, double InHistogramMax, int32 NumBins);
+
+		/** Add one value (non-finite values are ignored) */
+		void Add(double Value);
+
+		/** Accumulate another partial result over the same histogram range */
+		void Merge(const FSplatAttributeStats& Other);
+	};
+
+	/**
+	 * Statistics and validation report of a splat buffer
+	 *
+	 * Computed in a single parallel pass: each batch of splats reduces into its
+	 * own partial report, and the partials are merged at the end. Meant as a CI
+	 * gate for trained assets; the report is written as JSON.
+	 */
+	struct UNREALTOGAUSSIAN_API FSplatStatistics
+	{
+		int32 NumSplats = 0;
+
+		/** Bounds and centroid of finite positions */
+		FBox3d Bounds = FBox3d(ForceInit);
+		FVector3d Centroid = FVector3d::ZeroVector;
+
+		/** Opacity (linear) */
+		FSplatAttributeStats Opacity;
+
+		/** Log-scale, all three axes */
+		FSplatAttributeStats LogScale;
+
+		/** RMS of the 45 higher-order SH coefficients */
+		FSplatAttributeStats SHEnergy;
+
+		/** Splats with at least one NaN / infinite attribute value */
+		int64 NumWithNaN = 0;
+		int64 NumWithInf = 0;
+
+		/** Splats with a non-finite position */
+		int64 NumInvalidPositions = 0;
+
+		/** Splats with opacity outside [0, 1] */
+		int64 NumOpacityOutOfRange = 0;
+
+		/** Splats whose rotation is not unit length */
+		int64 NumNonUnitQuaternions = 0;
+
+		/** Whether every splat has finite values and a unit rotation */
+		bool IsValid() const { return NumSplats > 0 && NumWithNaN == 0 && NumWithInf == 0 && NumNonUnitQuaternions == 0; }
+
+		/**
+		 * Compute statistics of a splat buffer in one parallel pass
+		 *
+		 * @param Splats Splats to analyze
+		 * @param Config Histogram and tolerance settings
+		 * @param OutStatistics Report
+		 * @return True if successful
+		 */
+		static bool Compute(const FGaussianSplatBuffer& Splats, const FSplatStatisticsConfig& Config, FSplatStatistics& OutStatistics);
+
+		/** Report as a JSON object */
+		TSharedRef<FJsonObject> ToJsonObject() const;
+
+		/** Report as JSON text */
+		FString ToJson() const;
+
+		/**
+		 * Write the JSON report to a file
+		 *
+		 * @param FilePath Output file path
+		 * @return True if successful
+		 */
+		bool SaveJson(const FString& FilePath) const;
+
+	private:
+		/** Accumulate another partial report (Centroid holds the position sum until Compute finishes) */
+		void Merge(const FSplatStatistics& Other);
+	};
+}
@@ -0,0 +1,123 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE5_3DGS
+{
+	/**
+	 * SPZ container layout shared by FSpzWriter and FSpzReader
+	 *
+	 * An SPZ file is a single gzip stream holding a 16-byte header followed by
+	 * attribute columns, each stored for all splats before the next begins:
+	 * - Positions: 3 x 24-bit signed fixed-point per splat
+	 * - Alphas: 1 byte per splat (linear opacity * 255)
+	 * - Colors: 3 bytes per splat (DC SH, scaled around 0.5)
+	 * - Scales: 3 bytes per splat (log-space, (s + 10) * 16)
+	 * - Rotations: 4 bytes per splat (smallest-three, version 3)
+	 * - SH: 3 bytes per coefficient per splat, coefficient-major
+	 *
+	 * Plugin extension (SpzFlag_SHCodebook, not readable by other SPZ loaders):
+	 * the SH column is replaced by a uint32 entry count, the codebook entries
+	 * (SH bytes as above, at full 8-bit precision) and a uint16 index per splat.
+	 *
+	 * Attributes are stored in the SPZ coordinate frame (right, up, back);
+	 * the PLY/COLMAP frame used elsewhere in the plugin is (right, down, forward).
+	 */
+	struct FSpzHeader
+	{
+		/** "NGSP" */
+		uint32 Magic = 0;
+
+		/** Format version */
+		uint32 Version = 0;
+
+		/** Number of splats */
+		uint32 NumPoints = 0;
+
+		/** Stored SH degree (0-3) */
+		uint8 SHDegree = 0;
+
+		/** Fractional bits of the fixed-point positions */
+		uint8 FractionalBits = 0;
+
+		/** ESpzFlags */
+		uint8 Flags = 0;
+
+		/** Must be zero */
+		uint8 Reserved = 0;
+	};
+
+	static_assert(sizeof(FSpzHeader) == 16, "SPZ header must be 16 bytes");
+
+	/** SPZ header flags */
+	enum ESpzFlags : uint8
+	{
+		SpzFlag_None = 0,
+
+		/** Splats were trained with antialiasing */
+		SpzFlag_Antialiased = 1 << 0,
+
+		/** SH is vector-quantized through a codebook (plugin extension) */
+		SpzFlag_SHCodebook = 1 << 1
+	};
+
+	/** Attribute columns in file order */
+	enum class ESpzSection : uint8
+	{
+		Positions,
+		Alphas,
+		Colors,
+		Scales,
+		Rotations,
+		SHCodebook,
+		SH,
+
+		Count
+	};
+
+	namespace SpzFormat
+	{
+		/** Header magic ("NGSP" little-endian) */
+		constexpr uint32 Magic = 0x5053474e;
+
+		/** Version written by FSpzWriter (smallest-three rotations) */
+		constexpr uint32 Version = 3;
+
+		/** Oldest version FSpzReader understands (3-byte rotations) */
+		constexpr uint32 MinVersion = 2;
+
+		/** Scale applied to DC SH before centering on 0.5 */
+		constexpr float ColorScale = 0.15f;
+
+		/** Bytes per splat of each fixed-size column */
+		constexpr int32 PositionBytes = 9;
+		constexpr int32 AlphaBytes = 1;
+		constexpr int32 ColorBytes = 3;
+		constexpr int32 ScaleBytes = 3;
+
+		/** Rotation bytes per splat for a format version */
+		constexpr int32 GetRotationBytes(uint32 FormatVersion) { return FormatVersion >= 3 ? 4 : 3; }
+
+		/** Higher-order SH coefficients per color channel for a degree */
+		constexpr int32 GetNumSHCoeffs(int32 Degree) { return (Degree + 1) * (Degree + 1) - 1; }
+
+		/**
+		 * Sign applied to a higher-order SH coefficient when flipping the Y and Z axes
+		 * between the PLY frame (RDF) and the SPZ frame (RUB)
+		 *
+		 * @param CoeffIndex Coefficient index within a channel (0-14)
+		 */
+		inline float GetSHAxisFlip(int32 CoeffIndex)
+		{
+			// Band 1: y, z, x / band 2: xy, yz, z2, xz, x2-y2 / band 3: y*, xyz, y*, z*, x*, z*, x*
+			static constexpr float Signs[15] = {
+				-1.0f, -1.0f, 1.0f,
+				-1.0f, 1.0f, 1.0f, -1.0f, 1.0f,
+				-1.0f, 1.0f, -1.0f, -1.0f, 1.0f, -1.0f, 1.0f
+			};
+			return Signs[CoeffIndex];
+		}
+	}
+}
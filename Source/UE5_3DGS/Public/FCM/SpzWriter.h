@@ -0,0 +1,133 @@
+// Copyright 2024 3DGS Research Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FCM/GaussianSplatBuffer.h"
+#include "FCM/SpzFormat.h"
+
+namespace UE5_3DGS
+{
+	struct FGaussianSplat;
+	struct FSHCodebook;
+
+	/**
+	 * SPZ export settings
+	 */
+	struct UNREALTOGAUSSIAN_API FSpzConfig
+	{
+		/** SH degree to store (0 = DC only, 3 = full) */
+		int32 SHDegree = 3;
+
+		/** Fractional bits of the 24-bit positions (12 = 0.24 mm steps within +/-2 km) */
+		int32 FractionalBits = 12;
+
+		/** Precision kept for degree-1 SH coefficients (of 8 stored bits) */
+		int32 SH1Bits = 5;
+
+		/** Precision kept for degree-2 and degree-3 SH coefficients (of 8 stored bits) */
+		int32 SHRestBits = 4;
+
+		/** zlib compression level (1-9) */
+		int32 CompressionLevel = 6;
+
+		/** Whether the splats were trained with antialiasing */
+		bool bAntialiased = false;
+
+		/**
+		 * Optional SH codebook built for the splats being written
+		 * Stores a 16-bit index per splat instead of SH bytes (SpzFlag_SHCodebook);
+		 * only FSpzReader can load such files.
+		 */
+		const FSHCodebook* SHCodebook = nullptr;
+	};
+
+	/**
+	 * SPZ writer for compressed gaussian splat deployment (ADR-007)
+	 *
+	 * Quantizes every attribute to 8-24 bits, lays the results out column by
+	 * column so similar bytes are adjacent, and gzips the payload. Quantization
+	 * runs in parallel per splat and the gzip stream is deflated in parallel
+	 * blocks, so a 1M-splat scene encodes to roughly a tenth of its PLY size.
+	 */
+	class UNREALTOGAUSSIAN_API FSpzWriter
+	{
+	public:
+		/** Uncompressed bytes deflated per parallel block */
+		static constexpr int32 GzipBlockBytes = 1 << 20;
+
+		/**
+		 * Write gaussian splats to an SPZ file
+		 *
+		 * @param FilePath Output file path
+		 * @param Splats Gaussian splat buffer (PLY/COLMAP coordinates)
+		 * @param Config Quantization and compression settings
+		 * @return True if successful
+		 */
+		static bool WriteSpz(
+			const FString& FilePath,
+			const FGaussianSplatBuffer& Splats,
+			const FSpzConfig& Config = FSpzConfig()
+		);
+
+		/**
+		 * Write gaussian splats to an SPZ file
+		 *
+		 * @param FilePath Output file path
+		 * @param Splats Gaussian splat data (PLY/COLMAP coordinates)
+		 * @param Config Quantization and compression settings
+		 * @return True if successful
+		 */
+		static bool WriteSpz(
+			const FString& FilePath,
+			const TArray<FGaussianSplat>& Splats,
+			const FSpzConfig& Config = FSpzConfig()
+		);
+
+		/**
+		 * Encode splats into SPZ file contents
+		 *
+		 * @param Splats Gaussian splat buffer
+		 * @param Config Quantization and compression settings
+		 * @param OutData Gzip-compressed SPZ bytes
+		 * @return True if successful
+		 */
+		static bool EncodeSpz(const FGaussianSplatBuffer& Splats, const FSpzConfig& Config, TArray<uint8>& OutData);
+
+		/**
+		 * Quantize splats into the uncompressed SPZ payload (header and columns)
+		 *
+		 * @param Splats Gaussian splat buffer
+		 * @param Config Quantization settings
+		 * @param OutPayload Uncompressed payload
+		 */
+		static void PackSplats(const FGaussianSplatBuffer& Splats, const FSpzConfig& Config, TArray<uint8>& OutPayload);
+
+		/**
+		 * Compress data into a single gzip member
+		 * Blocks are deflated in parallel, each primed with the previous 32 KB as
+		 * dictionary, and joined with sync flushes, so any gzip reader can inflate
+		 * the result as one stream.
+		 *
+		 * @param Data Uncompressed bytes
+		 * @param Size Number of bytes
+		 * @param Level zlib compression level (1-9)
+		 * @param OutCompressed Gzip stream
+		 * @return True if successful
+		 */
+		static bool CompressGzip(const uint8* Data, int64 Size, int32 Level, TArray<uint8>& OutCompressed);
+
+		/** Pack a unit quaternion (x, y, z, w) as smallest-three: 2-bit index plus 3 x (sign + 9 bits) */
+		static uint32 PackRotation(const FQuat4f& Rotation);
+
+		/** Quantize an SH coefficient to 8 bits, keeping one value per bucket */
+		static uint8 QuantizeSH(float Value, int32 BucketSize);
+
+	private:
+		/** Round and clamp to a byte */
+		static FORCEINLINE uint8 ToUInt8(float Value)
+		{
+			return static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Value), 0, 255));
+		}
+	};
+}
@@ -55,6 +55,22 @@ struct UNREALTOGAUSSIAN_API FCaptureConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture")
 	bool bExportPointCloud = true;
 
+	/** Whether to remove statistical outliers (stray depth points) before export */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (EditCondition = "bExportPointCloud"))
+	bool bRemoveOutliers = false;
+
+	/** Voxel size for point cloud downsampling in meters (0 disables unless the point budget is exceeded) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = "0.0", EditCondition = "bExportPointCloud"))
+	float PointCloudVoxelSize = 0.0f;
+
+	/** Largest number of exported points; larger clouds are voxel downsampled to fit (0 = unlimited) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = "0", EditCondition = "bExportPointCloud"))
+	int32 MaxPointCloudPoints = 2000000;
+
+	/** Whether to estimate point cloud normals from local plane fits (oriented towards the cameras; camera markers keep their view direction) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (EditCondition = "bExportPointCloud"))
+	bool bEstimateNormals = true;
+
 	/** Image format */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture")
 	EImageFormat ImageFormat = EImageFormat::JPEG;
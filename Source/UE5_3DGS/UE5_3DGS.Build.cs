@@ -54,6 +54,9 @@ public class UE5_3DGS : ModuleRules
 			}
 		);
 
+		// zlib (SPZ gzip, chunk-file and EXR deflate)
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
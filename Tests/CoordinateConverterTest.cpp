@@ -12,7 +12,22 @@
 
 #include "CoreMinimal.h"
 #include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
 #include "FCM/CoordinateConverter.h"
+#include "FCM/GaussianCovariance.h"
+#include "FCM/PlyWriter.h"
+#include "FCM/PointKdTree.h"
+#include "FCM/NormalEstimation.h"
+#include "FCM/PointCloudFilter.h"
+#include "FCM/SHCodebook.h"
+#include "FCM/SHDegreeReduction.h"
+#include "FCM/SpatialSort.h"
+#include "FCM/SplatLod.h"
+#include "FCM/SplatPruning.h"
+#include "FCM/SplatStatistics.h"
+#include "FCM/SpzWriter.h"
+#include "FCM/SpzReader.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCoordinateConverterPositionTest, "UE5_3DGS.FCM.CoordinateConverter.Position", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
@@ -124,6 +139,80 @@ bool FCoordinateConverterRotationTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplatTransformTest, "UE5_3DGS.FCM.CoordinateConverter.SplatTransform", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSplatTransformTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	FRandomStream Random(5);
+	FGaussianSplatBuffer Splats;
+	Splats.SetNum(64);
+	for (int32 i = 0; i < Splats.Num(); ++i)
+	{
+		Splats.Positions[i] = FVector3f(Random.FRandRange(-5.0f, 5.0f), Random.FRandRange(-5.0f, 5.0f), Random.FRandRange(-5.0f, 5.0f));
+		Splats.Scales[i] = FVector3f(Random.FRandRange(-6.0f, -2.0f), Random.FRandRange(-6.0f, -2.0f), Random.FRandRange(-6.0f, -2.0f));
+		Splats.Rotations[i] = FQuat4f(FVector3f(Random.GetUnitVector()), Random.FRandRange(0.0f, 3.0f));
+		for (int32 k = 0; k < FGaussianSplatBuffer::NumSHRest; ++k)
+		{
+			Splats.GetSHRest(i)[k] = Random.FRandRange(-0.5f, 0.5f);
+		}
+	}
+
+	// Mirrored similarity transform: COLMAP to UE5 followed by a rotation, scale and offset
+	const FSplatTransform Transform = FSplatTransform::Compose(
+		FSplatTransform::ColmapToUE5(),
+		FSplatTransform::FromTransform(FTransform(FQuat(FVector(1.0, 2.0, 3.0).GetSafeNormal(), 0.7), FVector(10.0, -20.0, 5.0), FVector(2.0))));
+	TestTrue(TEXT("Transform is mirrored"), Transform.IsMirrored());
+
+	FGaussianSplatBuffer Transformed = Splats;
+	TestTrue(TEXT("Transform splats"), FGaussianCoordinateConverter::TransformSplats(Transformed, Transform));
+
+	auto Quadratic = [](const FGaussianCovariance& C, const FVector3d& V)
+	{
+		return C.XX * V.X * V.X + C.YY * V.Y * V.Y + C.ZZ * V.Z * V.Z + 2.0 * (C.XY * V.X * V.Y + C.XZ * V.X * V.Z + C.YZ * V.Y * V.Z);
+	};
+
+	auto EvaluateColor = [](const float* Rest, const FVector3d& Direction)
+	{
+		double Basis[FSHRotation::NumCoeffs];
+		FSHRotation::EvaluateBasis(Direction, Basis);
+		double Color = 0.0;
+		for (int32 k = 0; k < FSHRotation::NumCoeffs; ++k)
+		{
+			Color += Basis[k] * Rest[k];
+		}
+		return Color;
+	};
+
+	for (int32 i = 0; i < 8; ++i)
+	{
+		const FVector3d Expected = Transform.TransformPosition(FVector3d(Splats.Positions[i]));
+		TestTrue(TEXT("Position transformed"), FVector3d(Transformed.Positions[i]).Equals(Expected, 1e-3));
+
+		// Covariance: v^T C' v = s^2 (Q^T v)^T C (Q^T v)
+		const FGaussianCovariance Before = FGaussianCovariance::FromScaleRotation(Splats.Scales[i], Splats.Rotations[i]);
+		const FGaussianCovariance After = FGaussianCovariance::FromScaleRotation(Transformed.Scales[i], Transformed.Rotations[i]);
+		const FVector3d V = Random.GetUnitVector();
+		const FVector3d Local = Transform.Inverse().TransformVector(V);
+		const double ExpectedVariance = Transform.Scale * Transform.Scale * Quadratic(Before, Local);
+		TestNearlyEqual(TEXT("Covariance transformed"), Quadratic(After, V), ExpectedVariance, 1e-4 * ExpectedVariance + 1e-9);
+
+		// View-dependent color seen along Q d after the transform equals the color along d before
+		const FVector3d Direction = Random.GetUnitVector();
+		TestNearlyEqual(TEXT("SH rotated"),
+			EvaluateColor(Transformed.GetSHRest(i), Transform.TransformVector(Direction)),
+			EvaluateColor(Splats.GetSHRest(i), Direction), 1e-4);
+	}
+
+	// Round trip through the inverse restores the buffer
+	TestTrue(TEXT("Inverse transform"), FGaussianCoordinateConverter::TransformSplats(Transformed, Transform.Inverse()));
+	TestTrue(TEXT("Round-trip position"), Transformed.Positions[3].Equals(Splats.Positions[3], 1e-3f));
+	TestNearlyEqual(TEXT("Round-trip SH"), Transformed.GetSHRest(3)[44], Splats.GetSHRest(3)[44], 1e-4f);
+
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraIntrinsicsTest, "UE5_3DGS.FCM.CameraIntrinsics", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
 bool FCameraIntrinsicsTest::RunTest(const FString& Parameters)
@@ -349,9 +438,9 @@ bool FPlyWriterTest::RunTest(const FString& Parameters)
 		int64 Memory100K = FPlyWriter::EstimateMemoryUsage(100000);
 		int64 Memory1M = FPlyWriter::EstimateMemoryUsage(1000000);
 
-		// 236 bytes per splat
-		TestEqual(TEXT("100K splats memory"), Memory100K, 100000LL * 236);
-		TestEqual(TEXT("1M splats memory"), Memory1M, 1000000LL * 236);
+		// 248 bytes per splat
+		TestEqual(TEXT("100K splats memory"), Memory100K, 100000LL * 248);
+		TestEqual(TEXT("1M splats memory"), Memory1M, 1000000LL * 248);
 	}
 
 	// Test 4: Point cloud creation
@@ -384,5 +473,762 @@ bool FPlyWriterTest::RunTest(const FString& Parameters)
 		TestTrue(TEXT("Valid splats pass validation"), bValid);
 	}
 
+	// Test 6: Structure-of-arrays buffer round-trip
+	{
+		TArray<FGaussianSplat> Splats;
+		for (int32 i = 0; i < 16; ++i)
+		{
+			FGaussianSplat Splat = FGaussianSplat::FromPositionColor(FVector(i, i * 2, i * 3), FColor(i * 10, 64, 192, 255));
+			Splat.SH_Rest[i] = 0.25f * i;
+			Splat.Opacity = 0.5f;
+			Splats.Add(Splat);
+		}
+
+		FGaussianSplatBuffer Buffer = FGaussianSplatBuffer::FromSplats(Splats);
+		TestEqual(TEXT("Buffer splat count"), Buffer.Num(), 16);
+		TestEqual(TEXT("Buffer SH_Rest count"), Buffer.SH_Rest.Num(), static_cast<int64>(16) * FGaussianSplatBuffer::NumSHRest);
+
+		TArray<FGaussianSplat> RoundTrip;
+		Buffer.ToSplats(RoundTrip);
+		TestEqual(TEXT("Round-trip splat count"), RoundTrip.Num(), Splats.Num());
+		TestTrue(TEXT("Round-trip position"), RoundTrip[7].Position.Equals(Splats[7].Position, 1e-4));
+		TestNearlyEqual(TEXT("Round-trip SH_Rest"), RoundTrip[7].SH_Rest[7], Splats[7].SH_Rest[7], 1e-6f);
+		TestNearlyEqual(TEXT("Round-trip opacity"), RoundTrip[7].Opacity, 0.5f, 1e-6f);
+
+		TArray<FString> Warnings;
+		TestTrue(TEXT("Buffer validation"), FPlyWriter::ValidateSplats(Buffer, Warnings));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpzRoundTripTest, "UE5_3DGS.FCM.Spz", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSpzRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Test 1: Smallest-three rotation packing
+	{
+		const FQuat4f Rotation = FQuat4f(FVector3f(0.3f, -0.5f, 0.8f).GetSafeNormal(), 2.1f);
+		const FQuat4f Unpacked = FSpzReader::UnpackRotation(FSpzWriter::PackRotation(Rotation));
+		TestTrue(TEXT("Rotation round-trip"), FMath::Abs(Unpacked | Rotation) > 0.99999f);
+	}
+
+	// Test 2: Encode and decode within quantization error
+	{
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(5000);
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f(i * 0.01f, -i * 0.02f, 3.0f);
+			Splats.SH_DC[i] = FVector3f(0.5f, -1.0f, 1.5f);
+			Splats.GetSHRest(i)[0] = 0.25f;
+			Splats.GetSHRest(i)[20] = -0.5f;
+			Splats.Opacities[i] = 0.6f;
+			Splats.Scales[i] = FVector3f(-4.0f, -5.0f, -6.0f);
+			Splats.Rotations[i] = FQuat4f(FVector3f(0, 0, 1), i * 0.001f);
+		}
+
+		TArray<uint8> Encoded;
+		TestTrue(TEXT("SPZ encode"), FSpzWriter::EncodeSpz(Splats, FSpzConfig(), Encoded));
+		TestTrue(TEXT("SPZ smaller than PLY"), Encoded.Num() < Splats.Num() * FPlyWriter::BytesPerGaussianSplat / 4);
+
+		TArray<ESpzSection> DecodedSections;
+		FGaussianSplatBuffer Decoded;
+		TestTrue(TEXT("SPZ decode"), FSpzReader::DecodeSpz(Encoded.GetData(), Encoded.Num(), Decoded,
+			[&DecodedSections](ESpzSection Section, const FGaussianSplatBuffer&) { DecodedSections.Add(Section); }));
+		TestEqual(TEXT("SPZ splat count"), Decoded.Num(), Splats.Num());
+		TestTrue(TEXT("SPZ positions decoded first"), DecodedSections.Num() > 0 && DecodedSections[0] == ESpzSection::Positions);
+
+		if (Decoded.Num() == Splats.Num())
+		{
+			bool bPositions = true, bOpacities = true, bColors = true, bScales = true, bRotations = true, bSH1 = true, bSH2 = true;
+			for (int32 i = 0; i < Splats.Num(); ++i)
+			{
+				bPositions &= Decoded.Positions[i].Equals(Splats.Positions[i], 0.5f / 4096.0f + 1e-5f);
+				bOpacities &= FMath::IsNearlyEqual(Decoded.Opacities[i], 0.6f, 1.0f / 510.0f + 1e-5f);
+				bColors &= Decoded.SH_DC[i].Equals(Splats.SH_DC[i], 0.014f);
+				bScales &= Decoded.Scales[i].Equals(Splats.Scales[i], 1.0f / 32.0f);
+				bRotations &= Decoded.Rotations[i].Equals(Splats.Rotations[i], 0.0021f);
+				bSH1 &= FMath::IsNearlyEqual(Decoded.GetSHRest(i)[0], 0.25f, 4.5f / 128.0f);
+				bSH2 &= FMath::IsNearlyEqual(Decoded.GetSHRest(i)[20], -0.5f, 8.5f / 128.0f);
+			}
+
+			TestTrue(TEXT("SPZ position"), bPositions);
+			TestTrue(TEXT("SPZ opacity"), bOpacities);
+			TestTrue(TEXT("SPZ color"), bColors);
+			TestTrue(TEXT("SPZ scale"), bScales);
+			TestTrue(TEXT("SPZ rotation"), bRotations);
+			TestTrue(TEXT("SPZ SH degree 1"), bSH1);
+			TestTrue(TEXT("SPZ SH degree 2"), bSH2);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSHCodebookTest, "UE5_3DGS.FCM.SHCodebook", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSHCodebookTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Four distinct SH vectors: a 4-entry codebook reproduces them exactly
+	FGaussianSplatBuffer Splats;
+	Splats.SetNum(2000);
+	for (int32 i = 0; i < Splats.Num(); ++i)
+	{
+		float* Rest = Splats.GetSHRest(i);
+		for (int32 d = 0; d < FGaussianSplatBuffer::NumSHRest; ++d)
+		{
+			Rest[d] = 0.1f * ((i % 4) - 1.5f) * ((d % 3) + 1);
+		}
+		Splats.Rotations[i] = FQuat4f::Identity;
+	}
+
+	FSHCodebookConfig Config;
+	Config.NumEntries = 4;
+
+	// Seeds are distinct vectors, so each pattern seeds its own entry and the
+	// only error left is float rounding of values below 0.5 (about 3e-8 each)
+	FSHCodebook Codebook;
+	TestTrue(TEXT("Codebook build"), FSHCodebook::Build(Splats, Config, Codebook));
+	TestEqual(TEXT("Codebook entries"), Codebook.NumEntries(), 4);
+	TestEqual(TEXT("Codebook indices"), Codebook.Indices.Num(), Splats.Num());
+	TestTrue(TEXT("Codebook error reported"), Codebook.MeanSquaredError < 1e-12 && Codebook.MaxError < 1e-6f);
+
+	// Asking for more entries than distinct vectors yields one entry per vector
+	{
+		FSHCodebookConfig LargeConfig;
+		LargeConfig.NumEntries = 16;
+
+		FSHCodebook Large;
+		TestTrue(TEXT("Codebook build oversized"), FSHCodebook::Build(Splats, LargeConfig, Large));
+		TestEqual(TEXT("Codebook oversized entries"), Large.NumEntries(), 4);
+	}
+
+	// SPZ codebook extension round-trip
+	FSpzConfig SpzConfig;
+	SpzConfig.SHCodebook = &Codebook;
+
+	TArray<uint8> Encoded;
+	TestTrue(TEXT("SPZ codebook encode"), FSpzWriter::EncodeSpz(Splats, SpzConfig, Encoded));
+
+	FGaussianSplatBuffer Decoded;
+	TestTrue(TEXT("SPZ codebook decode"), FSpzReader::DecodeSpz(Encoded.GetData(), Encoded.Num(), Decoded));
+	if (Decoded.Num() == Splats.Num())
+	{
+		TestNearlyEqual(TEXT("SPZ codebook SH"), Decoded.GetSHRest(7)[44], Splats.GetSHRest(7)[44], 1.0f / 128.0f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpatialSortTest, "UE5_3DGS.FCM.SpatialSort", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSpatialSortTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Test 1: Radix sort is ordered and stable across several batches
+	{
+		FRandomStream Random(7);
+		TArray<uint64> Keys;
+		Keys.SetNumUninitialized(3 * FSpatialSort::BatchSize + 17);
+		for (uint64& Key : Keys)
+		{
+			Key = (static_cast<uint64>(Random.RandHelper(1000)) << 40) | static_cast<uint64>(Random.RandHelper(4));
+		}
+		const TArray<uint64> Original = Keys;
+
+		TArray<int32> Order;
+		FSpatialSort::RadixSort(Keys, Order);
+
+		bool bSorted = true;
+		for (int32 i = 0; i < Keys.Num(); ++i)
+		{
+			bSorted &= (Original[Order[i]] == Keys[i]);
+			if (i > 0)
+			{
+				bSorted &= Keys[i - 1] < Keys[i] || (Keys[i - 1] == Keys[i] && Order[i - 1] < Order[i]);
+			}
+		}
+		TestTrue(TEXT("Radix sort ordered and stable"), bSorted);
+	}
+
+	// Test 2: Hilbert order visits a grid one neighbouring cell at a time
+	{
+		TArray<FVector3f> Positions;
+		for (int32 x = 0; x < 4; ++x)
+		{
+			for (int32 y = 0; y < 4; ++y)
+			{
+				for (int32 z = 0; z < 4; ++z)
+				{
+					Positions.Add(FVector3f(x, y, z));
+				}
+			}
+		}
+		Positions.Add(FVector3f(NAN, 0.0f, 0.0f));
+
+		TArray<int32> Order;
+		FSpatialSort::ComputeOrder(Positions, ESpatialCurve::Hilbert, Order);
+
+		bool bAdjacent = true;
+		for (int32 i = 1; i < Order.Num() - 1; ++i)
+		{
+			const FVector3f Step = Positions[Order[i]] - Positions[Order[i - 1]];
+			bAdjacent &= FMath::IsNearlyEqual(FMath::Abs(Step.X) + FMath::Abs(Step.Y) + FMath::Abs(Step.Z), 1.0f);
+		}
+		TestTrue(TEXT("Hilbert order adjacent"), bAdjacent);
+		TestEqual(TEXT("Non-finite position last"), Order.Last(), Positions.Num() - 1);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplatLodTest, "UE5_3DGS.FCM.SplatLod", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSplatLodTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Test 1: Merging two coincident splats keeps shape and sums opacity
+	{
+		FGaussianSplatBuffer Pair;
+		Pair.SetNum(2);
+		for (int32 i = 0; i < 2; ++i)
+		{
+			Pair.Positions[i] = FVector3f(1.0f, 2.0f, 3.0f);
+			Pair.Scales[i] = FVector3f(-2.0f, -3.0f, -4.0f);
+			Pair.Rotations[i] = FQuat4f(FVector3f(0.0f, 0.0f, 1.0f), 0.5f);
+			Pair.Opacities[i] = 0.3f;
+		}
+
+		FGaussianSplatBuffer Merged;
+		Merged.SetNum(1);
+		const int32 Indices[2] = { 0, 1 };
+		FSplatLodBuilder::MergeSplats(Pair, Indices, 2, Merged, 0);
+
+		TestTrue(TEXT("Merged position"), Merged.Positions[0].Equals(Pair.Positions[0], 1e-5f));
+		TestNearlyEqual(TEXT("Merged opacity"), Merged.Opacities[0], 0.6f, 1e-4f);
+
+		TArray<float> Scales = { Merged.Scales[0].X, Merged.Scales[0].Y, Merged.Scales[0].Z };
+		Scales.Sort();
+		TestTrue(TEXT("Merged scales"), FMath::IsNearlyEqual(Scales[0], -4.0f, 1e-3f) && FMath::IsNearlyEqual(Scales[2], -2.0f, 1e-3f));
+	}
+
+	// Test 2: Octree build and budgeted cut
+	{
+		FRandomStream Random(11);
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(5000);
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f(Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(0.0f, 2.0f));
+		}
+
+		FSplatLodConfig Config;
+		Config.MaxSplatsPerLeaf = 500;
+		Config.MaxSplatsPerNode = 512;
+
+		FSplatLodTree Tree;
+		TestTrue(TEXT("LOD build"), FSplatLodBuilder::Build(Splats, Config, Tree));
+		TestTrue(TEXT("Root reduced"), Tree.Nodes.Num() > 1 && Tree.Nodes[0].NumSplats <= Config.MaxSplatsPerNode);
+
+		int32 LeafSplats = 0;
+		for (const FSplatLodNode& Node : Tree.Nodes)
+		{
+			LeafSplats += Node.IsLeaf() ? Node.NumSplats : 0;
+		}
+		TestEqual(TEXT("Leaves hold every source splat"), LeafSplats, Splats.Num());
+
+		TArray<int32> Cut;
+		const int64 CutSplats = FSplatLodBuilder::SelectCut(Tree.Nodes, 2000, Cut);
+		TestTrue(TEXT("Cut within budget"), CutSplats <= 2000 && CutSplats >= Tree.Nodes[0].NumSplats);
+
+		// Every leaf is covered by exactly one cut node on its path to the root
+		bool bCovered = true;
+		for (int32 NodeIndex = 0; NodeIndex < Tree.Nodes.Num(); ++NodeIndex)
+		{
+			if (!Tree.Nodes[NodeIndex].IsLeaf())
+			{
+				continue;
+			}
+
+			int32 Hits = 0;
+			for (int32 Ancestor = NodeIndex; Ancestor != INDEX_NONE; Ancestor = Tree.Nodes[Ancestor].Parent)
+			{
+				Hits += Cut.Contains(Ancestor) ? 1 : 0;
+			}
+			bCovered &= (Hits == 1);
+		}
+		TestTrue(TEXT("Cut covers the scene once"), bCovered);
+
+		// Test 3: LOD file round-trip: node table and the cut's splats match the in-memory tree
+		const FString LodPath = FPaths::AutomationTransientDir() / TEXT("SplatLod.slod");
+		TestTrue(TEXT("LOD write"), FSplatLodBuilder::WriteLodFile(LodPath, Tree));
+
+		TArray<FSplatLodNode> FileNodes;
+		TestTrue(TEXT("LOD read index"), FSplatLodBuilder::ReadLodIndex(LodPath, FileNodes));
+		TestEqual(TEXT("LOD node count"), FileNodes.Num(), Tree.Nodes.Num());
+
+		if (FileNodes.Num() == Tree.Nodes.Num())
+		{
+			bool bNodesMatch = true;
+			for (int32 NodeIndex = 0; NodeIndex < FileNodes.Num(); ++NodeIndex)
+			{
+				const FSplatLodNode& Expected = Tree.Nodes[NodeIndex];
+				const FSplatLodNode& Actual = FileNodes[NodeIndex];
+				bNodesMatch &= Actual.Bounds.Min == Expected.Bounds.Min && Actual.Bounds.Max == Expected.Bounds.Max;
+				bNodesMatch &= Actual.Parent == Expected.Parent && Actual.FirstChild == Expected.FirstChild && Actual.NumChildren == Expected.NumChildren;
+				bNodesMatch &= Actual.Depth == Expected.Depth && Actual.GeometricError == Expected.GeometricError;
+				bNodesMatch &= Actual.FirstSplat == Expected.FirstSplat && Actual.NumSplats == Expected.NumSplats;
+			}
+			TestTrue(TEXT("LOD node table"), bNodesMatch);
+
+			TArray<int32> FileCut;
+			TestEqual(TEXT("LOD file cut size"), FSplatLodBuilder::SelectCut(FileNodes, 2000, FileCut), CutSplats);
+			TestTrue(TEXT("LOD file cut"), FileCut == Cut);
+
+			FGaussianSplatBuffer CutSplatBuffer;
+			TestTrue(TEXT("LOD read nodes"), FSplatLodBuilder::ReadLodNodes(LodPath, FileNodes, FileCut, CutSplatBuffer));
+			TestEqual(TEXT("LOD read splat count"), static_cast<int64>(CutSplatBuffer.Num()), CutSplats);
+
+			if (CutSplatBuffer.Num() == CutSplats)
+			{
+				bool bSplatsMatch = true;
+				int32 Cursor = 0;
+				for (int32 NodeIndex : FileCut)
+				{
+					const FSplatLodNode& Node = Tree.Nodes[NodeIndex];
+					for (int32 i = 0; i < Node.NumSplats; ++i, ++Cursor)
+					{
+						const int32 Source = Node.FirstSplat + i;
+						bSplatsMatch &= CutSplatBuffer.Positions[Cursor] == Tree.Splats.Positions[Source];
+						bSplatsMatch &= CutSplatBuffer.Scales[Cursor] == Tree.Splats.Scales[Source];
+						bSplatsMatch &= CutSplatBuffer.Rotations[Cursor].Equals(Tree.Splats.Rotations[Source], 0.0f);
+						bSplatsMatch &= CutSplatBuffer.Opacities[Cursor] == Tree.Splats.Opacities[Source];
+						bSplatsMatch &= CutSplatBuffer.SH_DC[Cursor] == Tree.Splats.SH_DC[Source];
+						bSplatsMatch &= FMemory::Memcmp(CutSplatBuffer.GetSHRest(Cursor), Tree.Splats.GetSHRest(Source), FGaussianSplatBuffer::NumSHRest * sizeof(float)) == 0;
+					}
+				}
+				TestTrue(TEXT("LOD read splats"), bSplatsMatch);
+			}
+		}
+
+		IFileManager::Get().Delete(*LodPath);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSHDegreeReductionTest, "UE5_3DGS.FCM.SHDegreeReduction", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSHDegreeReductionTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Splat i carries energy only up to band i % 4
+	constexpr int32 CoeffsPerChannel = FGaussianSplatBuffer::NumSHRest / 3;
+	FGaussianSplatBuffer Splats;
+	Splats.SetNum(400);
+	for (int32 i = 0; i < Splats.Num(); ++i)
+	{
+		const int32 Kept = FSHDegreeReduction::GetCoeffsPerChannel(i % 4);
+		float* Rest = Splats.GetSHRest(i);
+		for (int32 Channel = 0; Channel < 3; ++Channel)
+		{
+			for (int32 Coeff = 0; Coeff < CoeffsPerChannel; ++Coeff)
+			{
+				Rest[Channel * CoeffsPerChannel + Coeff] = (Coeff < Kept) ? 0.2f : 0.0f;
+			}
+		}
+		Splats.Opacities[i] = 1.0f;
+	}
+
+	FSHDegreeReduction Reduction;
+	TestTrue(TEXT("Degree build"), FSHDegreeReduction::Build(Splats, FSHDegreeConfig(), Reduction));
+	TestEqual(TEXT("Degree of band-limited splat"), static_cast<int32>(Reduction.Degrees[6]), 2);
+	for (int32 Degree = 0; Degree <= FSHDegreeReduction::MaxDegree; ++Degree)
+	{
+		TestEqual(TEXT("Splats per degree"), Reduction.NumPerDegree[Degree], 100);
+	}
+	TestEqual(TEXT("SH bytes"), Reduction.GetSHRestBytes(), static_cast<int64>(100) * 3 * (0 + 3 + 8 + 15) * sizeof(float));
+
+	// A transparent splat drops everything when errors are weighted by opacity
+	Splats.Opacities[3] = 0.0f;
+	TestTrue(TEXT("Degree rebuild"), FSHDegreeReduction::Build(Splats, FSHDegreeConfig(), Reduction));
+	TestEqual(TEXT("Transparent splat degree"), static_cast<int32>(Reduction.Degrees[3]), 0);
+
+	TArray<int32> Order;
+	Reduction.GetBucketOrder(Order);
+	TestTrue(TEXT("Bucket order"), Order.Num() == Splats.Num() && Order[0] == 0 && Order[1] == 3 && Order.Last() == 399);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplatPruningTest, "UE5_3DGS.FCM.SplatPruning", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSplatPruningTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// 100 distinct splats, each stacked with a near-coincident duplicate, plus rejects
+	FGaussianSplatBuffer Splats;
+	Splats.SetNum(205);
+	for (int32 i = 0; i < 200; ++i)
+	{
+		const int32 Site = i / 2;
+		Splats.Positions[i] = FVector3f(Site % 10, Site / 10, 0.0f) + FVector3f((i % 2) * 0.001f);
+		Splats.Scales[i] = FVector3f(-3.0f);
+		Splats.Opacities[i] = 0.4f;
+	}
+	Splats.Opacities[200] = 0.001f;
+	Splats.Opacities[201] = 0.5f;
+	Splats.Scales[201] = FVector3f(-12.0f);
+	Splats.Positions[202] = FVector3f(NAN, 0.0f, 0.0f);
+	Splats.Positions[203] = FVector3f(50.0f, 0.0f, 0.0f);
+	Splats.Positions[204] = FVector3f(50.0f, 0.0f, 0.005f);
+
+	FSplatPruneConfig Config;
+	Config.MinProjectedRadius = 0.5f;
+	Config.ReferenceDistance = 10.0f;
+	Config.MergeDistance = 0.01f;
+
+	FGaussianSplatBuffer Pruned;
+	FSplatPruneStats Stats;
+	TArray<int32> Sources;
+	TestTrue(TEXT("Prune"), FSplatPruner::Prune(Splats, Config, Pruned, Stats, &Sources));
+
+	TestEqual(TEXT("Invalid removed"), Stats.NumInvalid, 1);
+	TestEqual(TEXT("Transparent removed"), Stats.NumTransparent, 1);
+	TestEqual(TEXT("Small removed"), Stats.NumTooSmall, 1);
+	TestEqual(TEXT("Duplicates merged"), Stats.NumMerged, 101);
+	TestEqual(TEXT("Output count"), Pruned.Num(), 101);
+	TestEqual(TEXT("Stats output"), Stats.NumOutput, Pruned.Num());
+
+	if (Pruned.Num() == 101 && Sources.Num() == 101)
+	{
+		TestEqual(TEXT("Source order kept"), Sources[1], 2);
+		TestTrue(TEXT("Merged position"), Pruned.Positions[1].Equals(FVector3f(1.0005f, 0.0005f, 0.0005f), 1e-4f));
+		TestTrue(TEXT("Merged opacity"), Pruned.Opacities[1] > Splats.Opacities[2]);
+	}
+
+	// A line sampled at 0.6x MergeDistance does not chain into one splat: every
+	// other splat leads a cluster, each absorbing the next one
+	{
+		FGaussianSplatBuffer Line;
+		Line.SetNum(20);
+		for (int32 i = 0; i < Line.Num(); ++i)
+		{
+			Line.Positions[i] = FVector3f(i * 0.6f * Config.MergeDistance, 0.0f, 0.0f);
+			Line.Scales[i] = FVector3f(-3.0f);
+			Line.Opacities[i] = 0.4f;
+		}
+
+		FSplatPruneConfig LineConfig;
+		LineConfig.MergeDistance = Config.MergeDistance;
+
+		FGaussianSplatBuffer LinePruned;
+		FSplatPruneStats LineStats;
+		TArray<int32> LineSources;
+		TestTrue(TEXT("Prune line"), FSplatPruner::Prune(Line, LineConfig, LinePruned, LineStats, &LineSources));
+		TestEqual(TEXT("Line clusters"), LinePruned.Num(), 10);
+
+		bool bLeadersSpaced = LineSources.Num() == LinePruned.Num();
+		for (int32 i = 0; bLeadersSpaced && i < LineSources.Num(); ++i)
+		{
+			bLeadersSpaced &= LineSources[i] == 2 * i;
+		}
+		TestTrue(TEXT("Line leaders"), bLeadersSpaced);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplatStatisticsTest, "UE5_3DGS.FCM.SplatStatistics", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSplatStatisticsTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Spans several batches; two splats are corrupted
+	FGaussianSplatBuffer Splats;
+	Splats.SetNum(150000);
+	for (int32 i = 0; i < Splats.Num(); ++i)
+	{
+		Splats.Positions[i] = FVector3f((i % 2) ? 4.0f : -2.0f, 1.0f, 0.0f);
+		Splats.Opacities[i] = (i % 2) ? 1.0f : 0.0f;
+	}
+	Splats.Positions[10] = FVector3f(NAN, 0.0f, 0.0f);
+	Splats.Scales[11] = FVector3f(INFINITY, 0.0f, 0.0f);
+	Splats.Rotations[12] = FQuat4f(0.0f, 0.0f, 0.0f, 2.0f);
+
+	FSplatStatistics Statistics;
+	TestTrue(TEXT("Statistics computed"), FSplatStatistics::Compute(Splats, FSplatStatisticsConfig(), Statistics));
+
+	TestEqual(TEXT("Splat count"), Statistics.NumSplats, Splats.Num());
+	TestEqual(TEXT("NaN splats"), Statistics.NumWithNaN, static_cast<int64>(1));
+	TestEqual(TEXT("Inf splats"), Statistics.NumWithInf, static_cast<int64>(1));
+	TestEqual(TEXT("Invalid positions"), Statistics.NumInvalidPositions, static_cast<int64>(1));
+	TestEqual(TEXT("Non-unit rotations"), Statistics.NumNonUnitQuaternions, static_cast<int64>(1));
+	TestFalse(TEXT("Report invalid"), Statistics.IsValid());
+
+	TestTrue(TEXT("Bounds"), Statistics.Bounds.Min.Equals(FVector3d(-2.0, 1.0, 0.0)) && Statistics.Bounds.Max.Equals(FVector3d(4.0, 1.0, 0.0)));
+	TestNearlyEqual(TEXT("Centroid"), Statistics.Centroid.X, 1.0, 1e-3);
+	TestNearlyEqual(TEXT("Mean opacity"), Statistics.Opacity.GetMean(), 0.5, 1e-9);
+	TestEqual(TEXT("Opacity histogram edges"), Statistics.Opacity.Bins[0] + Statistics.Opacity.Bins.Last(), static_cast<int64>(Splats.Num()));
+
+	const FString Json = Statistics.ToJson();
+	TestTrue(TEXT("JSON report"), Json.Contains(TEXT("\"nonUnitQuaternions\"")) && Json.Contains(TEXT("\"histogram\"")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPointKdTreeTest, "UE5_3DGS.FCM.PointKdTree", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPointKdTreeTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Test 1: K nearest match a brute-force search, with duplicates and a non-finite point
+	{
+		FRandomStream Random(13);
+		TArray<FVector3f> Points;
+		Points.SetNumUninitialized(3000);
+		for (FVector3f& Point : Points)
+		{
+			Point = FVector3f(Random.FRandRange(-5.0f, 5.0f), Random.FRandRange(-5.0f, 5.0f), Random.FRandRange(-0.5f, 0.5f));
+		}
+		for (int32 i = 0; i < 50; ++i)
+		{
+			Points[i] = Points[i + 50];
+		}
+		Points[100] = FVector3f(NAN, 0.0f, 0.0f);
+
+		FPointKdTree Tree;
+		Tree.Build(Points);
+		TestEqual(TEXT("Non-finite point skipped"), Tree.Num(), Points.Num() - 1);
+
+		bool bMatches = true;
+		for (int32 Query = 0; Query < 200; ++Query)
+		{
+			if (Query == 100)
+			{
+				continue;
+			}
+
+			const int32 K = 1 + Query % 16;
+			int32 Neighbors[FPointKdTree::MaxNeighbors];
+			float DistancesSquared[FPointKdTree::MaxNeighbors];
+			bMatches &= Tree.FindNearest(Points[Query], K, Neighbors, DistancesSquared, Query) == K;
+
+			TArray<float> Expected;
+			for (int32 i = 0; i < Points.Num(); ++i)
+			{
+				if (i != Query && i != 100)
+				{
+					Expected.Add(FVector3f::DistSquared(Points[i], Points[Query]));
+				}
+			}
+			Expected.Sort();
+
+			for (int32 k = 0; k < K; ++k)
+			{
+				bMatches &= DistancesSquared[k] == Expected[k];
+				bMatches &= Neighbors[k] != Query;
+			}
+		}
+		TestTrue(TEXT("KNN matches brute force"), bMatches);
+	}
+
+	// Test 2: Initial splat scales follow the point spacing (3 nearest neighbours on a 0.1 grid)
+	{
+		TArray<FPointCloudPoint> Points;
+		for (int32 x = 0; x < 10; ++x)
+		{
+			for (int32 y = 0; y < 10; ++y)
+			{
+				for (int32 z = 0; z < 10; ++z)
+				{
+					FPointCloudPoint& Point = Points.AddDefaulted_GetRef();
+					Point.Position = FVector(x, y, z) * 0.1;
+				}
+			}
+		}
+
+		const FGaussianSplatBuffer Splats = FPlyWriter::CreateSplatBufferFromPointCloud(Points);
+		TestNearlyEqual(TEXT("Scale from spacing"), Splats.Scales[555].X, FMath::Loge(0.1f), 1e-4f);
+
+		const FGaussianSplatBuffer Uniform = FPlyWriter::CreateSplatBufferFromPointCloud(Points, -5.0f, 0);
+		TestEqual(TEXT("Uniform scale without neighbours"), Uniform.Scales[555].X, -5.0f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNormalEstimationTest, "UE5_3DGS.FCM.NormalEstimation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FNormalEstimationTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Tilted plane z = 0.5x seen from above, so every neighbourhood fits one plane
+	FRandomStream Random(17);
+	TArray<FPointCloudPoint> Points;
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		const float X = Random.FRandRange(-1.0f, 1.0f);
+		const float Y = Random.FRandRange(-1.0f, 1.0f);
+		FPointCloudPoint& Point = Points.AddDefaulted_GetRef();
+		Point.Position = FVector(X, Y, 0.5f * X);
+		Point.Normal = FVector::ZeroVector;
+	}
+
+	FNormalEstimationConfig Config;
+	Config.ViewPositions.Add(FVector3f(0.0f, 0.0f, 10.0f));
+
+	int32 NumEstimated = 0;
+	TestTrue(TEXT("Normals estimated"), FNormalEstimator::EstimateNormals(Points, Config, &NumEstimated));
+	TestEqual(TEXT("Every point estimated"), NumEstimated, Points.Num());
+
+	const FVector Expected = FVector(-0.5, 0.0, 1.0).GetSafeNormal();
+	bool bMatches = true;
+	for (const FPointCloudPoint& Point : Points)
+	{
+		bMatches &= FVector::DotProduct(Point.Normal, Expected) > 0.999;
+	}
+	TestTrue(TEXT("Normals match plane and face the view"), bMatches);
+
+	// Collinear neighbourhood keeps the given normal
+	TArray<FPointCloudPoint> Line;
+	for (int32 i = 0; i < 20; ++i)
+	{
+		FPointCloudPoint& Point = Line.AddDefaulted_GetRef();
+		Point.Position = FVector(i * 0.1, 0.0, 0.0);
+	}
+	TestTrue(TEXT("Line processed"), FNormalEstimator::EstimateNormals(Line, Config, &NumEstimated));
+	TestEqual(TEXT("Line not estimated"), NumEstimated, 0);
+	TestEqual(TEXT("Line keeps normal"), Line[5].Normal, FVector::UpVector);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVoxelDownsampleTest, "UE5_3DGS.FCM.PointCloudFilter.VoxelDownsample", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FVoxelDownsampleTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Two points per 0.125 voxel of a 10x10x10 grid (binary fractions keep voxel boundaries exact)
+	TArray<FPointCloudPoint> Points;
+	for (int32 x = 0; x < 10; ++x)
+	{
+		for (int32 y = 0; y < 10; ++y)
+		{
+			for (int32 z = 0; z < 10; ++z)
+			{
+				FPointCloudPoint& A = Points.AddDefaulted_GetRef();
+				A.Position = FVector(x, y, z) * 0.125;
+				A.Color = FColor(100, 0, 0);
+
+				FPointCloudPoint& B = Points.AddDefaulted_GetRef();
+				B.Position = A.Position + FVector(0.0625);
+				B.Color = FColor(200, 0, 0);
+			}
+		}
+	}
+	Points.AddDefaulted_GetRef().Position = FVector(NAN, 0.0, 0.0);
+
+	// Test 1: Fixed voxel size averages each pair
+	{
+		FVoxelDownsampleConfig Config;
+		Config.VoxelSize = 0.125f;
+
+		TArray<FPointCloudPoint> Downsampled;
+		TestTrue(TEXT("Downsampled"), FPointCloudFilter::VoxelDownsample(Points, Config, Downsampled));
+		TestEqual(TEXT("One point per voxel"), Downsampled.Num(), 1000);
+
+		bool bAveraged = true;
+		for (const FPointCloudPoint& Point : Downsampled)
+		{
+			const FVector Voxel = Point.Position / 0.125;
+			bAveraged &= FVector(FMath::Frac(Voxel.X), FMath::Frac(Voxel.Y), FMath::Frac(Voxel.Z)).Equals(FVector(0.25), 1e-6);
+			bAveraged &= Point.Color.R == 150;
+			bAveraged &= Point.Normal.Equals(FVector::UpVector);
+		}
+		TestTrue(TEXT("Position, color and normal averaged"), bAveraged);
+	}
+
+	// Test 2: A point budget grows the voxel size until the output fits
+	{
+		FVoxelDownsampleConfig Config;
+		Config.VoxelSize = 0.125f;
+		Config.TargetPoints = 200;
+
+		TArray<FPointCloudPoint> Downsampled;
+		float VoxelSize = 0.0f;
+		TestTrue(TEXT("Budget downsampled"), FPointCloudFilter::VoxelDownsample(Points, Config, Downsampled, &VoxelSize));
+		TestTrue(TEXT("Within budget"), Downsampled.Num() > 0 && Downsampled.Num() <= 200);
+		TestTrue(TEXT("Voxel size grown"), VoxelSize > 0.125f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOutlierRemovalTest, "UE5_3DGS.FCM.PointCloudFilter.OutlierRemoval", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOutlierRemovalTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Dense 0.1 grid plus far strays and a non-finite point
+	TArray<FPointCloudPoint> Points;
+	for (int32 x = 0; x < 20; ++x)
+	{
+		for (int32 y = 0; y < 20; ++y)
+		{
+			for (int32 z = 0; z < 5; ++z)
+			{
+				Points.AddDefaulted_GetRef().Position = FVector(x * 0.1, y * 0.1, z * 0.1);
+			}
+		}
+	}
+	const int32 NumGrid = Points.Num();
+	Points.AddDefaulted_GetRef().Position = FVector(10.0, 0.0, 0.0);
+	Points.AddDefaulted_GetRef().Position = FVector(0.0, -10.0, 3.0);
+	Points.AddDefaulted_GetRef().Position = FVector(NAN, 0.0, 0.0);
+
+	// Test 1: Statistical test removes the strays only
+	{
+		FOutlierRemovalConfig Config;
+		Config.NumNeighbors = 8;
+		Config.StdDevMultiplier = 3.0f;
+
+		TArray<FPointCloudPoint> Filtered;
+		FOutlierRemovalStats Stats;
+		TestTrue(TEXT("Statistical removal"), FPointCloudFilter::RemoveOutliers(Points, Config, Filtered, Stats));
+		TestEqual(TEXT("Statistical removed"), Stats.NumStatistical, 2);
+		TestEqual(TEXT("Invalid removed"), Stats.NumInvalid, 1);
+		TestEqual(TEXT("Grid kept"), Filtered.Num(), NumGrid);
+		TestEqual(TEXT("Output count"), Stats.NumOutput, Filtered.Num());
+	}
+
+	// Test 2: Radius test alone, with a threshold that also drops the grid corners
+	{
+		FOutlierRemovalConfig Config;
+		Config.NumNeighbors = 0;
+		Config.Radius = 0.105f;
+		Config.MinRadiusNeighbors = 4;
+
+		TArray<FPointCloudPoint> Filtered;
+		FOutlierRemovalStats Stats;
+		TestTrue(TEXT("Radius removal"), FPointCloudFilter::RemoveOutliers(Points, Config, Filtered, Stats));
+		TestEqual(TEXT("Statistical disabled"), Stats.NumStatistical, 0);
+		TestEqual(TEXT("Radius removed strays and corners"), Stats.NumRadius, 2 + 8);
+	}
+
 	return true;
 }
@@ -13,11 +13,22 @@
 #include "Misc/AutomationTest.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Compression.h"
 
 #include "FCM/CoordinateConverter.h"
 #include "FCM/CameraIntrinsics.h"
 #include "FCM/ColmapWriter.h"
 #include "FCM/PlyWriter.h"
+#include "FCM/PlyAppendWriter.h"
+#include "FCM/SpzWriter.h"
+#include "FCM/SpzReader.h"
+#include "FCM/ExternalSort.h"
+#include "FCM/SplatChunkFile.h"
+#include "FCM/GltfWriter.h"
+#include "FCM/SHDegreeReduction.h"
+#include "DEM/DepthExtractor.h"
+#include "DEM/ExrWriter.h"
 #include "SCM/CameraTrajectory.h"
 #include "SCM/CaptureOrchestrator.h"
 
@@ -115,7 +126,7 @@ bool FPipelineIntegrationTest::RunTest(const FString& Parameters)
 
 	// Step 9: Verify memory estimates
 	int64 EstimatedMemory = FPlyWriter::EstimateMemoryUsage(Splats.Num());
-	int64 ExpectedMemory = Splats.Num() * 236; // 236 bytes per splat
+	int64 ExpectedMemory = Splats.Num() * 248; // 248 bytes per splat
 
 	TestEqual(TEXT("Pipeline: Memory estimate"), EstimatedMemory, ExpectedMemory);
 
@@ -310,9 +321,10 @@ bool FPlyComplianceTest::RunTest(const FString& Parameters)
 	{
 		FGaussianSplat Splat;
 
-		// Verify size (236 bytes per 3DGS paper)
+		// Verify size (248 bytes per binary PLY row)
 		// Position: 12, Normal: 12, SH_DC: 12, SH_Rest: 180, Opacity: 4, Scale: 12, Rotation: 16
-		// Total: 12 + 12 + 12 + 180 + 4 + 12 + 16 = 248 (our struct may differ slightly)
+		// Total: 12 + 12 + 12 + 180 + 4 + 12 + 16 = 248
+		TestEqual(TEXT("PLY: Bytes per splat"), FPlyWriter::BytesPerGaussianSplat, 12 + 12 + 12 + 180 + 4 + 12 + 16);
 
 		// Check SH coefficient count
 		TestEqual(TEXT("PLY: SH_Rest count"), Splat.SH_Rest.Num(), 45);
@@ -401,6 +413,778 @@ bool FPlyComplianceTest::RunTest(const FString& Parameters)
 		}
 	}
 
+	// Test binary write/read round-trip preserves every property
+	{
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(2048);
+
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f(i * 0.01f, -i * 0.02f, i * 0.03f);
+			Splats.SH_DC[i] = FVector3f(0.1f, 0.2f, 0.3f);
+			Splats.GetSHRest(i)[i % FGaussianSplatBuffer::NumSHRest] = 0.5f;
+			Splats.Opacities[i] = 0.75f;
+			Splats.Scales[i] = FVector3f(-4.0f, -5.0f, -6.0f);
+			Splats.Rotations[i] = FQuat4f(FVector3f(0, 0, 1), i * 0.001f);
+		}
+
+		const FString PlyPath = FPaths::AutomationTransientDir() / TEXT("PlyRoundTrip.ply");
+		TestTrue(TEXT("PLY: Round-trip write"), FPlyWriter::WriteGaussianSplats(PlyPath, Splats, true));
+
+		FPlySchema Header;
+		TestTrue(TEXT("PLY: Header probe"), FPlyWriter::ReadPlyHeader(PlyPath, Header));
+		if (Header.Elements.Num() == 1)
+		{
+			TestEqual(TEXT("PLY: Header probe vertex stride"), Header.Elements[0].Stride, FPlyWriter::BytesPerGaussianSplat);
+			TestEqual(TEXT("PLY: Header probe data offset"), Header.DataOffset + Header.Elements[0].Count * Header.Elements[0].Stride, IFileManager::Get().FileSize(*PlyPath));
+		}
+
+		// end_header ending exactly at the probe boundary, its newline just past it
+		{
+			const FString Head = TEXT("ply\nformat binary_little_endian 1.0\ncomment ");
+			const FString Tail = TEXT("\nelement vertex 1\nproperty float x\nproperty float y\nproperty float z\nend_header");
+			const FString BoundaryHeader = Head + FString::ChrN(FPlyWriter::HeaderProbeBytes - Head.Len() - Tail.Len(), TEXT('x')) + Tail + TEXT("\n");
+
+			FTCHARToUTF8 HeaderBytes(*BoundaryHeader);
+			TArray<uint8> Bytes(reinterpret_cast<const uint8*>(HeaderBytes.Get()), HeaderBytes.Length());
+			Bytes.AddZeroed(3 * sizeof(float));
+
+			const FString BoundaryPath = FPaths::AutomationTransientDir() / TEXT("HeaderBoundary.ply");
+			FFileHelper::SaveArrayToFile(Bytes, *BoundaryPath);
+
+			FPlySchema BoundarySchema;
+			TestTrue(TEXT("PLY: Header across probe boundary"), FPlyWriter::ReadPlyHeader(BoundaryPath, BoundarySchema));
+			TestEqual(TEXT("PLY: Header across probe boundary data offset"), BoundarySchema.DataOffset, static_cast<int64>(FPlyWriter::HeaderProbeBytes + 1));
+
+			IFileManager::Get().Delete(*BoundaryPath);
+		}
+
+		FGaussianSplatBuffer ReadBack;
+		TestTrue(TEXT("PLY: Round-trip read"), FPlyWriter::ReadGaussianSplats(PlyPath, ReadBack));
+		TestEqual(TEXT("PLY: Round-trip count"), ReadBack.Num(), Splats.Num());
+
+		if (ReadBack.Num() == Splats.Num())
+		{
+			const int32 i = 1234;
+			TestTrue(TEXT("PLY: Round-trip position"), ReadBack.Positions[i].Equals(Splats.Positions[i], 0.0f));
+			TestEqual(TEXT("PLY: Round-trip SH_Rest"), ReadBack.GetSHRest(i)[i % FGaussianSplatBuffer::NumSHRest], 0.5f);
+			TestEqual(TEXT("PLY: Round-trip opacity"), ReadBack.Opacities[i], 0.75f);
+			TestTrue(TEXT("PLY: Round-trip rotation"), ReadBack.Rotations[i].Equals(Splats.Rotations[i], 0.0f));
+		}
+
+		// Negative and oversized counts are rejected while parsing the header
+		for (const TCHAR* Count : { TEXT("-5"), TEXT("4294967296") })
+		{
+			const FString BadHeader = FString::Printf(TEXT("ply\nformat binary_little_endian 1.0\nelement vertex %s\nproperty float x\nproperty float y\nproperty float z\nend_header\n"), Count);
+			FFileHelper::SaveStringToFile(BadHeader, *PlyPath);
+			TestFalse(TEXT("PLY: Bad vertex count header"), FPlyWriter::ReadPlyHeader(PlyPath, Header));
+			TestFalse(TEXT("PLY: Bad vertex count read"), FPlyWriter::ReadGaussianSplats(PlyPath, ReadBack));
+		}
+
+		IFileManager::Get().Delete(*PlyPath);
+	}
+
+	// Test streaming binary writer: splats on both sides of a chunk boundary survive the round-trip
+	{
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(FPlyWriter::BinaryWriteChunkSplats + 100);
+
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f(i, i * 0.5f, -i * 0.25f);
+			Splats.Normals[i] = FVector3f(0.0f, 0.0f, (i & 1) ? 1.0f : -1.0f);
+			Splats.SH_DC[i] = FVector3f(i * 1e-4f, 0.2f, -0.3f);
+			for (int32 k = 0; k < FGaussianSplatBuffer::NumSHRest; ++k)
+			{
+				Splats.GetSHRest(i)[k] = (i % 97) * 0.01f - k * 0.001f;
+			}
+			Splats.Opacities[i] = (i % 100) * 0.01f;
+			Splats.Scales[i] = FVector3f(-4.0f, -5.0f, -6.0f - i * 1e-5f);
+			Splats.Rotations[i] = FQuat4f(FVector3f(0, 1, 0), i * 1e-4f);
+		}
+
+		const FString PlyPath = FPaths::AutomationTransientDir() / TEXT("PlyChunked.ply");
+		TestTrue(TEXT("PLY chunks: Write"), FPlyWriter::WriteGaussianSplats(PlyPath, Splats, true));
+
+		FPlySchema Header;
+		TestTrue(TEXT("PLY chunks: Header"), FPlyWriter::ReadPlyHeader(PlyPath, Header));
+		TestEqual(TEXT("PLY chunks: File size"), IFileManager::Get().FileSize(*PlyPath),
+			Header.DataOffset + static_cast<int64>(Splats.Num()) * FPlyWriter::BytesPerGaussianSplat);
+
+		FGaussianSplatBuffer ReadBack;
+		TestTrue(TEXT("PLY chunks: Read"), FPlyWriter::ReadGaussianSplats(PlyPath, ReadBack));
+		TestEqual(TEXT("PLY chunks: Count"), ReadBack.Num(), Splats.Num());
+
+		if (ReadBack.Num() == Splats.Num())
+		{
+			// Last splat of the first chunk and first splat of the second
+			for (const int32 i : { FPlyWriter::BinaryWriteChunkSplats - 1, FPlyWriter::BinaryWriteChunkSplats })
+			{
+				TestTrue(TEXT("PLY chunks: Position"), ReadBack.Positions[i] == Splats.Positions[i]);
+				TestTrue(TEXT("PLY chunks: Normal"), ReadBack.Normals[i] == Splats.Normals[i]);
+				TestTrue(TEXT("PLY chunks: SH DC"), ReadBack.SH_DC[i] == Splats.SH_DC[i]);
+				TestTrue(TEXT("PLY chunks: SH rest"), FMemory::Memcmp(ReadBack.GetSHRest(i), Splats.GetSHRest(i), FGaussianSplatBuffer::NumSHRest * sizeof(float)) == 0);
+				TestEqual(TEXT("PLY chunks: Opacity"), ReadBack.Opacities[i], Splats.Opacities[i]);
+				TestTrue(TEXT("PLY chunks: Scale"), ReadBack.Scales[i] == Splats.Scales[i]);
+				TestTrue(TEXT("PLY chunks: Rotation"), ReadBack.Rotations[i].Equals(Splats.Rotations[i], 0.0f));
+			}
+		}
+
+		IFileManager::Get().Delete(*PlyPath);
+	}
+
+	// Test decode plans for foreign layouts: double positions, both byte orders, reordered and extra properties
+	{
+		// Test hosts are little-endian, so big-endian values are stored byte-reversed
+		auto AppendScalar = [](TArray<uint8>& Bytes, auto Value, bool bBigEndian)
+		{
+			constexpr int32 Size = sizeof(Value);
+			uint8 Raw[Size];
+			FMemory::Memcpy(Raw, &Value, Size);
+			for (int32 b = 0; bBigEndian && b < Size / 2; ++b)
+			{
+				Swap(Raw[b], Raw[Size - 1 - b]);
+			}
+			Bytes.Append(Raw, Size);
+		};
+
+		auto HeaderBytes = [](const FString& Header)
+		{
+			FTCHARToUTF8 UTF8Header(*Header);
+			return TArray<uint8>(reinterpret_cast<const uint8*>(UTF8Header.Get()), UTF8Header.Length());
+		};
+
+		const FString PlyPath = FPaths::AutomationTransientDir() / TEXT("PlyForeignLayout.ply");
+
+		for (const bool bBigEndian : { false, true })
+		{
+			TArray<uint8> Bytes = HeaderBytes(FString::Printf(TEXT("ply\nformat %s 1.0\nelement vertex 2\n")
+				TEXT("property uchar flags\nproperty float opacity\nproperty double z\nproperty double x\nproperty double y\n")
+				TEXT("property float rot_0\nproperty float rot_1\nproperty float rot_2\nproperty float rot_3\n")
+				TEXT("property float scale_0\nproperty float scale_1\nproperty float scale_2\n")
+				TEXT("property float f_dc_0\nproperty float f_dc_1\nproperty float f_dc_2\nproperty int extra_id\nend_header\n"),
+				bBigEndian ? TEXT("binary_big_endian") : TEXT("binary_little_endian")));
+
+			for (int32 i = 0; i < 2; ++i)
+			{
+				AppendScalar(Bytes, static_cast<uint8>(0xab), bBigEndian);
+				AppendScalar(Bytes, 0.25f + i * 0.5f, bBigEndian);
+				AppendScalar(Bytes, -2.5 - i, bBigEndian);
+				AppendScalar(Bytes, 0.1 * (i + 1), bBigEndian);
+				AppendScalar(Bytes, 1e10, bBigEndian);
+				for (const float Value : { 0.1f, 0.2f, 0.3f, 0.9f, -1.0f, -2.0f, -3.0f - i, 0.5f, -0.5f, static_cast<float>(i) })
+				{
+					AppendScalar(Bytes, Value, bBigEndian);
+				}
+				AppendScalar(Bytes, 12345, bBigEndian);
+			}
+			FFileHelper::SaveArrayToFile(Bytes, *PlyPath);
+
+			FGaussianSplatBuffer Splats;
+			TestTrue(TEXT("PLY layout: Read foreign gaussian layout"), FPlyWriter::ReadGaussianSplats(PlyPath, Splats));
+			TestEqual(TEXT("PLY layout: Gaussian count"), Splats.Num(), 2);
+			for (int32 i = 0; i < Splats.Num(); ++i)
+			{
+				TestTrue(TEXT("PLY layout: Double positions"), Splats.Positions[i] == FVector3f(static_cast<float>(0.1 * (i + 1)), 1e10f, static_cast<float>(-2.5 - i)));
+				TestEqual(TEXT("PLY layout: Opacity"), Splats.Opacities[i], 0.25f + i * 0.5f);
+				TestTrue(TEXT("PLY layout: Rotation"), Splats.Rotations[i].Equals(FQuat4f(0.1f, 0.2f, 0.3f, 0.9f), 0.0f));
+				TestTrue(TEXT("PLY layout: Scale"), Splats.Scales[i] == FVector3f(-1.0f, -2.0f, -3.0f - i));
+				TestTrue(TEXT("PLY layout: SH DC"), Splats.SH_DC[i] == FVector3f(0.5f, -0.5f, i));
+				TestEqual(TEXT("PLY layout: Missing SH rest defaults to zero"), Splats.GetSHRest(i)[0], 0.0f);
+			}
+		}
+
+		// Point cloud with ushort colors, an alpha channel and an unmapped property between them
+		{
+			TArray<uint8> Bytes = HeaderBytes(TEXT("ply\nformat binary_little_endian 1.0\nelement vertex 2\n")
+				TEXT("property float x\nproperty float y\nproperty float z\nproperty ushort red\nproperty float confidence\n")
+				TEXT("property ushort green\nproperty ushort blue\nproperty uchar alpha\nend_header\n"));
+
+			for (int32 i = 0; i < 2; ++i)
+			{
+				AppendScalar(Bytes, 1.5f * i, false);
+				AppendScalar(Bytes, -0.75f, false);
+				AppendScalar(Bytes, 8.0f, false);
+				AppendScalar(Bytes, static_cast<uint16>(65535), false);
+				AppendScalar(Bytes, 0.5f, false);
+				AppendScalar(Bytes, static_cast<uint16>(128 * 257), false);
+				AppendScalar(Bytes, static_cast<uint16>(i * 257), false);
+				AppendScalar(Bytes, static_cast<uint8>(77 + i), false);
+			}
+			FFileHelper::SaveArrayToFile(Bytes, *PlyPath);
+
+			TArray<FPointCloudPoint> Points;
+			TestTrue(TEXT("PLY layout: Read ushort color point cloud"), FPlyWriter::ReadPointCloud(PlyPath, Points));
+			TestEqual(TEXT("PLY layout: Point count"), Points.Num(), 2);
+			for (int32 i = 0; i < Points.Num(); ++i)
+			{
+				TestTrue(TEXT("PLY layout: Point position"), Points[i].Position == FVector(1.5f * i, -0.75f, 8.0f));
+				TestTrue(TEXT("PLY layout: Ushort colors scaled to 8 bits"), Points[i].Color == FColor(255, 128, i, 77 + i));
+			}
+		}
+
+		IFileManager::Get().Delete(*PlyPath);
+	}
+
+	// Test SPZ write/read round-trip: every splat within the quantization bounds
+	{
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(3000);
+
+		FRandomStream Random(11);
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f(Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f));
+			Splats.SH_DC[i] = FVector3f(Random.FRandRange(-3.0f, 3.0f), Random.FRandRange(-3.0f, 3.0f), Random.FRandRange(-3.0f, 3.0f));
+			for (int32 k = 0; k < FGaussianSplatBuffer::NumSHRest; ++k)
+			{
+				Splats.GetSHRest(i)[k] = Random.FRandRange(-0.9f, 0.9f);
+			}
+			Splats.Opacities[i] = Random.FRand();
+			Splats.Scales[i] = FVector3f(Random.FRandRange(-9.0f, 5.0f), Random.FRandRange(-9.0f, 5.0f), Random.FRandRange(-9.0f, 5.0f));
+			Splats.Rotations[i] = FQuat4f(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f)).GetNormalized();
+		}
+
+		const FString SpzPath = FPaths::AutomationTransientDir() / TEXT("RoundTrip.spz");
+		const FSpzConfig Config;
+		TestTrue(TEXT("SPZ: Write"), FSpzWriter::WriteSpz(SpzPath, Splats, Config));
+
+		FGaussianSplatBuffer ReadBack;
+		TestTrue(TEXT("SPZ: Read"), FSpzReader::ReadSpz(SpzPath, ReadBack));
+		TestEqual(TEXT("SPZ: Count"), ReadBack.Num(), Splats.Num());
+
+		if (ReadBack.Num() == Splats.Num())
+		{
+			// Half a quantization step of each attribute (see FSpzReader)
+			const float PositionBound = 0.5f / (1 << Config.FractionalBits) + 1e-4f;
+			const float SH1Bound = 4.5f / 128.0f + 1e-5f;
+			const float SHRestBound = 8.5f / 128.0f + 1e-5f;
+
+			bool bPositions = true, bOpacities = true, bColors = true, bScales = true, bRotations = true, bSH = true;
+			for (int32 i = 0; i < Splats.Num(); ++i)
+			{
+				bPositions &= ReadBack.Positions[i].Equals(Splats.Positions[i], PositionBound);
+				bOpacities &= FMath::IsNearlyEqual(ReadBack.Opacities[i], Splats.Opacities[i], 1.0f / 510.0f + 1e-5f);
+				bColors &= ReadBack.SH_DC[i].Equals(Splats.SH_DC[i], 0.0131f);
+				bScales &= ReadBack.Scales[i].Equals(Splats.Scales[i], 1.0f / 32.0f + 1e-5f);
+
+				// Equals accepts q and -q, which are the same rotation
+				bRotations &= ReadBack.Rotations[i].Equals(Splats.Rotations[i], 0.0021f);
+
+				for (int32 Channel = 0; Channel < 3; ++Channel)
+				{
+					for (int32 Coeff = 0; Coeff < FGaussianSplatBuffer::NumSHRest / 3; ++Coeff)
+					{
+						const int32 k = Channel * (FGaussianSplatBuffer::NumSHRest / 3) + Coeff;
+						bSH &= FMath::IsNearlyEqual(ReadBack.GetSHRest(i)[k], Splats.GetSHRest(i)[k], Coeff < 3 ? SH1Bound : SHRestBound);
+					}
+				}
+			}
+
+			TestTrue(TEXT("SPZ: Positions"), bPositions);
+			TestTrue(TEXT("SPZ: Opacities"), bOpacities);
+			TestTrue(TEXT("SPZ: Colors"), bColors);
+			TestTrue(TEXT("SPZ: Scales"), bScales);
+			TestTrue(TEXT("SPZ: Rotations"), bRotations);
+			TestTrue(TEXT("SPZ: SH"), bSH);
+		}
+
+		IFileManager::Get().Delete(*SpzPath);
+	}
+
+	// Test chunked container: region reads return only the chunks that overlap
+	{
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(10000);
+
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f((i * 37) % 100, (i * 61) % 100, (i % 10) * 0.1f);
+			Splats.Opacities[i] = 0.5f;
+			Splats.Scales[i] = FVector3f(-6.0f);
+		}
+
+		FSplatChunkConfig Config;
+		Config.SplatsPerChunk = 1000;
+
+		const FString ChunkPath = FPaths::AutomationTransientDir() / TEXT("ChunkRoundTrip.splatchunks");
+		TArray<int32> Permutation;
+		TestTrue(TEXT("Chunks: Write"), FSplatChunkWriter::WriteChunkFile(ChunkPath, Splats, Config, &Permutation));
+		TestTrue(TEXT("Chunks: Smaller than PLY"), IFileManager::Get().FileSize(*ChunkPath) < static_cast<int64>(Splats.Num()) * FPlyWriter::BytesPerGaussianSplat);
+
+		FSplatChunkReader Reader;
+		TestTrue(TEXT("Chunks: Open"), Reader.Open(ChunkPath));
+		TestEqual(TEXT("Chunks: Chunk count"), Reader.GetChunks().Num(), 10);
+
+		FGaussianSplatBuffer Chunk;
+		TestTrue(TEXT("Chunks: Read by ID"), Reader.ReadChunks({ 3 }, Chunk));
+		if (Chunk.Num() == Config.SplatsPerChunk && Permutation.Num() == Splats.Num())
+		{
+			TestTrue(TEXT("Chunks: Splat matches permutation"), Chunk.Positions[5].Equals(Splats.Positions[Permutation[3 * Config.SplatsPerChunk + 5]], 0.0f));
+		}
+
+		const FBox3f Region(FVector3f(0.0f, 0.0f, 0.0f), FVector3f(20.0f, 20.0f, 1.0f));
+		FGaussianSplatBuffer Visible;
+		TestTrue(TEXT("Chunks: Read region"), Reader.ReadRegion(Region, Visible, true));
+		TestTrue(TEXT("Chunks: Region skips chunks"), Visible.Num() > 0 && Visible.Num() < Splats.Num());
+
+		Reader.Close();
+
+		// Corrupt chunk counts in the tail are rejected before the index is allocated
+		TArray<uint8> Bytes;
+		FFileHelper::LoadFileToArray(Bytes, *ChunkPath);
+		for (const uint32 BadCount : { 0xffffffffu, 1u << 30, 11u })
+		{
+			TArray<uint8> Corrupt = Bytes;
+			FMemory::Memcpy(Corrupt.GetData() + Corrupt.Num() - 2 * sizeof(uint32), &BadCount, sizeof(uint32));
+			FFileHelper::SaveArrayToFile(Corrupt, *ChunkPath);
+			TestFalse(TEXT("Chunks: Corrupt chunk count rejected"), Reader.Open(ChunkPath));
+		}
+
+		// A record offset chosen so that offset + stored bytes wraps past 2^64 is rejected
+		{
+			uint64 IndexOffset = 0;
+			FMemory::Memcpy(&IndexOffset, Bytes.GetData() + Bytes.Num() - 16, sizeof(uint64));
+
+			// Records hold six bounds floats, then the uint64 offset and the uint32 stored size
+			const uint8* FirstRecord = Bytes.GetData() + IndexOffset;
+			uint32 StoredBytes = 0;
+			FMemory::Memcpy(&StoredBytes, FirstRecord + 32, sizeof(uint32));
+			const uint64 WrappingOffset = MAX_uint64 - StoredBytes + 1 + 64;
+
+			TArray<uint8> Corrupt = Bytes;
+			FMemory::Memcpy(Corrupt.GetData() + IndexOffset + 24, &WrappingOffset, sizeof(uint64));
+			FFileHelper::SaveArrayToFile(Corrupt, *ChunkPath);
+			TestFalse(TEXT("Chunks: Wrapping chunk offset rejected"), Reader.Open(ChunkPath));
+		}
+
+		IFileManager::Get().Delete(*ChunkPath);
+	}
+
+	// Test degree-bucketed PLY: buckets shrink the file and read back in bucket order
+	{
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(300);
+
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f(i, 0.0f, 0.0f);
+			Splats.Opacities[i] = 0.9f;
+			Splats.GetSHRest(i)[0] = (i % 3 == 0) ? 0.5f : 0.0f;
+			Splats.GetSHRest(i)[44] = (i % 3 == 1) ? 0.5f : 0.0f;
+		}
+
+		FSHDegreeReduction Reduction;
+		TestTrue(TEXT("Degrees: Build"), FSHDegreeReduction::Build(Splats, FSHDegreeConfig(), Reduction));
+
+		const FString DegreePath = FPaths::AutomationTransientDir() / TEXT("DegreeBuckets.ply");
+		TArray<int32> Permutation;
+		TestTrue(TEXT("Degrees: Write"), FPlyWriter::WriteGaussianSplats(DegreePath, Splats, Reduction, &Permutation));
+		TestTrue(TEXT("Degrees: Smaller than full PLY"), IFileManager::Get().FileSize(*DegreePath) < static_cast<int64>(Splats.Num()) * FPlyWriter::BytesPerGaussianSplat);
+
+		FGaussianSplatBuffer ReadBack;
+		TestTrue(TEXT("Degrees: Read"), FPlyWriter::ReadGaussianSplats(DegreePath, ReadBack));
+		TestEqual(TEXT("Degrees: Count"), ReadBack.Num(), Splats.Num());
+
+		if (ReadBack.Num() == Splats.Num() && Permutation.Num() == Splats.Num())
+		{
+			bool bMatches = true;
+			for (int32 i = 0; i < ReadBack.Num(); ++i)
+			{
+				const int32 Source = Permutation[i];
+				bMatches &= ReadBack.Positions[i] == Splats.Positions[Source];
+				bMatches &= ReadBack.GetSHRest(i)[0] == Splats.GetSHRest(Source)[0];
+				bMatches &= ReadBack.GetSHRest(i)[44] == Splats.GetSHRest(Source)[44];
+			}
+			TestTrue(TEXT("Degrees: Round-trip"), bMatches);
+		}
+
+		IFileManager::Get().Delete(*DegreePath);
+	}
+
+	// Test glTF export: GLB header, chunk layout and quantized size
+	{
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(100);
+
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f(i * 0.1f, -i * 0.2f, 1.0f);
+			Splats.Opacities[i] = 0.5f;
+		}
+
+		const FString GlbPath = FPaths::AutomationTransientDir() / TEXT("Splats.glb");
+		TestTrue(TEXT("glTF: Write"), FGltfWriter::WriteGlb(GlbPath, Splats));
+
+		TArray<uint8> Glb;
+		TestTrue(TEXT("glTF: Read back"), FFileHelper::LoadFileToArray(Glb, *GlbPath));
+		if (Glb.Num() >= 20)
+		{
+			const uint32* Header = reinterpret_cast<const uint32*>(Glb.GetData());
+			TestEqual(TEXT("glTF: Magic"), Header[0], 0x46546c67u);
+			TestEqual(TEXT("glTF: Version"), Header[1], 2u);
+			TestEqual(TEXT("glTF: Length"), static_cast<int64>(Header[2]), static_cast<int64>(Glb.Num()));
+			TestEqual(TEXT("glTF: JSON chunk"), Header[4], 0x4e4f534au);
+			TestEqual(TEXT("glTF: JSON aligned"), Header[3] % 4, 0u);
+		}
+
+		FGltfConfig Quantized;
+		Quantized.bQuantize = true;
+		TestTrue(TEXT("glTF: Write quantized"), FGltfWriter::WriteGlb(GlbPath, Splats, Quantized));
+		TestTrue(TEXT("glTF: Quantized is smaller"), IFileManager::Get().FileSize(*GlbPath) < Glb.Num());
+
+		IFileManager::Get().Delete(*GlbPath);
+	}
+
+	// Test append-mode writing: batches, patched count and recovery of a truncated tail
+	{
+		const FString AppendPath = FPaths::AutomationTransientDir() / TEXT("Appended.ply");
+
+		TArray<FPointCloudPoint> Batch;
+		Batch.SetNum(1000);
+		for (int32 i = 0; i < Batch.Num(); ++i)
+		{
+			Batch[i].Position = FVector(i, -i, 0.5);
+			Batch[i].Color = FColor(i % 256, 0, 255);
+		}
+
+		{
+			FPlyAppendWriter Writer;
+			TestTrue(TEXT("Append: Open"), Writer.Open(AppendPath, EPlyAppendLayout::PointCloud, 1500));
+			for (int32 b = 0; b < 3; ++b)
+			{
+				TestTrue(TEXT("Append: Batch"), Writer.Append(Batch));
+			}
+			TestEqual(TEXT("Append: Count"), Writer.GetNumVertices(), 3000ll);
+			TestTrue(TEXT("Append: Close"), Writer.Close());
+		}
+
+		TArray<FPointCloudPoint> ReadBack;
+		TestTrue(TEXT("Append: Read"), FPlyWriter::ReadPointCloud(AppendPath, ReadBack));
+		TestEqual(TEXT("Append: Read count"), ReadBack.Num(), 3000);
+		if (ReadBack.Num() == 3000)
+		{
+			TestTrue(TEXT("Append: Last batch position"), ReadBack[2999].Position.Equals(Batch[999].Position));
+			TestEqual(TEXT("Append: Last batch color"), ReadBack[2999].Color.R, Batch[999].Color.R);
+		}
+
+		// One more complete row and half a row after the finalized data, as a crash would leave
+		TArray<uint8> Bytes;
+		FFileHelper::LoadFileToArray(Bytes, *AppendPath);
+		Bytes.AddZeroed(FPlyAppendWriter::BytesPerPoint + FPlyAppendWriter::BytesPerPoint / 2);
+		FFileHelper::SaveArrayToFile(Bytes, *AppendPath);
+
+		int64 Recovered = 0;
+		TestTrue(TEXT("Append: Recover"), FPlyAppendWriter::Recover(AppendPath, &Recovered));
+		TestEqual(TEXT("Append: Recovered count"), Recovered, 3001ll);
+
+		int32 NumVertices = 0;
+		bool bIsBinary = false;
+		bool bIsGaussian = false;
+		TestTrue(TEXT("Append: Info"), FPlyWriter::GetPlyInfo(AppendPath, NumVertices, bIsBinary, bIsGaussian));
+		TestEqual(TEXT("Append: Info count"), NumVertices, 3001);
+
+		IFileManager::Get().Delete(*AppendPath);
+	}
+
+	// Test ASCII point cloud reads: CRLF, exponents, irregular whitespace, header comments and truncation
+	{
+		const FString AsciiPath = FPaths::AutomationTransientDir() / TEXT("AsciiPoints.ply");
+		auto MakeHeader = [](int32 NumVertices)
+		{
+			return FString::Printf(TEXT("ply\r\nformat ascii 1.0\r\ncomment written with CRLF\r\nobj_info test\r\nelement vertex %d\r\n")
+				TEXT("property float x\r\nproperty float y\r\nproperty float z\r\nproperty uchar red\r\nproperty uchar green\r\nproperty uchar blue\r\nend_header\r\n"), NumVertices);
+		};
+
+		// The last row has no line ending
+		const FString Body = TEXT("1.5e2 -2.5E-1 +3 255 0 10\r\n  \t0.125   1e-3\t-0 1 2 3 \r\n-7.25 6.0e+1 .5 4 5 6\r\n1 2 3 7 8 9");
+		FFileHelper::SaveStringToFile(MakeHeader(4) + Body, *AsciiPath);
+
+		TArray<FPointCloudPoint> Points;
+		TestTrue(TEXT("ASCII: Read"), FPlyWriter::ReadPointCloud(AsciiPath, Points));
+		TestEqual(TEXT("ASCII: Count"), Points.Num(), 4);
+		if (Points.Num() == 4)
+		{
+			TestTrue(TEXT("ASCII: Exponents"), Points[0].Position == FVector(150.0, -0.25, 3.0));
+			TestTrue(TEXT("ASCII: Color"), Points[0].Color == FColor(255, 0, 10, 255));
+			TestTrue(TEXT("ASCII: Extra whitespace"), Points[1].Position == FVector(0.125, 1e-3, 0.0));
+			TestTrue(TEXT("ASCII: Signed exponent"), Points[2].Position == FVector(-7.25, 60.0, 0.5));
+			TestTrue(TEXT("ASCII: Unterminated last row"), Points[3].Position == FVector(1.0, 2.0, 3.0) && Points[3].Color == FColor(7, 8, 9, 255));
+		}
+
+		// Fewer rows than the header declares
+		FFileHelper::SaveStringToFile(MakeHeader(5) + Body, *AsciiPath);
+		TestFalse(TEXT("ASCII: Truncated body rejected"), FPlyWriter::ReadPointCloud(AsciiPath, Points));
+		TestEqual(TEXT("ASCII: Truncated body leaves no points"), Points.Num(), 0);
+
+		// Enough rows to span more than one of the row finder's 4 MB chunks
+		const int32 NumRows = 300000;
+		FString LargeBody;
+		LargeBody.Reserve(NumRows * 24);
+		for (int32 i = 0; i < NumRows; ++i)
+		{
+			LargeBody += FString::Printf(TEXT("%d.5 %d -1.25 %d 0 0\n"), i, -i, i % 256);
+		}
+		FFileHelper::SaveStringToFile(MakeHeader(NumRows) + LargeBody, *AsciiPath);
+		TestTrue(TEXT("ASCII: Spans several chunks"), IFileManager::Get().FileSize(*AsciiPath) > (4 << 20));
+
+		TestTrue(TEXT("ASCII: Large read"), FPlyWriter::ReadPointCloud(AsciiPath, Points));
+		TestEqual(TEXT("ASCII: Large count"), Points.Num(), NumRows);
+		if (Points.Num() == NumRows)
+		{
+			bool bMatches = true;
+			for (int32 i = 0; i < NumRows; ++i)
+			{
+				bMatches &= Points[i].Position == FVector(i + 0.5, -static_cast<double>(i), -1.25);
+				bMatches &= Points[i].Color.R == i % 256;
+			}
+			TestTrue(TEXT("ASCII: Large rows match"), bMatches);
+		}
+
+		IFileManager::Get().Delete(*AsciiPath);
+	}
+
+	// Test ASCII write/read round-trip: every finite float comes back bit-exact
+	{
+		TArray<FPointCloudPoint> Points;
+		Points.SetNum(5000);
+
+		// Random bit patterns cover every exponent, including denormals
+		FRandomStream Random(7);
+		auto RandomFloat = [&Random]()
+		{
+			float Value;
+			do
+			{
+				const uint32 Bits = Random.GetUnsignedInt();
+				FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+			}
+			while (!FMath::IsFinite(Value));
+			return Value;
+		};
+
+		for (FPointCloudPoint& Point : Points)
+		{
+			Point.Position = FVector(RandomFloat(), RandomFloat(), RandomFloat());
+			Point.Normal = FVector(RandomFloat(), RandomFloat(), RandomFloat());
+			Point.Color = FColor(Random.RandRange(0, 255), Random.RandRange(0, 255), Random.RandRange(0, 255), 255);
+		}
+		Points[0].Position = FVector(FLT_MAX, -FLT_MIN, 1.0f / 3.0f);
+
+		const FString AsciiPath = FPaths::AutomationTransientDir() / TEXT("AsciiRoundTrip.ply");
+		TestTrue(TEXT("ASCII round-trip: Write"), FPlyWriter::WritePointCloud(AsciiPath, Points, false));
+
+		TArray<FPointCloudPoint> ReadBack;
+		TestTrue(TEXT("ASCII round-trip: Read"), FPlyWriter::ReadPointCloud(AsciiPath, ReadBack));
+		TestEqual(TEXT("ASCII round-trip: Count"), ReadBack.Num(), Points.Num());
+		if (ReadBack.Num() == Points.Num())
+		{
+			bool bPositions = true;
+			bool bNormals = true;
+			bool bColors = true;
+			for (int32 i = 0; i < Points.Num(); ++i)
+			{
+				bPositions &= FVector3f(ReadBack[i].Position) == FVector3f(Points[i].Position);
+				bNormals &= FVector3f(ReadBack[i].Normal) == FVector3f(Points[i].Normal);
+				bColors &= ReadBack[i].Color == Points[i].Color;
+			}
+			TestTrue(TEXT("ASCII round-trip: Positions exact"), bPositions);
+			TestTrue(TEXT("ASCII round-trip: Normals exact"), bNormals);
+			TestTrue(TEXT("ASCII round-trip: Colors exact"), bColors);
+		}
+
+		IFileManager::Get().Delete(*AsciiPath);
+	}
+
+	// Test out-of-core sort: a tiny budget forces many runs and intermediate merges; order matches the in-memory sort
+	{
+		FGaussianSplatBuffer Splats;
+		Splats.SetNum(5000);
+
+		FRandomStream Random(3);
+		for (int32 i = 0; i < Splats.Num(); ++i)
+		{
+			Splats.Positions[i] = FVector3f(Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(-10.0f, 10.0f), Random.FRandRange(0.0f, 2.0f));
+			Splats.Opacities[i] = static_cast<float>(i) / Splats.Num();
+		}
+
+		const FString UnsortedPath = FPaths::AutomationTransientDir() / TEXT("Unsorted.ply");
+		const FString SortedPath = FPaths::AutomationTransientDir() / TEXT("Sorted.ply");
+		TestTrue(TEXT("External sort: Write input"), FPlyWriter::WriteGaussianSplats(UnsortedPath, Splats));
+
+		FExternalSortConfig Config;
+		Config.MemoryBudgetBytes = FExternalSort::MinMemoryBudgetBytes;
+		FExternalSortStats Stats;
+		TestTrue(TEXT("External sort: Sort"), FExternalSort::SortPlyFile(UnsortedPath, SortedPath, Config, &Stats));
+		TestTrue(TEXT("External sort: Several runs"), Stats.NumRuns > 1);
+		TestTrue(TEXT("External sort: Intermediate merge"), Stats.NumMergePasses > 1);
+
+		TArray<int32> Order;
+		FSpatialSort::ComputeOrder(Splats.Positions, Config.Curve, Order);
+
+		FGaussianSplatBuffer ReadBack;
+		TestTrue(TEXT("External sort: Read"), FPlyWriter::ReadGaussianSplats(SortedPath, ReadBack));
+		TestEqual(TEXT("External sort: Count"), ReadBack.Num(), Splats.Num());
+		if (ReadBack.Num() == Splats.Num())
+		{
+			bool bMatches = true;
+			for (int32 i = 0; i < ReadBack.Num(); ++i)
+			{
+				bMatches &= ReadBack.Positions[i] == Splats.Positions[Order[i]];
+				bMatches &= ReadBack.Opacities[i] == Splats.Opacities[Order[i]];
+			}
+			TestTrue(TEXT("External sort: Matches in-memory order"), bMatches);
+		}
+
+		TArray<FString> LeftoverRuns;
+		IFileManager::Get().FindFiles(LeftoverRuns, *(FPaths::AutomationTransientDir() / TEXT("SplatSortRun*.tmp")), true, false);
+		TestEqual(TEXT("External sort: Runs deleted"), LeftoverRuns.Num(), 0);
+
+		IFileManager::Get().Delete(*UnsortedPath);
+		IFileManager::Get().Delete(*SortedPath);
+	}
+
+	return true;
+}
+
+/**
+ * Integration test: Depth map EXR output
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDepthExrTest, "UE5_3DGS.Integration.DepthExr", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDepthExrTest::RunTest(const FString& Parameters)
+{
+	using namespace UE5_3DGS;
+
+	// Smooth depth ramp, height not a multiple of the ZIP block
+	FDepthExtractionResult Depth;
+	Depth.Width = 64;
+	Depth.Height = 37;
+	Depth.DepthData.SetNum(Depth.Width * Depth.Height);
+	for (int32 y = 0; y < Depth.Height; ++y)
+	{
+		for (int32 x = 0; x < Depth.Width; ++x)
+		{
+			Depth.DepthData[y * Depth.Width + x] = 1.0f + 0.01f * x + 0.05f * y;
+		}
+	}
+
+	const int64 RawBytes = static_cast<int64>(Depth.DepthData.Num()) * sizeof(float);
+	const FString ExrPath = FPaths::AutomationTransientDir() / TEXT("Depth.exr");
+
+	// Test uncompressed layout: one line per block, last line readable at the end of the file
+	{
+		FExrWriteConfig Config;
+		Config.bCompress = false;
+		TestTrue(TEXT("EXR: Write uncompressed"), FExrWriter::WriteSingleChannel(ExrPath, Depth.DepthData.GetData(), Depth.Width, Depth.Height, Config));
+
+		TArray<uint8> Bytes;
+		TestTrue(TEXT("EXR: Read back"), FFileHelper::LoadFileToArray(Bytes, *ExrPath));
+		TestTrue(TEXT("EXR: Holds every line"), Bytes.Num() > RawBytes + Depth.Height * (8 + 8));
+		if (Bytes.Num() > RawBytes)
+		{
+			const uint8 Magic[4] = { 0x76, 0x2f, 0x31, 0x01 };
+			TestEqual(TEXT("EXR: Magic"), FMemory::Memcmp(Bytes.GetData(), Magic, sizeof(Magic)), 0);
+
+			const int64 LineBytes = Depth.Width * sizeof(float);
+			TestEqual(TEXT("EXR: Last line"), FMemory::Memcmp(Bytes.GetData() + Bytes.Num() - LineBytes, &Depth.DepthData[(Depth.Height - 1) * Depth.Width], LineBytes), 0);
+		}
+	}
+
+	// Test ZIP blocks shrink a smooth ramp, and half floats shrink it further
+	{
+		TestTrue(TEXT("EXR: Write float"), FDepthExtractor::SaveDepthAsEXR(Depth, ExrPath));
+		const int64 FloatBytes = IFileManager::Get().FileSize(*ExrPath);
+		TestTrue(TEXT("EXR: Float compressed"), FloatBytes > 0 && FloatBytes < RawBytes);
+
+		TestTrue(TEXT("EXR: Write half"), FDepthExtractor::SaveDepthAsEXR(Depth, ExrPath, true));
+		const int64 HalfBytes = IFileManager::Get().FileSize(*ExrPath);
+		TestTrue(TEXT("EXR: Half smaller"), HalfBytes > 0 && HalfBytes < FloatBytes);
+	}
+
+	// Test ZIP layout: offset table, block header, and the first block decoded back to the source rows
+	{
+		TestTrue(TEXT("EXR: Write ZIP"), FExrWriter::WriteSingleChannel(ExrPath, Depth.DepthData.GetData(), Depth.Width, Depth.Height));
+
+		TArray<uint8> Bytes;
+		TestTrue(TEXT("EXR: Read ZIP"), FFileHelper::LoadFileToArray(Bytes, *ExrPath));
+
+		// Skip the preamble and the attributes (name, type, size, value) up to the empty name
+		int32 Cursor = 8;
+		while (Cursor < Bytes.Num() && Bytes[Cursor] != 0)
+		{
+			Cursor += FCStringAnsi::Strlen(reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + Cursor)) + 1;
+			Cursor += FCStringAnsi::Strlen(reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + Cursor)) + 1;
+			int32 AttributeSize = 0;
+			FMemory::Memcpy(&AttributeSize, Bytes.GetData() + Cursor, sizeof(int32));
+			Cursor += sizeof(int32) + AttributeSize;
+		}
+		++Cursor;
+
+		const int32 NumBlocks = FMath::DivideAndRoundUp(Depth.Height, FExrWriter::ZipLinesPerBlock);
+		TArray<uint64> Offsets;
+		Offsets.SetNumZeroed(NumBlocks);
+		const int64 TableEnd = Cursor + static_cast<int64>(NumBlocks) * sizeof(uint64);
+		TestTrue(TEXT("EXR: Offset table inside file"), TableEnd <= Bytes.Num());
+		if (TableEnd <= Bytes.Num())
+		{
+			FMemory::Memcpy(Offsets.GetData(), Bytes.GetData() + Cursor, NumBlocks * sizeof(uint64));
+		}
+
+		TestTrue(TEXT("EXR: First block follows the table"), Offsets[0] == static_cast<uint64>(TableEnd));
+		for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+		{
+			TestTrue(TEXT("EXR: Offset inside file"), Offsets[BlockIndex] + 2 * sizeof(int32) <= static_cast<uint64>(Bytes.Num()));
+			TestTrue(TEXT("EXR: Offsets increase"), BlockIndex == 0 || Offsets[BlockIndex] > Offsets[BlockIndex - 1]);
+		}
+
+		if (Offsets[0] + 2 * sizeof(int32) <= static_cast<uint64>(Bytes.Num()))
+		{
+			int32 FirstLine = -1;
+			int32 StoredBytes = 0;
+			FMemory::Memcpy(&FirstLine, Bytes.GetData() + Offsets[0], sizeof(int32));
+			FMemory::Memcpy(&StoredBytes, Bytes.GetData() + Offsets[0] + sizeof(int32), sizeof(int32));
+
+			const int32 BlockRawBytes = FExrWriter::ZipLinesPerBlock * Depth.Width * sizeof(float);
+			TestEqual(TEXT("EXR: First block line"), FirstLine, 0);
+			TestTrue(TEXT("EXR: First block compressed"), StoredBytes > 0 && StoredBytes < BlockRawBytes &&
+				Offsets[0] + 2 * sizeof(int32) + StoredBytes <= static_cast<uint64>(Bytes.Num()));
+
+			TArray<uint8> Predicted;
+			Predicted.SetNumZeroed(BlockRawBytes);
+			const bool bInflated = StoredBytes > 0 && StoredBytes < BlockRawBytes &&
+				FCompression::UncompressMemory(NAME_Zlib, Predicted.GetData(), BlockRawBytes, Bytes.GetData() + Offsets[0] + 2 * sizeof(int32), StoredBytes);
+			TestTrue(TEXT("EXR: First block inflates"), bInflated);
+
+			if (bInflated)
+			{
+				// Undo the +128 delta, then re-interleave the even and odd halves
+				for (int32 i = 1; i < BlockRawBytes; ++i)
+				{
+					Predicted[i] = static_cast<uint8>(Predicted[i - 1] + Predicted[i] - 128);
+				}
+
+				TArray<uint8> Decoded;
+				Decoded.SetNumUninitialized(BlockRawBytes);
+				const int32 HalfBytes = (BlockRawBytes + 1) / 2;
+				for (int32 i = 0; i < BlockRawBytes; ++i)
+				{
+					Decoded[i] = Predicted[(i & 1) ? HalfBytes + (i >> 1) : (i >> 1)];
+				}
+
+				TestEqual(TEXT("EXR: First block matches the first 16 rows"), FMemory::Memcmp(Decoded.GetData(), Depth.DepthData.GetData(), BlockRawBytes), 0);
+			}
+		}
+	}
+
+	// Test invalid images are rejected
+	{
+		FDepthExtractionResult Empty;
+		TestFalse(TEXT("EXR: Empty rejected"), FDepthExtractor::SaveDepthAsEXR(Empty, ExrPath));
+	}
+
+	IFileManager::Get().Delete(*ExrPath);
+
 	return true;
 }
 